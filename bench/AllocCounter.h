@@ -0,0 +1,33 @@
+//
+// 全局 operator new 计数，用于统计热点路径每帧的堆分配次数
+//
+
+#ifndef GREENHOUSE_ALLOCCOUNTER_H
+#define GREENHOUSE_ALLOCCOUNTER_H
+
+#include <cstdint>
+
+namespace bench {
+
+/**
+ * @brief 进程启动以来 operator new 的调用次数（所有线程）
+ */
+std::uint64_t allocationCount();
+
+/**
+ * @brief 统计一段代码期间的分配次数
+ *
+ * 计数是全局的，后台线程（如数据库写线程）的分配也会计入。
+ */
+class AllocScope {
+public:
+    AllocScope() : m_start(allocationCount()) {}
+    std::uint64_t count() const { return allocationCount() - m_start; }
+
+private:
+    std::uint64_t m_start;
+};
+
+} // namespace bench
+
+#endif // GREENHOUSE_ALLOCCOUNTER_H
@@ -0,0 +1,217 @@
+//
+// greenhouse_bench 的最小基准测试框架：自动标定迭代次数，结果输出为 JSON
+//
+
+#ifndef GREENHOUSE_BENCHHARNESS_H
+#define GREENHOUSE_BENCHHARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+/// 防止编译器把基准循环中的结果优化掉
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief 单个基准的运行状态
+ *
+ * 用法：
+ *     runner.run("name", [](bench::State& s) {
+ *         while (s.keepRunning()) { ... }
+ *     });
+ */
+class State {
+public:
+    explicit State(std::uint64_t iterations) : m_target(iterations) {}
+
+    bool keepRunning() {
+        if (m_done == 0) {
+            m_start = Clock::now();
+        }
+        if (m_done < m_target) {
+            ++m_done;
+            return true;
+        }
+        m_elapsed += Clock::now() - m_start;
+        return false;
+    }
+
+    /// 每次迭代处理的条目数（用于计算 items/s，例如一次查询返回的行数）
+    void setItemsProcessed(std::uint64_t items) { m_items = items; }
+    /// 附加的计数器，会原样输出到 JSON
+    void setCounter(const std::string& key, double value) { m_counters.emplace_back(key, value); }
+
+    /// 暂停计时（用于排除每次迭代的准备工作）
+    void pauseTiming() { m_elapsed += Clock::now() - m_start; }
+    void resumeTiming() { m_start = Clock::now(); }
+
+    std::uint64_t iterations() const { return m_target; }
+    double elapsedNs() const {
+        return std::chrono::duration<double, std::nano>(m_elapsed).count();
+    }
+    std::uint64_t items() const { return m_items; }
+    const std::vector<std::pair<std::string, double>>& counters() const { return m_counters; }
+
+private:
+    std::uint64_t m_target;
+    std::uint64_t m_done = 0;
+    std::uint64_t m_items = 0;
+    Clock::time_point m_start;
+    Clock::duration m_elapsed{0};
+    std::vector<std::pair<std::string, double>> m_counters;
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations = 0;
+    double totalNs = 0;
+    double nsPerOp = 0;
+    double opsPerSec = 0;
+    double itemsPerSec = 0;
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+class Runner {
+public:
+    using Body = std::function<void(State&)>;
+
+    /// @param minTimeMs 每个基准至少运行的时间，迭代次数按此自动放大
+    explicit Runner(double minTimeMs = 200.0, std::string filter = std::string())
+        : m_minTimeNs(minTimeMs * 1e6), m_filter(std::move(filter)) {}
+
+    /**
+     * @brief 运行基准，迭代次数从 1 开始倍增直到运行时间超过 minTime
+     */
+    void run(const std::string& name, const Body& body) {
+        if (!matches(name)) return;
+
+        std::uint64_t iterations = 1;
+        while (true) {
+            State state(iterations);
+            body(state);
+            if (state.elapsedNs() >= m_minTimeNs || iterations >= (1ull << 40)) {
+                record(name, state);
+                return;
+            }
+            // 按当前速度估算需要的迭代次数，最多放大 10 倍
+            double perIter = state.elapsedNs() / static_cast<double>(iterations);
+            std::uint64_t next = perIter > 0
+                ? static_cast<std::uint64_t>(m_minTimeNs * 1.2 / perIter)
+                : iterations * 10;
+            if (next > iterations * 10) next = iterations * 10;
+            if (next <= iterations) next = iterations * 2;
+            iterations = next;
+        }
+    }
+
+    /**
+     * @brief 以固定迭代次数运行（用于开销大、不适合自动标定的基准）
+     */
+    void runFixed(const std::string& name, std::uint64_t iterations, const Body& body) {
+        if (!matches(name)) return;
+        State state(iterations);
+        body(state);
+        record(name, state);
+    }
+
+    bool matches(const std::string& name) const {
+        return m_filter.empty() || name.find(m_filter) != std::string::npos;
+    }
+
+    const std::vector<Result>& results() const { return m_results; }
+
+    /**
+     * @brief 输出 JSON（结构与 Google Benchmark 的 --benchmark_format=json 类似，便于复用对比脚本）
+     */
+    void writeJson(std::FILE* out, const std::vector<std::pair<std::string, std::string>>& context) const {
+        std::fprintf(out, "{\n  \"context\": {");
+        for (std::size_t i = 0; i < context.size(); ++i) {
+            std::fprintf(out, "%s\n    \"%s\": \"%s\"", i ? "," : "",
+                         jsonEscape(context[i].first).c_str(), jsonEscape(context[i].second).c_str());
+        }
+        std::fprintf(out, "\n  },\n  \"benchmarks\": [");
+        for (std::size_t i = 0; i < m_results.size(); ++i) {
+            const Result& r = m_results[i];
+            std::fprintf(out, "%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"real_time_ns\": %.1f, "
+                              "\"ns_per_op\": %.3f, \"ops_per_sec\": %.3f",
+                         i ? "," : "", jsonEscape(r.name).c_str(),
+                         static_cast<unsigned long long>(r.iterations),
+                         r.totalNs, r.nsPerOp, r.opsPerSec);
+            if (r.itemsPerSec > 0) {
+                std::fprintf(out, ", \"items_per_sec\": %.3f", r.itemsPerSec);
+            }
+            for (const auto& c : r.counters) {
+                std::fprintf(out, ", \"%s\": %.3f", jsonEscape(c.first).c_str(), c.second);
+            }
+            std::fprintf(out, "}");
+        }
+        std::fprintf(out, "\n  ]\n}\n");
+    }
+
+private:
+    // JSON 字符串转义：引号、反斜杠和控制字符（其余字节原样输出，UTF-8 不受影响）
+    static std::string jsonEscape(const std::string& text) {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (const char ch : text) {
+            switch (ch) {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(ch));
+                    escaped += buf;
+                } else {
+                    escaped += ch;
+                }
+            }
+        }
+        return escaped;
+    }
+
+    void record(const std::string& name, const State& state) {
+        Result r;
+        r.name = name;
+        r.iterations = state.iterations();
+        r.totalNs = state.elapsedNs();
+        r.nsPerOp = r.iterations ? r.totalNs / static_cast<double>(r.iterations) : 0.0;
+        r.opsPerSec = r.totalNs > 0 ? static_cast<double>(r.iterations) * 1e9 / r.totalNs : 0.0;
+        if (state.items() > 0 && r.totalNs > 0) {
+            r.itemsPerSec = static_cast<double>(state.items() * r.iterations) * 1e9 / r.totalNs;
+        }
+        r.counters = state.counters();
+        m_results.push_back(r);
+
+        // 进度输出到 stderr，stdout 只保留 JSON
+        std::fprintf(stderr, "%-60s %12llu it %14.1f ns/op\n", name.c_str(),
+                     static_cast<unsigned long long>(r.iterations), r.nsPerOp);
+    }
+
+    double m_minTimeNs;
+    std::string m_filter;
+    std::vector<Result> m_results;
+};
+
+} // namespace bench
+
+#endif // GREENHOUSE_BENCHHARNESS_H
@@ -0,0 +1,37 @@
+//
+// greenhouse_bench 各组基准的入口声明
+//
+
+#ifndef GREENHOUSE_BENCHMARKS_H
+#define GREENHOUSE_BENCHMARKS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BenchHarness.h"
+
+struct BenchOptions {
+    std::vector<std::int64_t> rowCounts{10000, 1000000, 10000000};  // 数据库基准的表规模
+    int insertSamples = 200;        // Database::insert 基准的插入次数
+    int queryWindowSecs = 3600;     // queryByTime 的查询窗口（默认最近 1 小时）
+};
+
+/**
+ * @brief 用原生 sqlite3 在单个事务中向 green_data 批量造数，第 i 行时间为 baseSecs + i
+ *
+ * record_time 与应用一样由 TimerUtil::formatRecordTime 格式化为本地时间。
+ * @return 成功写入的行数
+ */
+std::int64_t appendSensorRows(std::int64_t fromRow, std::int64_t toRow, std::int64_t baseSecs);
+
+// 解析链路：parseFromPayload、帧状态机、calcCRC、帧到图表（每帧分配次数）
+void runIngestBenchmarks(bench::Runner& runner, const BenchOptions& options);
+// 存储：Database::insert / queryByTime / 流式导出（不同表规模）
+void runStorageBenchmarks(bench::Runner& runner, const BenchOptions& options);
+// 语句开销：sqlite_orm 路径 vs Database 预编译语句（statements/s）
+void runStatementBenchmarks(bench::Runner& runner, const BenchOptions& options);
+// 图表：ChartViewModel 统计函数、曲线填充
+void runChartBenchmarks(bench::Runner& runner, const BenchOptions& options);
+
+#endif // GREENHOUSE_BENCHMARKS_H
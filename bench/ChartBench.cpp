@@ -0,0 +1,130 @@
+//
+// 图表基准：ChartViewModel 统计函数、曲线填充（与 RealTimeDate::updateChartDisplay 相同的做法）
+//
+
+#include "Benchmarks.h"
+
+#include <QDateTime>
+#include <QLineSeries>
+#include <string>
+
+#include "viewmodel/ChartViewModel.h"
+
+QT_CHARTS_USE_NAMESPACE
+
+namespace {
+
+void fillChartViewModel(ChartViewModel& model, int count) {
+    model.clearAllData();
+    const std::int64_t base = QDateTime::currentSecsSinceEpoch() - count;
+    for (int i = 0; i < count; ++i) {
+        SensorSample sample;
+        sample.tsMs = (base + i) * 1000;
+        sample.airTemp = 20 + i % 15;
+        sample.airHumid = 40 + i % 50;
+        sample.soilHumid = 30 + i % 40;
+        sample.lightIntensity = i % 100;
+        sample.flags = SAMPLE_VALID;
+        model.addData(sample);
+    }
+}
+
+} // namespace
+
+void runChartBenchmarks(bench::Runner& runner, const BenchOptions&) {
+    if (!runner.matches("chart/")) return;
+
+    // 100 为默认的图表最大点数（SettingViewModel::DEFAULT_CHART_MAX_POINTS）
+    const int sizes[] = {100, 1000, 10000};
+
+    for (int size : sizes) {
+        const std::string suffix = "/points:" + std::to_string(size);
+
+        ChartViewModel model;
+        fillChartViewModel(model, size);
+
+        // ---------- ChartViewModel::addData（含容量裁剪） ----------
+        runner.run("chart/addData" + suffix, [&](bench::State& state) {
+            ChartViewModel sink;
+            sink.setMaxDataCount(size);
+            const SensorSample sample = model.getAllData().last();
+            while (state.keepRunning()) {
+                sink.addData(sample);
+            }
+        });
+
+        // ---------- 统计函数 ----------
+        runner.run("chart/getAverageTemperature" + suffix, [&](bench::State& state) {
+            while (state.keepRunning()) {
+                double v = model.getAverageTemperature();
+                bench::doNotOptimize(v);
+            }
+            state.setItemsProcessed(size);
+        });
+
+        runner.run("chart/getAllAverages" + suffix, [&](bench::State& state) {
+            while (state.keepRunning()) {
+                double a = model.getAverageTemperature();
+                double b = model.getAverageAirHumidity();
+                double c = model.getAverageSoilHumidity();
+                double d = model.getAverageLightIntensity();
+                bench::doNotOptimize(a + b + c + d);
+            }
+            state.setItemsProcessed(size);
+        });
+
+        runner.run("chart/getAllRanges" + suffix, [&](bench::State& state) {
+            int lo = 0;
+            int hi = 0;
+            while (state.keepRunning()) {
+                model.getTemperatureRange(lo, hi);
+                model.getAirHumidityRange(lo, hi);
+                model.getSoilHumidityRange(lo, hi);
+                model.getLightIntensityRange(lo, hi);
+                bench::doNotOptimize(lo + hi);
+            }
+            state.setItemsProcessed(size);
+        });
+
+        runner.run("chart/getLatestData/100" + suffix, [&](bench::State& state) {
+            while (state.keepRunning()) {
+                QVector<SensorSample> latest = model.getLatestData(100);
+                bench::doNotOptimize(latest);
+            }
+        });
+
+        // ---------- 曲线填充（每来一个采样点重建全部 4 条曲线） ----------
+        runner.run("chart/updateChartDisplay" + suffix, [&](bench::State& state) {
+            QLineSeries temperature;
+            QLineSeries airHumidity;
+            QLineSeries soilHumidity;
+            QLineSeries lightIntensity;
+
+            while (state.keepRunning()) {
+                const auto& allData = model.getAllData();
+
+                temperature.clear();
+                airHumidity.clear();
+                soilHumidity.clear();
+                lightIntensity.clear();
+
+                double maxValue = 0;
+                for (const auto& sample : allData) {
+                    const qint64 timestamp = sample.tsMs;
+
+                    temperature.append(timestamp, sample.airTemp);
+                    airHumidity.append(timestamp, sample.airHumid);
+                    soilHumidity.append(timestamp, sample.soilHumid);
+                    lightIntensity.append(timestamp, sample.lightIntensity);
+
+                    maxValue = qMax(maxValue, (double)sample.airTemp);
+                    maxValue = qMax(maxValue, (double)sample.airHumid);
+                    maxValue = qMax(maxValue, (double)sample.soilHumid);
+                    maxValue = qMax(maxValue, (double)sample.lightIntensity);
+                }
+                bench::doNotOptimize(maxValue);
+            }
+            state.setItemsProcessed(size);
+        });
+    }
+}
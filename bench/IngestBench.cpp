@@ -0,0 +1,161 @@
+//
+// 解析链路基准：parseFromPayload、帧状态机、calcCRC、帧到图表的完整路径（含分配次数）
+//
+
+#include "Benchmarks.h"
+
+#include <QByteArray>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "common/ProtocolMessages.h"
+#include "common/ProtocolParser.h"
+#include "model/SensorBus.h"
+#include "viewmodel/ChartViewModel.h"
+#include "viewmodel/SensorViewModel.h"
+
+namespace {
+
+// 构造一段混合命令的字节流（与下位机实际发送的帧比例相近）
+std::vector<uint8_t> buildFrameStream(int frames) {
+    std::vector<uint8_t> stream;
+    stream.reserve(static_cast<std::size_t>(frames) * 12);
+
+    uint8_t frame[ProtocolParser::MAX_FRAME_SIZE];
+    const uint8_t sensor[6] = {55, 0, 25, 40, 0, 60};
+    const uint8_t motor[5] = {1, 80, 0, 1, 0};
+    const uint8_t heartBeat[1] = {1};
+
+    for (int i = 0; i < frames; ++i) {
+        std::size_t n;
+        switch (i % 10) {
+        case 8:  n = ProtocolParser::encodeFrame(CMD_MOTOR_STATE, motor, 5, frame); break;
+        case 9:  n = ProtocolParser::encodeFrame(CMD_HEART_BEAT, heartBeat, 1, frame); break;
+        default: n = ProtocolParser::encodeFrame(CMD_SENSOR, sensor, 6, frame); break;
+        }
+        stream.insert(stream.end(), frame, frame + n);
+    }
+    return stream;
+}
+
+} // namespace
+
+void runIngestBenchmarks(bench::Runner& runner, const BenchOptions&) {
+    // ---------- SensorViewModel::parseFromPayload ----------
+    runner.run("ingest/parseFromPayload", [](bench::State& state) {
+        const char raw[6] = {55, 0, 25, 40, 0, 60};
+        const QByteArray payload(raw, 6);
+        while (state.keepRunning()) {
+            SensorSample sample = SensorViewModel::parseFromPayload(payload);
+            bench::doNotOptimize(sample);
+        }
+    });
+
+    // ---------- calcCRC ----------
+    runner.run("ingest/calcCRC/6B", [](bench::State& state) {
+        const uint8_t payload[6] = {55, 0, 25, 40, 0, 60};
+        while (state.keepRunning()) {
+            uint8_t crc = ProtocolParser::calcCRC(payload, 6);
+            bench::doNotOptimize(crc);
+        }
+        state.setItemsProcessed(6);
+    });
+
+    runner.run("ingest/calcCRC/255B", [](bench::State& state) {
+        uint8_t payload[255];
+        for (int i = 0; i < 255; ++i) payload[i] = static_cast<uint8_t>(i * 31);
+        while (state.keepRunning()) {
+            uint8_t crc = ProtocolParser::calcCRC(payload, 255);
+            bench::doNotOptimize(crc);
+        }
+        state.setItemsProcessed(255);
+    });
+
+    // ---------- 帧状态机 ----------
+    const int frames = 10000;
+    const std::vector<uint8_t> stream = buildFrameStream(frames);
+
+    // 整段输入（对应一次 readAll 读到大量数据）
+    runner.run("ingest/frameStateMachine/bulk", [&](bench::State& state) {
+        ProtocolParser parser;
+        std::uint64_t decoded = 0;
+        parser.setFrameHandler([&](uint8_t, const uint8_t*, uint8_t) { ++decoded; });
+        while (state.keepRunning()) {
+            parser.feed(stream.data(), stream.size());
+        }
+        bench::doNotOptimize(decoded);
+        state.setItemsProcessed(frames);
+        state.setCounter("bytes_per_iter", static_cast<double>(stream.size()));
+    });
+
+    // 每次只输入 8 字节（对应低波特率串口的零碎 readyRead）
+    runner.run("ingest/frameStateMachine/chunk8", [&](bench::State& state) {
+        ProtocolParser parser;
+        std::uint64_t decoded = 0;
+        parser.setFrameHandler([&](uint8_t, const uint8_t*, uint8_t) { ++decoded; });
+        while (state.keepRunning()) {
+            for (std::size_t off = 0; off < stream.size(); off += 8) {
+                std::size_t n = stream.size() - off < 8 ? stream.size() - off : 8;
+                parser.feed(stream.data() + off, n);
+            }
+        }
+        bench::doNotOptimize(decoded);
+        state.setItemsProcessed(frames);
+    });
+
+    // 帧解析 + parseFromPayload，近似一帧从字节到 SensorSample 的完整成本
+    runner.run("ingest/frameToRecord", [&](bench::State& state) {
+        ProtocolParser parser;
+        std::uint64_t records = 0;
+        parser.setFrameHandler([&](uint8_t cmd, const uint8_t* payload, uint8_t len) {
+            if (cmd == CMD_SENSOR && len == 6) {
+                SensorSample sample = SensorViewModel::parseFromPayload(
+                    QByteArray::fromRawData(reinterpret_cast<const char*>(payload), len));
+                bench::doNotOptimize(sample);
+                ++records;
+            }
+        });
+        while (state.keepRunning()) {
+            parser.feed(stream.data(), stream.size());
+        }
+        bench::doNotOptimize(records);
+        state.setItemsProcessed(frames);
+    });
+
+    // 帧解析 → 负载解码 → 样本总线 → ChartViewModel，与 RealTimeDate 的实时路径一致
+    // （不含曲线重绘）；allocs_per_frame 为稳态下每帧的堆分配次数
+    runner.run("ingest/frameToChart", [&](bench::State& state) {
+        SensorBus& bus = SensorBus::instance();
+        const int consumer = bus.subscribe("bench_chart", SensorBus::DropOldest);
+        ChartViewModel chart;
+        chart.setMaxDataCount(100);
+
+        ProtocolParser parser;
+        std::uint64_t samples = 0;
+        parser.setFrameHandler([&](uint8_t cmd, const uint8_t* payload, uint8_t len) {
+            if (cmd != CMD_SENSOR) return;
+            SensorSample sample;
+            if (!Protocol::SensorMessage::decode(payload, len, sample)) return;
+            sample.tsMs = static_cast<std::int64_t>(samples) * 1000;
+            if (SensorViewModel::validateSensorData(sample)) sample.flags |= SAMPLE_VALID;
+            bus.publish(sample);
+            bus.drain(consumer, [&chart](const SensorSample& s) {
+                if (s.flags & SAMPLE_VALID) chart.addData(s);
+            });
+            ++samples;
+        });
+
+        // 预热：让图表缓冲区达到容量上限
+        parser.feed(stream.data(), stream.size());
+
+        const bench::AllocScope allocs;
+        while (state.keepRunning()) {
+            parser.feed(stream.data(), stream.size());
+        }
+        const double totalFrames = static_cast<double>(state.iterations()) * frames;
+        bench::doNotOptimize(samples);
+        state.setItemsProcessed(frames);
+        state.setCounter("allocs_per_frame", static_cast<double>(allocs.count()) / totalFrames);
+        bus.unsubscribe(consumer);
+    });
+}
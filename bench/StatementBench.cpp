@@ -0,0 +1,164 @@
+//
+// 语句开销基准：同一组热点操作分别走 sqlite_orm（原实现）和 Database 的预编译语句
+//
+// 关注的是每条语句的固定开销（拼 SQL、编译、开关连接），
+// 所以查询窗口取得很小，结果以 ops_per_sec（statements/s）对比。
+//
+
+#include "Benchmarks.h"
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "model/Database/ConnectionManager.h"
+#include "model/Database/Database.h"
+#include "untils/TimerUtil.h"
+#include "sqlite_orm.h"
+
+namespace {
+
+// 与 Database.cpp 中的表定义一致（原先 Database 的实现方式：每次操作由 sqlite_orm 打开连接并重新编译）
+auto makeOrmStorage() {
+    return sqlite_orm::make_storage("green-house.db",
+        sqlite_orm::make_table("green_data",
+            sqlite_orm::make_column("id", &SensorRecord::id, sqlite_orm::primary_key().autoincrement()),
+            sqlite_orm::make_column("record_time", &SensorRecord::record_time),
+            sqlite_orm::make_column("air_temp", &SensorRecord::air_temp),
+            sqlite_orm::make_column("air_humid", &SensorRecord::air_humid),
+            sqlite_orm::make_column("soil_humid", &SensorRecord::soil_humid),
+            sqlite_orm::make_column("light_intensity", &SensorRecord::light_intensity)
+        )
+    );
+}
+
+const int kInsertSamples = 2000;     // 插入基准的固定次数（每次插入都是一次提交）
+const int kRangeWindowSecs = 60;     // 范围查询窗口：约 60 行
+const int kLatestCount = 100;        // 最新 N 条
+
+} // namespace
+
+void runStatementBenchmarks(bench::Runner& runner, const BenchOptions&) {
+    if (!runner.matches("statements/")) return;
+
+    Database& db = Database::instance();
+    auto storage = makeOrmStorage();
+
+    // 表为空（单独运行该组基准）时先造一批数据
+    std::vector<SensorRecord> latest;
+    db.queryLatest(1, latest);
+    if (latest.empty()) {
+        const std::int64_t base = static_cast<std::int64_t>(std::time(nullptr)) - 10000 - 86400;
+        std::fprintf(stderr, "populating green_data with 10000 rows...\n");
+        appendSensorRows(0, 10000, base);
+        db.queryLatest(1, latest);
+    }
+    if (latest.empty()) {
+        std::fprintf(stderr, "statements/: green_data is empty, skipped\n");
+        return;
+    }
+
+    // 查询窗口取表中最新的一段
+    const std::string endTime = latest.front().record_time;
+    std::int64_t end = 0;
+    if (!TimerUtil::parseRecordTime(endTime.data(), endTime.size(), end)) {
+        std::fprintf(stderr, "statements/: unexpected record_time '%s', skipped\n", endTime.c_str());
+        return;
+    }
+    char startBuf[32];
+    TimerUtil::formatRecordTime((end - kRangeWindowSecs + 1) * 1000, startBuf);
+    const std::string startTime(startBuf);
+
+    // 删除基准使用一段不存在数据的未来时间，只衡量语句本身（索引查找 + 空删除）
+    char delStartBuf[32];
+    char delEndBuf[32];
+    TimerUtil::formatRecordTime((end + 10 * 365 * 86400LL) * 1000, delStartBuf);
+    TimerUtil::formatRecordTime((end + 10 * 365 * 86400LL + 3600) * 1000, delEndBuf);
+    const std::string delStart(delStartBuf);
+    const std::string delEnd(delEndBuf);
+
+    // 插入的行放在更远的未来，避免干扰上面的查询窗口
+    std::int64_t insertCursor = end + 20 * 365 * 86400LL;
+    SensorRecord record;
+    record.air_temp = 25;
+    record.air_humid = 60;
+    record.soil_humid = 45;
+    record.light_intensity = 50;
+
+    // ---------- 插入 ----------
+    runner.runFixed("statements/orm/insert", kInsertSamples, [&](bench::State& state) {
+        char timeBuf[32];
+        while (state.keepRunning()) {
+            state.pauseTiming();
+            TimerUtil::formatRecordTime((insertCursor++) * 1000, timeBuf);
+            record.record_time = timeBuf;
+            state.resumeTiming();
+            storage.insert(record);
+        }
+    });
+    runner.runFixed("statements/prepared/insert", kInsertSamples, [&](bench::State& state) {
+        char timeBuf[32];
+        while (state.keepRunning()) {
+            state.pauseTiming();
+            TimerUtil::formatRecordTime((insertCursor++) * 1000, timeBuf);
+            record.record_time = timeBuf;
+            state.resumeTiming();
+            bool ok = db.insert(record);
+            bench::doNotOptimize(ok);
+        }
+        // insert 只是入队，等写线程全部提交后才算完成
+        state.resumeTiming();
+        ConnectionManager::instance().flush();
+        state.pauseTiming();
+    });
+
+    // ---------- 范围查询 ----------
+    runner.run("statements/orm/selectRange", [&](bench::State& state) {
+        std::vector<SensorRecord> rows;
+        while (state.keepRunning()) {
+            rows = storage.get_all<SensorRecord>(
+                sqlite_orm::where(sqlite_orm::between(&SensorRecord::record_time, startTime, endTime)));
+        }
+        state.setCounter("rows_returned", static_cast<double>(rows.size()));
+    });
+    runner.run("statements/prepared/selectRange", [&](bench::State& state) {
+        std::vector<SensorRecord> rows;
+        while (state.keepRunning()) {
+            db.queryByTime(startTime, endTime, rows);
+        }
+        state.setCounter("rows_returned", static_cast<double>(rows.size()));
+    });
+
+    // ---------- 最新 N 条 ----------
+    runner.run("statements/orm/latest:" + std::to_string(kLatestCount), [&](bench::State& state) {
+        std::vector<SensorRecord> rows;
+        while (state.keepRunning()) {
+            rows = storage.get_all<SensorRecord>(
+                sqlite_orm::order_by(&SensorRecord::record_time).desc(),
+                sqlite_orm::limit(kLatestCount));
+        }
+        bench::doNotOptimize(rows);
+    });
+    runner.run("statements/prepared/latest:" + std::to_string(kLatestCount), [&](bench::State& state) {
+        std::vector<SensorRecord> rows;
+        while (state.keepRunning()) {
+            db.queryLatest(kLatestCount, rows);
+        }
+        bench::doNotOptimize(rows);
+    });
+
+    // ---------- 范围删除 ----------
+    runner.run("statements/orm/deleteRange", [&](bench::State& state) {
+        while (state.keepRunning()) {
+            storage.remove_all<SensorRecord>(
+                sqlite_orm::where(sqlite_orm::between(&SensorRecord::record_time, delStart, delEnd)));
+        }
+    });
+    runner.run("statements/prepared/deleteRange", [&](bench::State& state) {
+        while (state.keepRunning()) {
+            bool ok = db.deleteByTime(delStart, delEnd);
+            bench::doNotOptimize(ok);
+        }
+    });
+}
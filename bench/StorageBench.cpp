@@ -0,0 +1,212 @@
+//
+// 存储基准：Database::insert / queryByTime（磁盘 / 热数据缓存）/ 流式导出 / 批量导入在不同表规模下的表现
+//
+
+#include "Benchmarks.h"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AllocCounter.h"
+#include "model/DataExporter.h"
+#include "model/DataImporter.h"
+#include "model/Database/ConnectionManager.h"
+#include "model/Database/Database.h"
+#include "model/Database/HotTierCache.h"
+#include "sqlite3.h"
+#include "untils/TimerUtil.h"
+
+namespace {
+
+const char* kDbFile = "green-house.db";   // 与 Database 使用的文件一致（基准在临时目录中运行）
+
+} // namespace
+
+std::int64_t appendSensorRows(std::int64_t fromRow, std::int64_t toRow, std::int64_t baseSecs) {
+    sqlite3* db = nullptr;
+    if (sqlite3_open(kDbFile, &db) != SQLITE_OK) {
+        std::fprintf(stderr, "open %s failed: %s\n", kDbFile, sqlite3_errmsg(db));
+        sqlite3_close(db);
+        return 0;
+    }
+    sqlite3_exec(db, "PRAGMA synchronous=OFF", nullptr, nullptr, nullptr);
+    sqlite3_exec(db, "BEGIN", nullptr, nullptr, nullptr);
+
+    sqlite3_stmt* stmt = nullptr;
+    sqlite3_prepare_v2(db,
+        "INSERT INTO green_data(record_time, air_temp, air_humid, soil_humid, light_intensity, ts_ms) "
+        "VALUES(?, ?, ?, ?, ?, ?)", -1, &stmt, nullptr);
+
+    char timeBuf[32];
+    std::int64_t written = 0;
+    for (std::int64_t i = fromRow; i < toRow; ++i) {
+        TimerUtil::formatRecordTime((baseSecs + i) * 1000, timeBuf);
+        sqlite3_bind_text(stmt, 1, timeBuf, 19, SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 2, static_cast<int>(20 + i % 15));
+        sqlite3_bind_int(stmt, 3, static_cast<int>(40 + i % 50));
+        sqlite3_bind_int(stmt, 4, static_cast<int>(30 + i % 40));
+        sqlite3_bind_int(stmt, 5, static_cast<int>(i % 100));
+        sqlite3_bind_int64(stmt, 6, (baseSecs + i) * 1000);
+        if (sqlite3_step(stmt) == SQLITE_DONE) ++written;
+        sqlite3_reset(stmt);
+    }
+
+    sqlite3_finalize(stmt);
+    sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr);
+    sqlite3_close(db);
+    return written;
+}
+
+void runStorageBenchmarks(bench::Runner& runner, const BenchOptions& options) {
+    if (!runner.matches("storage/")) return;
+
+    // 触发 Database 构造（执行表结构迁移）
+    Database& db = Database::instance();
+
+    std::int64_t maxRows = 0;
+    for (std::int64_t n : options.rowCounts) maxRows = n > maxRows ? n : maxRows;
+
+    // 所有造数行落在 [baseSecs, baseSecs + maxRows) 内，插入基准的行放在其后
+    const std::int64_t baseSecs = static_cast<std::int64_t>(std::time(nullptr)) - maxRows - 86400;
+    std::int64_t currentRows = 0;
+    std::int64_t insertCursor = baseSecs + maxRows;
+
+    for (std::int64_t rows : options.rowCounts) {
+        if (rows > currentRows) {
+            std::fprintf(stderr, "populating green_data to %lld rows...\n", static_cast<long long>(rows));
+            currentRows += appendSensorRows(currentRows, rows, baseSecs);
+        }
+        const std::string suffix = "/rows:" + std::to_string(rows);
+
+        // ---------- Database::insert（逐条插入，与实时采集一致） ----------
+        runner.runFixed("storage/insert" + suffix, static_cast<std::uint64_t>(options.insertSamples),
+                        [&](bench::State& state) {
+            SensorRecord record;
+            record.air_temp = 25;
+            record.air_humid = 60;
+            record.soil_humid = 45;
+            record.light_intensity = 50;
+            char timeBuf[32];
+            while (state.keepRunning()) {
+                state.pauseTiming();
+                TimerUtil::formatRecordTime((insertCursor++) * 1000, timeBuf);
+                record.record_time = timeBuf;
+                state.resumeTiming();
+                bool ok = db.insert(record);
+                bench::doNotOptimize(ok);
+            }
+            // insert 只是入队，等写线程全部提交后才算完成
+            state.resumeTiming();
+            ConnectionManager::instance().flush();
+            state.pauseTiming();
+        });
+
+        // ---------- Database::queryByTime（最近一段时间窗口） ----------
+        char startBuf[32];
+        char endBuf[32];
+        const std::int64_t windowEnd = baseSecs + currentRows - 1;
+        TimerUtil::formatRecordTime((windowEnd - options.queryWindowSecs + 1) * 1000, startBuf);
+        TimerUtil::formatRecordTime(windowEnd * 1000, endBuf);
+        const std::string startTime(startBuf);
+        const std::string endTime(endBuf);
+
+        std::vector<SensorRecord> results;
+        runner.run("storage/queryByTime/window:" + std::to_string(options.queryWindowSecs) + "s" + suffix,
+                   [&](bench::State& state) {
+            while (state.keepRunning()) {
+                db.queryByTime(startTime, endTime, results);
+            }
+            state.setItemsProcessed(results.size());
+            state.setCounter("rows_returned", static_cast<double>(results.size()));
+        });
+
+        // ---------- 同一窗口由 HotTierCache 提供（窗口覆盖查询起点） ----------
+        {
+            HotTierCache& hot = HotTierCache::instance();
+            const std::int64_t coverSecs = static_cast<std::int64_t>(std::time(nullptr)) - (windowEnd - options.queryWindowSecs);
+            hot.start(static_cast<int>(coverSecs / 3600 + 1));
+            while (!hot.isReady()) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            runner.run("storage/queryByTime/hot/window:" + std::to_string(options.queryWindowSecs) + "s" + suffix,
+                       [&](bench::State& state) {
+                while (state.keepRunning()) {
+                    db.queryByTime(startTime, endTime, results);
+                }
+                state.setItemsProcessed(results.size());
+                state.setCounter("rows_returned", static_cast<double>(results.size()));
+                state.setCounter("cached_rows", static_cast<double>(hot.rows()));
+            });
+            hot.stop();
+        }
+
+        // ---------- DataExporter::exportRange（全表流式导出，每次迭代导出一遍） ----------
+        // allocs_per_row 应接近 0：内存占用只有写缓冲区，与行数无关
+        char firstBuf[32];
+        TimerUtil::formatRecordTime(baseSecs * 1000, firstBuf);
+        const std::string firstTime(firstBuf);
+        const struct { const char* name; ExportFormat format; const char* file; } exports[] = {
+            {"csv", ExportFormat::Csv, "bench-export.csv"},
+            {"json", ExportFormat::Json, "bench-export.json"},
+            {"arrow", ExportFormat::Arrow, "bench-export.arrow"},
+        };
+        for (const auto& e : exports) {
+            runner.runFixed(std::string("storage/export/") + e.name + suffix, 1, [&](bench::State& state) {
+                DataExporter::Result result;
+                const bench::AllocScope allocs;
+                while (state.keepRunning()) {
+                    result = DataExporter::exportRange(e.file, e.format, firstTime, endTime);
+                }
+                const double rowsExported = result.rows > 0 ? static_cast<double>(result.rows) : 1.0;
+                state.setItemsProcessed(static_cast<std::uint64_t>(result.rows));
+                state.setCounter("bytes", static_cast<double>(result.bytes));
+                state.setCounter("allocs_per_row", static_cast<double>(allocs.count()) / rowsExported);
+                if (e.format != ExportFormat::Csv) std::remove(e.file);
+            });
+        }
+
+        // ---------- DataImporter::importCsv ----------
+        // duplicates：导回刚导出的 CSV，全部行命中已有数据（解析 + 去重探测，不写入）
+        runner.runFixed("storage/import/duplicates" + suffix, 1, [&](bench::State& state) {
+            DataImporter::Result result;
+            while (state.keepRunning()) {
+                result = DataImporter::importCsv("bench-export.csv");
+            }
+            state.setItemsProcessed(static_cast<std::uint64_t>(result.rowsParsed));
+            state.setCounter("rows_inserted", static_cast<double>(result.rowsInserted));
+        });
+        std::remove("bench-export.csv");
+
+        // fresh：同样行数、时间落在已有数据之后的新文件，全部写入，结束后删除
+        const std::int64_t importBase = insertCursor + 30 * 86400;   // 与后续插入基准的时间错开
+        char importFirst[32];
+        char importLast[32];
+        TimerUtil::formatRecordTime(importBase * 1000, importFirst);
+        TimerUtil::formatRecordTime((importBase + rows - 1) * 1000, importLast);
+        const char* importFile = "bench-import.csv";
+        if (std::FILE* f = std::fopen(importFile, "wb")) {
+            std::fputs("时间,温度(°C),空气湿度(%),土壤湿度(%),光照强度(Lux)\n", f);
+            char timeBuf[32];
+            for (std::int64_t i = 0; i < rows; ++i) {
+                TimerUtil::formatRecordTime((importBase + i) * 1000, timeBuf);
+                std::fprintf(f, "%s,%d,%d,%d,%d\n", timeBuf, static_cast<int>(20 + i % 15),
+                             static_cast<int>(40 + i % 50), static_cast<int>(30 + i % 40),
+                             static_cast<int>(i % 100));
+            }
+            std::fclose(f);
+        }
+        runner.runFixed("storage/import/fresh" + suffix, 1, [&](bench::State& state) {
+            DataImporter::Result result;
+            while (state.keepRunning()) {
+                result = DataImporter::importCsv(importFile);
+            }
+            state.setItemsProcessed(static_cast<std::uint64_t>(result.rowsInserted));
+            state.setCounter("rows_inserted", static_cast<double>(result.rowsInserted));
+            db.deleteByTime(importFirst, importLast);
+        });
+        std::remove(importFile);
+    }
+}
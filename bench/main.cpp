@@ -0,0 +1,131 @@
+//
+// greenhouse_bench —— 采集、存储、图表热点路径的基准测试
+//
+// 用法：
+//   greenhouse_bench [--out result.json] [--filter storage/] [--rows 10000,1000000]
+//                    [--min-time-ms 200] [--insert-samples 200] [--keep-db]
+//
+// 结果以 JSON 写到 stdout（或 --out 指定的文件），进度输出到 stderr。
+//
+
+#include <QApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Benchmarks.h"
+
+namespace {
+
+// 基准运行期间丢弃 qDebug 输出（格式化开销仍会被计入）
+void silentMessageHandler(QtMsgType type, const QMessageLogContext&, const QString& msg) {
+    if (type == QtCriticalMsg || type == QtFatalMsg) {
+        std::fprintf(stderr, "%s\n", msg.toLocal8Bit().constData());
+    }
+}
+
+std::vector<std::int64_t> parseRowCounts(const char* text) {
+    std::vector<std::int64_t> rows;
+    for (const QString& part : QString::fromLatin1(text).split(',', QString::SkipEmptyParts)) {
+        bool ok = false;
+        qlonglong n = part.trimmed().toLongLong(&ok);
+        if (ok && n > 0) rows.push_back(n);
+    }
+    return rows;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // 曲线基准需要 QtCharts，使用 offscreen 平台避免依赖显示环境
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    BenchOptions options;
+    std::string outPath;
+    std::string filter;
+    double minTimeMs = 200.0;
+    bool keepDb = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* next = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(arg, "--out") == 0 && next) { outPath = next; ++i; }
+        else if (std::strcmp(arg, "--filter") == 0 && next) { filter = next; ++i; }
+        else if (std::strcmp(arg, "--rows") == 0 && next) { options.rowCounts = parseRowCounts(next); ++i; }
+        else if (std::strcmp(arg, "--min-time-ms") == 0 && next) { minTimeMs = std::atof(next); ++i; }
+        else if (std::strcmp(arg, "--insert-samples") == 0 && next) { options.insertSamples = std::atoi(next); ++i; }
+        else if (std::strcmp(arg, "--keep-db") == 0) { keepDb = true; }
+        else {
+            std::fprintf(stderr, "unknown argument: %s\n", arg);
+            return 2;
+        }
+    }
+
+    // Database 固定打开当前目录下的 green-house.db，基准在临时目录中运行以免污染真实数据
+    const QDir launchDir = QDir::current();
+    QTemporaryDir workDir;
+    workDir.setAutoRemove(!keepDb);
+    if (!workDir.isValid() || !QDir::setCurrent(workDir.path())) {
+        std::fprintf(stderr, "failed to create temporary working directory\n");
+        return 1;
+    }
+    std::fprintf(stderr, "working directory: %s\n", qPrintable(workDir.path()));
+
+    qInstallMessageHandler(silentMessageHandler);
+    // 被测代码中的 std::cout 输出改到 stderr，stdout 只保留 JSON
+    std::streambuf* coutBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+
+    bench::Runner runner(minTimeMs, filter);
+    runIngestBenchmarks(runner, options);
+    runChartBenchmarks(runner, options);
+    runStorageBenchmarks(runner, options);
+    runStatementBenchmarks(runner, options);
+
+    qInstallMessageHandler(nullptr);
+    std::cout.rdbuf(coutBuffer);
+
+    std::string rows;
+    for (std::int64_t n : options.rowCounts) {
+        rows += (rows.empty() ? "" : ",") + std::to_string(n);
+    }
+    const std::vector<std::pair<std::string, std::string>> context = {
+        {"executable", "greenhouse_bench"},
+        {"version", GREENHOUSE_VERSION},
+        {"date", QDateTime::currentDateTime().toString(Qt::ISODate).toStdString()},
+        {"host", QSysInfo::machineHostName().toStdString()},
+        {"cpu_arch", QSysInfo::currentCpuArchitecture().toStdString()},
+        {"os", QSysInfo::prettyProductName().toStdString()},
+        {"qt_version", qVersion()},
+#ifdef NDEBUG
+        {"build_type", "release"},
+#else
+        {"build_type", "debug"},
+#endif
+        {"row_counts", rows},
+    };
+
+    std::FILE* out = stdout;
+    if (!outPath.empty()) {
+        // 相对路径以启动时的目录为准
+        const QString path = launchDir.absoluteFilePath(QString::fromLocal8Bit(outPath.c_str()));
+        out = std::fopen(path.toLocal8Bit().constData(), "w");
+        if (!out) {
+            std::fprintf(stderr, "cannot open %s\n", qPrintable(path));
+            return 1;
+        }
+    }
+    runner.writeJson(out, context);
+    if (out != stdout) std::fclose(out);
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#ifndef BLOCKPOOL_H
+#define BLOCKPOOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+
+/**
+ * @brief 定长块对象池
+ *
+ * 每块存放至多 BlockCapacity 个平凡可复制的元素；归还的块挂在空闲链表上复用，
+ * 稳定运行后取块 / 还块都不再分配内存。块可以在一个线程取出、在另一个线程归还
+ * （如 UI 线程装满一批样本，数据库写线程写完后归还）。
+ */
+template <typename T, std::size_t BlockCapacity>
+class BlockPool
+{
+    static_assert(std::is_trivially_copyable<T>::value, "BlockPool requires a trivially copyable element type");
+
+public:
+    static constexpr std::size_t CAPACITY = BlockCapacity;
+
+    struct Block {
+        Block* next = nullptr;
+        std::size_t size = 0;
+        T items[BlockCapacity];
+
+        bool isFull() const { return size == BlockCapacity; }
+        bool push(const T& value) {
+            if (size == BlockCapacity) return false;
+            items[size++] = value;
+            return true;
+        }
+        const T* begin() const { return items; }
+        const T* end() const { return items + size; }
+    };
+
+    BlockPool() = default;
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    ~BlockPool() {
+        while (m_free) {
+            Block* block = m_free;
+            m_free = block->next;
+            delete block;
+        }
+    }
+
+    /**
+     * @brief 取一个空块（空闲链表为空时才分配）
+     */
+    Block* acquire() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_free) {
+                Block* block = m_free;
+                m_free = block->next;
+                --m_freeCount;
+                block->next = nullptr;
+                block->size = 0;
+                return block;
+            }
+            ++m_allocated;
+        }
+        return new Block;
+    }
+
+    /**
+     * @brief 归还块；空闲块超过 maxFree 时直接释放，避免峰值过后长期占用内存
+     */
+    void release(Block* block) {
+        if (!block) return;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_freeCount < m_maxFree) {
+                block->next = m_free;
+                m_free = block;
+                ++m_freeCount;
+                return;
+            }
+            --m_allocated;
+        }
+        delete block;
+    }
+
+    void setMaxFree(std::size_t maxFree) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_maxFree = maxFree;
+    }
+
+    /// 当前存在的块数（使用中 + 空闲）
+    std::size_t allocatedBlocks() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_allocated;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    Block* m_free = nullptr;
+    std::size_t m_freeCount = 0;
+    std::size_t m_maxFree = 8;
+    std::size_t m_allocated = 0;
+};
+
+#endif // BLOCKPOOL_H
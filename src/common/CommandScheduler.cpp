@@ -0,0 +1,227 @@
+#include "CommandScheduler.h"
+#include <QTimer>
+
+#include "Protocol.h"
+#include "untils/Log.h"
+#include "untils/Metrics.h"
+
+namespace {
+
+Histogram& commandRttUs() {
+    static Histogram& h = Metrics::histogram("gh_command_rtt_us", "Control command send to CMD_CRTL_ACK round trip", "us");
+    return h;
+}
+
+Counter& commandsSent() {
+    static Counter& c = Metrics::counter("gh_commands_sent_total", "Control frames written, including retries");
+    return c;
+}
+
+Counter& commandsCoalesced() {
+    static Counter& c = Metrics::counter("gh_commands_coalesced_total", "Queued commands superseded by a newer command of the same type");
+    return c;
+}
+
+Counter& commandRetries() {
+    static Counter& c = Metrics::counter("gh_command_retries_total", "Control frames resent after an ACK timeout");
+    return c;
+}
+
+Counter& commandFailures() {
+    static Counter& c = Metrics::counter("gh_command_failures_total", "Commands abandoned after exhausting retries");
+    return c;
+}
+
+qint64 nowMs() {
+    return Metrics::nowNs() / 1000000;
+}
+
+} // namespace
+
+CommandScheduler::CommandScheduler(FrameWriter writer, QObject* parent)
+    : QObject(parent)
+    , m_writer(std::move(writer))
+    , m_timer(new QTimer(this))
+    , m_ackTimeoutMs(500)
+    , m_maxAttempts(3) {
+    m_timer->setInterval(TICK_MS);
+    connect(m_timer, &QTimer::timeout, this, &CommandScheduler::onTick);
+}
+
+CommandScheduler::~CommandScheduler() = default;
+
+bool CommandScheduler::expectsAck(uint8_t cmd) {
+    switch (cmd) {
+    case CMD_MOTOR_CRTL:
+    case CMD_THRESHOLD:
+    case CMD_DATA_CRTL:
+    case CMD_AUTO_MODE:
+    case CMD_TIME_WEATHER:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ========================================
+// 提交 / 应答
+// ========================================
+
+void CommandScheduler::submit(uint8_t cmd, const QByteArray& payload) {
+    if (!expectsAck(cmd)) {
+        if (m_writer(cmd, payload)) {
+            commandsSent().inc();
+        } else {
+            // 无应答命令不排队重放（如 CMD_Get_Date 在链路恢复后已无意义），直接通知失败
+            LOG_WARN("链路不可用，命令未发出 CMD={}", cmd);
+            emit commandFailed(cmd);
+        }
+        return;
+    }
+
+    Slot& slot = m_slots[cmd];
+    if (slot.inFlight || slot.hasQueued) {
+        // 在途期间只保留最新的一条，旧的排队命令被覆盖
+        if (slot.hasQueued) commandsCoalesced().inc();
+        slot.queuedPayload = payload;
+        slot.hasQueued = true;
+        if (slot.inFlight) return;
+        // 链路不可用时留下的命令：用最新的一条重新尝试
+        sendNextQueued(cmd, slot);
+        updateTimer();
+        return;
+    }
+    transmit(cmd, slot, payload);
+    updateTimer();
+}
+
+void CommandScheduler::onAck(uint8_t originalCmd, uint8_t result) {
+    auto it = m_slots.find(originalCmd);
+    if (it == m_slots.end() || !it->inFlight) {
+        LOG_DEBUG("收到未匹配的应答 CMD={}", originalCmd);
+        return;
+    }
+
+    Slot& slot = *it;
+    const qint64 rttUs = (Metrics::nowNs() - slot.sentNs) / 1000;
+    commandRttUs().record(static_cast<uint64_t>(rttUs));
+    slot.inFlight = false;
+    slot.inFlightPayload.clear();
+    slot.attempts = 0;
+
+    // 先发出排队的同类命令，再通知（接收方可能在槽函数中提交新命令）
+    sendNextQueued(originalCmd, slot);
+    updateTimer();
+
+    emit ackReceived(originalCmd, result == 0x01, rttUs);
+}
+
+void CommandScheduler::reset() {
+    m_slots.clear();
+    m_timer->stop();
+}
+
+QVector<CommandScheduler::PendingCommand> CommandScheduler::takePending() {
+    QVector<PendingCommand> pending;
+    for (auto it = m_slots.begin(); it != m_slots.end(); ++it) {
+        if (!it->hasQueued && !it->inFlight) continue;
+        PendingCommand command;
+        command.cmd = it.key();
+        command.payload = it->hasQueued ? it->queuedPayload : it->inFlightPayload;
+        pending.append(command);
+    }
+    reset();
+    return pending;
+}
+
+int CommandScheduler::pendingCount() const {
+    int count = 0;
+    for (auto it = m_slots.constBegin(); it != m_slots.constEnd(); ++it) {
+        count += (it->inFlight ? 1 : 0) + (it->hasQueued ? 1 : 0);
+    }
+    return count;
+}
+
+// ========================================
+// 内部实现
+// ========================================
+
+void CommandScheduler::transmit(uint8_t cmd, Slot& slot, const QByteArray& payload) {
+    if (!m_writer(cmd, payload)) {
+        // 链路不可用：不进入在途状态，避免断线期间空转重试；
+        // 命令留在排队位置，链路恢复后由 takePending() 取出重放（或被下一次提交重新发送）
+        LOG_DEBUG("链路不可用，命令等待重放 CMD={}", cmd);
+        slot.queuedPayload = payload;
+        slot.hasQueued = true;
+        slot.inFlight = false;
+        slot.inFlightPayload.clear();
+        slot.attempts = 0;
+        return;
+    }
+    commandsSent().inc();
+
+    if (!slot.inFlight || slot.inFlightPayload != payload) {
+        slot.inFlightPayload = payload;
+        slot.attempts = 0;
+    }
+    slot.inFlight = true;
+    ++slot.attempts;
+    slot.sentNs = Metrics::nowNs();
+    slot.deadlineMs = nowMs() + m_ackTimeoutMs;
+}
+
+void CommandScheduler::sendNextQueued(uint8_t cmd, Slot& slot) {
+    if (!slot.hasQueued) return;
+    const QByteArray payload = slot.queuedPayload;
+    slot.hasQueued = false;
+    slot.queuedPayload.clear();
+    slot.inFlight = false;
+    transmit(cmd, slot, payload);
+}
+
+void CommandScheduler::onTick() {
+    const qint64 now = nowMs();
+    QVector<uint8_t> failed;
+    for (auto it = m_slots.begin(); it != m_slots.end(); ++it) {
+        Slot& slot = *it;
+        if (!slot.inFlight || now < slot.deadlineMs) continue;
+
+        const uint8_t cmd = it.key();
+        if (slot.hasQueued) {
+            // 已有更新的同类命令，旧命令无需再重发
+            sendNextQueued(cmd, slot);
+        } else if (slot.attempts < m_maxAttempts) {
+            commandRetries().inc();
+            LOG_WARN("命令应答超时，重发 CMD={} 第{}次", cmd, slot.attempts + 1);
+            transmit(cmd, slot, slot.inFlightPayload);
+        } else {
+            commandFailures().inc();
+            LOG_WARN("命令应答超时，放弃 CMD={}", cmd);
+            slot.inFlight = false;
+            slot.inFlightPayload.clear();
+            slot.attempts = 0;
+            failed.append(cmd);
+        }
+    }
+    updateTimer();
+
+    // 遍历结束后再通知，接收方可能在槽函数中提交新命令
+    for (uint8_t cmd : failed) {
+        emit commandFailed(cmd);
+    }
+}
+
+void CommandScheduler::updateTimer() {
+    bool anyInFlight = false;
+    for (auto it = m_slots.constBegin(); it != m_slots.constEnd(); ++it) {
+        if (it->inFlight) {
+            anyInFlight = true;
+            break;
+        }
+    }
+    if (anyInFlight && !m_timer->isActive()) {
+        m_timer->start();
+    } else if (!anyInFlight && m_timer->isActive()) {
+        m_timer->stop();
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef COMMANDSCHEDULER_H
+#define COMMANDSCHEDULER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QMap>
+#include <QVector>
+#include <functional>
+
+class QTimer;
+
+/**
+ * @brief 下行控制命令调度器（每个设备连接一个实例）
+ *
+ * - 合并：同一 CMD 还未发出的命令只保留最新一条（滑块连续拖动只发最后的阈值）
+ * - 应答匹配：CMD_CRTL_ACK 只带原始 CMD，因此同一 CMD 同时只允许一条在途，
+ *   收到应答即匹配到该条；不同 CMD 之间互不阻塞
+ * - 超时重发：超时未应答时重发，超过次数上限后放弃并发出 commandFailed；
+ *   若重发前已有更新的同类命令排队，直接改发新命令
+ * - 往返时延记入 gh_command_rtt_us 直方图
+ *
+ * 链路不可用时（FrameWriter 返回 false）需要应答的命令留在排队位置，由 takePending() 取出重放；
+ * 不需要应答的命令（如 CMD_Get_Date）直接发送，不进入调度，写出失败时发出 commandFailed。
+ */
+class CommandScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    /// 实际写出一帧，返回 false 表示链路不可用
+    using FrameWriter = std::function<bool(uint8_t cmd, const QByteArray& payload)>;
+
+    /// 尚未确认的命令（链路恢复后重放）
+    struct PendingCommand {
+        uint8_t cmd = 0;
+        QByteArray payload;
+    };
+
+    explicit CommandScheduler(FrameWriter writer, QObject* parent = nullptr);
+    ~CommandScheduler();
+
+    /**
+     * @brief 提交一条命令
+     */
+    void submit(uint8_t cmd, const QByteArray& payload);
+
+    /**
+     * @brief 处理下位机应答
+     * @param originalCmd 应答对应的命令
+     * @param result 0x01=成功，其他=失败
+     */
+    void onAck(uint8_t originalCmd, uint8_t result);
+
+    /**
+     * @brief 丢弃所有排队和在途命令（断开连接时调用）
+     */
+    void reset();
+
+    /**
+     * @brief 取出所有未确认的命令并清空（每个 CMD 只保留最新一条）
+     */
+    QVector<PendingCommand> takePending();
+
+    /**
+     * @brief 排队 + 在途命令数
+     */
+    int pendingCount() const;
+
+    void setAckTimeoutMs(int ms) { m_ackTimeoutMs = ms; }
+    void setMaxAttempts(int attempts) { m_maxAttempts = attempts < 1 ? 1 : attempts; }
+
+    /**
+     * @brief 该命令是否需要下位机应答
+     */
+    static bool expectsAck(uint8_t cmd);
+
+signals:
+    /**
+     * @brief 收到应答
+     * @param cmd 原始命令
+     * @param success 下位机执行结果
+     * @param rttUs 最后一次发送到收到应答的时延（微秒）
+     */
+    void ackReceived(uint8_t cmd, bool success, qint64 rttUs);
+
+    /**
+     * @brief 重试次数用尽仍未收到应答，或不需要应答的命令因链路不可用未能发出
+     */
+    void commandFailed(uint8_t cmd);
+
+private:
+    struct Slot {
+        bool inFlight = false;
+        QByteArray inFlightPayload;
+        int attempts = 0;              // 在途命令已发送次数
+        qint64 sentNs = 0;             // 最近一次发送时间
+        qint64 deadlineMs = 0;
+
+        bool hasQueued = false;        // 在途期间提交的新命令（只保留最新）
+        QByteArray queuedPayload;
+    };
+
+    void transmit(uint8_t cmd, Slot& slot, const QByteArray& payload);
+    void sendNextQueued(uint8_t cmd, Slot& slot);
+    void onTick();
+    void updateTimer();
+
+    FrameWriter m_writer;
+    QMap<uint8_t, Slot> m_slots;
+    QTimer* m_timer;
+
+    int m_ackTimeoutMs;
+    int m_maxAttempts;
+
+    static constexpr int TICK_MS = 50;
+};
+
+#endif // COMMANDSCHEDULER_H
@@ -0,0 +1,11 @@
+#include "FrameBuilder.h"
+
+bool FrameBuilder::append(uint8_t cmd, const uint8_t* payload, uint8_t len) {
+    const std::size_t frameSize = static_cast<std::size_t>(len) + 4;
+    if (m_size + frameSize > CAPACITY) {
+        return false;
+    }
+    m_size += ProtocolParser::encodeFrame(cmd, payload, len, m_buffer + m_size);
+    ++m_frames;
+    return true;
+}
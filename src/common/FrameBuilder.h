@@ -0,0 +1,48 @@
+#ifndef FRAMEBUILDER_H
+#define FRAMEBUILDER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ProtocolParser.h"
+
+/**
+ * @brief 下行帧拼装缓冲区
+ *
+ * 多个帧依次编码到同一块定长缓冲区中（对象内数组，不做堆分配），
+ * 调用方一次性写出整个缓冲区：串口只调用一次 write，WebSocket 只发一条消息。
+ * 下位机按字节流拆帧，多帧连续发送与分开发送等价。
+ */
+class FrameBuilder
+{
+public:
+    /// 一批最多容纳的字节数（至少能放下 4 个最大帧）
+    static constexpr std::size_t CAPACITY = 4 * ProtocolParser::MAX_FRAME_SIZE;
+
+    FrameBuilder() = default;
+    FrameBuilder(const FrameBuilder&) = delete;
+    FrameBuilder& operator=(const FrameBuilder&) = delete;
+
+    /**
+     * @brief 追加一帧
+     * @return 剩余空间不足时返回 false，缓冲区内容不变
+     */
+    bool append(uint8_t cmd, const uint8_t* payload, uint8_t len);
+
+    /**
+     * @brief 清空缓冲区（写出后调用）
+     */
+    void clear() { m_size = 0; m_frames = 0; }
+
+    const uint8_t* data() const { return m_buffer; }
+    std::size_t size() const { return m_size; }
+    int frameCount() const { return m_frames; }
+    bool isEmpty() const { return m_size == 0; }
+
+private:
+    uint8_t m_buffer[CAPACITY];
+    std::size_t m_size = 0;
+    int m_frames = 0;
+};
+
+#endif // FRAMEBUILDER_H
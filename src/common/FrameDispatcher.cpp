@@ -0,0 +1,9 @@
+#include "FrameDispatcher.h"
+
+FrameDispatcher::Result FrameDispatcher::dispatch(uint8_t cmd, const uint8_t* payload, uint8_t len) const {
+    const Entry& entry = m_table[cmd];
+    if (!entry.handler) return UnknownCommand;
+    if (len != entry.size) return LengthMismatch;
+    entry.handler(payload);
+    return Handled;
+}
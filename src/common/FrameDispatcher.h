@@ -0,0 +1,62 @@
+#ifndef FRAMEDISPATCHER_H
+#define FRAMEDISPATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "ProtocolMessages.h"
+
+/**
+ * @brief 按命令字查表分发已校验的帧
+ *
+ * 256 项的处理表以 CMD 为下标，每项记录该命令的负载长度和解码后的回调；
+ * 分发时一次查表 + 一次长度比较，解码由 Protocol::Message 的布局生成。
+ * 串口和 WebSocket 注册同一组处理函数，两条链路的解码完全一致。
+ */
+class FrameDispatcher
+{
+public:
+    enum Result {
+        Handled,
+        UnknownCommand,     // 没有注册该 CMD
+        LengthMismatch      // 负载长度与布局不符
+    };
+
+    FrameDispatcher() = default;
+    FrameDispatcher(const FrameDispatcher&) = delete;
+    FrameDispatcher& operator=(const FrameDispatcher&) = delete;
+
+    /**
+     * @brief 注册 Msg::CMD 的处理函数，handler 签名为 void(const Msg::Type&)
+     */
+    template <typename Msg, typename Handler>
+    void on(Handler handler) {
+        Entry& entry = m_table[Msg::CMD];
+        entry.size = Msg::SIZE;
+        entry.handler = [handler](const uint8_t* payload) {
+            typename Msg::Type value;
+            Msg::Layout::decode(payload, value);
+            handler(static_cast<const typename Msg::Type&>(value));
+        };
+    }
+
+    /**
+     * @brief 分发一帧（payload 为 CRC 校验通过的负载）
+     */
+    Result dispatch(uint8_t cmd, const uint8_t* payload, uint8_t len) const;
+
+    bool hasHandler(uint8_t cmd) const { return static_cast<bool>(m_table[cmd].handler); }
+    std::size_t expectedLength(uint8_t cmd) const { return m_table[cmd].size; }
+
+private:
+    struct Entry {
+        std::size_t size = 0;
+        std::function<void(const uint8_t*)> handler;
+    };
+
+    Entry m_table[256];
+};
+
+#endif // FRAMEDISPATCHER_H
@@ -0,0 +1,223 @@
+#ifndef PROTOCOLMESSAGES_H
+#define PROTOCOLMESSAGES_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Protocol.h"
+#include "model/SensorData.h"
+#include "model/ActuatorStateData.h"
+#include "model/UserSetting.h"
+
+/**
+ * @brief 协议负载布局（编译期描述，上下位机共用一份）
+ *
+ * 每种负载声明为 Layout<结构体, 长度, 字段...>，字段给出成员、编码方式和偏移；
+ * 解码 / 编码由模板展开成直线代码，没有逐字段的分支。
+ * Message<CMD, Layout> 把命令字和布局绑定，解码前只检查一次长度。
+ */
+namespace Protocol {
+
+// ========================================
+// 字段编码
+// ========================================
+
+/**
+ * @brief 单字节无符号
+ */
+struct U8 {
+    static constexpr std::size_t WIDTH = 1;
+
+    template <typename T>
+    static T read(const uint8_t* p) { return static_cast<T>(p[0]); }
+
+    template <typename T>
+    static void write(T value, uint8_t* p) { p[0] = static_cast<uint8_t>(value); }
+};
+
+/**
+ * @brief 大端 int16（高字节在前）
+ */
+struct I16BE {
+    static constexpr std::size_t WIDTH = 2;
+
+    template <typename T>
+    static T read(const uint8_t* p) {
+        return static_cast<T>(static_cast<int16_t>((static_cast<uint16_t>(p[0]) << 8) | p[1]));
+    }
+
+    template <typename T>
+    static void write(T value, uint8_t* p) {
+        const uint16_t v = static_cast<uint16_t>(static_cast<int16_t>(value));
+        p[0] = static_cast<uint8_t>(v >> 8);
+        p[1] = static_cast<uint8_t>(v & 0xFF);
+    }
+};
+
+/**
+ * @brief 结构体成员 Member 以 Codec 编码在负载的 Offset 处
+ */
+template <typename Msg, typename T, T Msg::*Member, typename Codec, std::size_t Offset>
+struct Field {
+    static constexpr std::size_t END = Offset + Codec::WIDTH;
+
+    static void decode(const uint8_t* p, Msg& out) { out.*Member = Codec::template read<T>(p + Offset); }
+    static void encode(const Msg& in, uint8_t* p) { Codec::template write<T>(in.*Member, p + Offset); }
+};
+
+// ========================================
+// 负载布局
+// ========================================
+
+namespace detail {
+
+constexpr bool fitsIn(std::size_t) { return true; }
+
+template <typename... Ends>
+constexpr bool fitsIn(std::size_t size, std::size_t end, Ends... rest) {
+    return end <= size && fitsIn(size, rest...);
+}
+
+} // namespace detail
+
+/**
+ * @brief 定长负载：Size 字节，未被字段覆盖的字节（保留位）编码为 0
+ */
+template <typename Msg, std::size_t Size, typename... Fields>
+struct Layout {
+    using Type = Msg;
+    static constexpr std::size_t SIZE = Size;
+    static_assert(Size <= 255, "payload length is a single byte");
+    static_assert(detail::fitsIn(Size, Fields::END...), "field exceeds payload size");
+
+    static void decode(const uint8_t* p, Msg& out) {
+        using expand = int[];
+        (void)expand{0, (Fields::decode(p, out), 0)...};
+    }
+
+    static void encode(const Msg& in, uint8_t* p) {
+        for (std::size_t i = 0; i < Size; ++i) p[i] = 0;
+        using expand = int[];
+        (void)expand{0, (Fields::encode(in, p), 0)...};
+    }
+};
+
+/**
+ * @brief 命令字 + 负载布局
+ */
+template <uint8_t Cmd, typename LayoutT>
+struct Message {
+    using Layout = LayoutT;
+    using Type = typename LayoutT::Type;
+    static constexpr uint8_t CMD = Cmd;
+    static constexpr std::size_t SIZE = LayoutT::SIZE;
+
+    /**
+     * @brief 长度不符时返回 false，out 不变
+     */
+    static bool decode(const uint8_t* p, std::size_t len, Type& out) {
+        if (len != SIZE) return false;
+        LayoutT::decode(p, out);
+        return true;
+    }
+
+    /**
+     * @brief 编码到 out（至少 SIZE 字节），返回负载长度
+     */
+    static uint8_t encode(const Type& in, uint8_t* out) {
+        LayoutT::encode(in, out);
+        return static_cast<uint8_t>(SIZE);
+    }
+};
+
+// ========================================
+// 只在协议里出现的负载
+// ========================================
+
+struct CtrlAckData {
+    uint8_t originalCmd = 0;  // 被应答的命令字
+    uint8_t result = 0;       // 0x01=成功
+};
+
+struct HeartBeatData {
+    uint8_t status = 0;       // 0x01=设备正常
+};
+
+struct SwitchData {
+    uint8_t enable = 0;       // 0=关 1=开
+};
+
+// ========================================
+// 上行（下位机 → 上位机）
+// ========================================
+
+// [airHum, tmpH, tmpL, soilHum, lightH, lightL]
+using SensorMessage = Message<CMD_SENSOR, Layout<SensorSample, 6,
+    Field<SensorSample, int32_t, &SensorSample::airHumid, U8, 0>,
+    Field<SensorSample, int32_t, &SensorSample::airTemp, I16BE, 1>,
+    Field<SensorSample, int32_t, &SensorSample::soilHumid, U8, 3>,
+    Field<SensorSample, int32_t, &SensorSample::lightIntensity, I16BE, 4>>>;
+
+// [fan, speed, pump, lamp, auto]
+using MotorStateMessage = Message<CMD_MOTOR_STATE, Layout<ActuatorStateData, 5,
+    Field<ActuatorStateData, uint8_t, &ActuatorStateData::fanStatus, U8, 0>,
+    Field<ActuatorStateData, uint8_t, &ActuatorStateData::fanSpeed, U8, 1>,
+    Field<ActuatorStateData, uint8_t, &ActuatorStateData::pumpStatus, U8, 2>,
+    Field<ActuatorStateData, uint8_t, &ActuatorStateData::lampStatus, U8, 3>,
+    Field<ActuatorStateData, uint8_t, &ActuatorStateData::autoMode, U8, 4>>>;
+
+// [hour, minute, weatherCode, tempNowH, tempNowL, tempLow, tempHigh, reserved]
+using TimeWeatherMessage = Message<CMD_TIME_WEATHER, Layout<TimeWeatherData, 8,
+    Field<TimeWeatherData, uint8_t, &TimeWeatherData::hour, U8, 0>,
+    Field<TimeWeatherData, uint8_t, &TimeWeatherData::minute, U8, 1>,
+    Field<TimeWeatherData, uint8_t, &TimeWeatherData::weatherCode, U8, 2>,
+    Field<TimeWeatherData, int16_t, &TimeWeatherData::tempNow, I16BE, 3>,
+    Field<TimeWeatherData, int16_t, &TimeWeatherData::tempLow, U8, 5>,
+    Field<TimeWeatherData, int16_t, &TimeWeatherData::tempHigh, U8, 6>>>;
+
+// [fanOff, fanOn, lampOff, lampOn, pumpOff, pumpOn]（下位机回报的顺序与下发不同）
+using ThresholdReportMessage = Message<CMD_THRESHOLD, Layout<Threshold, 6,
+    Field<Threshold, uint8_t, &Threshold::fanOffThreshold, U8, 0>,
+    Field<Threshold, uint8_t, &Threshold::fanOnThreshold, U8, 1>,
+    Field<Threshold, uint8_t, &Threshold::lampOffThreshold, U8, 2>,
+    Field<Threshold, uint8_t, &Threshold::lampONThreshold, U8, 3>,
+    Field<Threshold, uint8_t, &Threshold::DumpOffThreshold, U8, 4>,
+    Field<Threshold, uint8_t, &Threshold::DumpOnThreshold, U8, 5>>>;
+
+// [originalCmd, result]
+using CtrlAckMessage = Message<CMD_CRTL_ACK, Layout<CtrlAckData, 2,
+    Field<CtrlAckData, uint8_t, &CtrlAckData::originalCmd, U8, 0>,
+    Field<CtrlAckData, uint8_t, &CtrlAckData::result, U8, 1>>>;
+
+// [status]
+using HeartBeatMessage = Message<CMD_HEART_BEAT, Layout<HeartBeatData, 1,
+    Field<HeartBeatData, uint8_t, &HeartBeatData::status, U8, 0>>>;
+
+// ========================================
+// 下行（上位机 → 下位机）
+// ========================================
+
+// [fan, speed, pump, lamp]
+using MotorControlMessage = Message<CMD_MOTOR_CRTL, Layout<ActuatorStateData, 4,
+    Field<ActuatorStateData, uint8_t, &ActuatorStateData::fanStatus, U8, 0>,
+    Field<ActuatorStateData, uint8_t, &ActuatorStateData::fanSpeed, U8, 1>,
+    Field<ActuatorStateData, uint8_t, &ActuatorStateData::pumpStatus, U8, 2>,
+    Field<ActuatorStateData, uint8_t, &ActuatorStateData::lampStatus, U8, 3>>>;
+
+// [fanOn, fanOff, pumpOn, pumpOff, lampOn, lampOff]
+using ThresholdSetMessage = Message<CMD_THRESHOLD, Layout<Threshold, 6,
+    Field<Threshold, uint8_t, &Threshold::fanOnThreshold, U8, 0>,
+    Field<Threshold, uint8_t, &Threshold::fanOffThreshold, U8, 1>,
+    Field<Threshold, uint8_t, &Threshold::DumpOnThreshold, U8, 2>,
+    Field<Threshold, uint8_t, &Threshold::DumpOffThreshold, U8, 3>,
+    Field<Threshold, uint8_t, &Threshold::lampONThreshold, U8, 4>,
+    Field<Threshold, uint8_t, &Threshold::lampOffThreshold, U8, 5>>>;
+
+using SwitchLayout = Layout<SwitchData, 1, Field<SwitchData, uint8_t, &SwitchData::enable, U8, 0>>;
+using DataCtrlMessage = Message<CMD_DATA_CRTL, SwitchLayout>;
+using AutoModeMessage = Message<CMD_AUTO_MODE, SwitchLayout>;
+using GetDateMessage = Message<CMD_Get_Date, SwitchLayout>;
+
+} // namespace Protocol
+
+#endif // PROTOCOLMESSAGES_H
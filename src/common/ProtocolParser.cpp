@@ -1,3 +1,84 @@
 #include "ProtocolParser.h"
 
+#include <cstring>
+
 ProtocolParser::ProtocolParser() {}
+
+void ProtocolParser::reset() {
+    m_state = WAIT_SOF;
+    m_index = 0;
+    m_len = 0;
+}
+
+void ProtocolParser::feed(const uint8_t* data, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        const uint8_t byte = data[i];
+        switch (m_state) {
+        case WAIT_SOF:
+            if (byte == Protocol::SOF) {
+                m_state = WAIT_CMD;
+            }
+            break;
+        case WAIT_CMD:
+            m_cmd = byte;
+            m_state = WAIT_LEN;
+            break;
+        case WAIT_LEN:
+            m_len = byte;
+            m_index = 0;
+            m_state = (m_len > 0) ? WAIT_DATA : WAIT_CRC;
+            break;
+        case WAIT_DATA: {
+            // 整段拷贝 payload，避免逐字节走状态机
+            std::size_t need = m_len - m_index;
+            std::size_t avail = size - i;
+            std::size_t n = need < avail ? need : avail;
+            std::memcpy(m_buffer + m_index, data + i, n);
+            m_index = static_cast<uint8_t>(m_index + n);
+            i += n - 1;
+            if (m_index >= m_len) {
+                m_state = WAIT_CRC;
+            }
+            break;
+        }
+        case WAIT_CRC: {
+            uint8_t calculated = calcCRC(m_buffer, m_len);
+            if (byte == calculated) {
+                if (m_onFrame) {
+                    m_onFrame(m_cmd, m_buffer, m_len);
+                }
+            } else if (m_onCrcError) {
+                m_onCrcError(m_cmd, calculated, byte);
+            }
+            m_state = WAIT_SOF;
+            break;
+        }
+        }
+    }
+}
+
+// CRC-8算法（与下位机完全一致）
+uint8_t ProtocolParser::calcCRC(const uint8_t* data, int len) {
+    uint8_t crc = 0;
+    for (int i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            if (crc & 0x80)
+                crc = (crc << 1) ^ 0x07;
+            else
+                crc <<= 1;
+        }
+    }
+    return crc;
+}
+
+std::size_t ProtocolParser::encodeFrame(uint8_t cmd, const uint8_t* payload, uint8_t len, uint8_t* out) {
+    out[0] = Protocol::SOF;
+    out[1] = cmd;
+    out[2] = len;
+    if (len > 0) {
+        std::memcpy(out + 3, payload, len);
+    }
+    out[3 + len] = calcCRC(payload, len);
+    return static_cast<std::size_t>(len) + 4;
+}
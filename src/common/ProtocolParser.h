@@ -1,10 +1,75 @@
 #ifndef PROTOCOLPARSER_H
 #define PROTOCOLPARSER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "Protocol.h"
+
+/**
+ * @brief 协议帧编解码器（SOF | CMD | LEN | PAYLOAD | CRC8）
+ *
+ * 串口、WebSocket 以及设备模拟器共用同一套状态机和 CRC 算法，
+ * 避免多处手写的解析逻辑出现差异。
+ */
 class ProtocolParser
 {
 public:
+    /// 收到一帧 CRC 校验通过的完整数据
+    using FrameHandler = std::function<void(uint8_t cmd, const uint8_t* payload, uint8_t len)>;
+    /// CRC 校验失败
+    using CrcErrorHandler = std::function<void(uint8_t cmd, uint8_t expected, uint8_t received)>;
+
+    /// 单帧最大长度（帧头 3 字节 + 最大 payload 255 字节 + CRC 1 字节）
+    static constexpr std::size_t MAX_FRAME_SIZE = 3 + 255 + 1;
+
     ProtocolParser();
+
+    void setFrameHandler(FrameHandler handler) { m_onFrame = std::move(handler); }
+    void setCrcErrorHandler(CrcErrorHandler handler) { m_onCrcError = std::move(handler); }
+
+    /**
+     * @brief 输入任意长度的字节流，内部按状态机拆帧
+     * @param data 数据指针
+     * @param size 字节数
+     */
+    void feed(const uint8_t* data, std::size_t size);
+
+    /**
+     * @brief 丢弃未完成的帧，回到等待帧头状态
+     */
+    void reset();
+
+    /**
+     * @brief CRC-8 计算（多项式 0x07，与下位机完全一致）
+     */
+    static uint8_t calcCRC(const uint8_t* data, int len);
+
+    /**
+     * @brief 将一帧编码到 out 中
+     * @param out 输出缓冲区，至少 len + 4 字节
+     * @return 写入的字节数
+     */
+    static std::size_t encodeFrame(uint8_t cmd, const uint8_t* payload, uint8_t len, uint8_t* out);
+
+private:
+    enum State {
+        WAIT_SOF,
+        WAIT_CMD,
+        WAIT_LEN,
+        WAIT_DATA,
+        WAIT_CRC
+    };
+
+    State m_state = WAIT_SOF;
+    uint8_t m_cmd = 0;
+    uint8_t m_len = 0;
+    uint8_t m_index = 0;
+    uint8_t m_buffer[255];
+
+    FrameHandler m_onFrame;
+    CrcErrorHandler m_onCrcError;
 };
 
 #endif // PROTOCOLPARSER_H
@@ -0,0 +1,205 @@
+#ifndef SAMPLEBUS_H
+#define SAMPLEBUS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief 单生产者、多消费者的无锁广播环形缓冲区
+ *
+ * 生产者（UI 线程上的帧解析）每发布一个样本写入环形缓冲区的一个槽位，
+ * 每个消费者持有自己的读游标，按自己的节奏读取，互不影响：
+ * - DropOldest：消费者落后超过 Capacity 时最旧的样本被覆盖，计入该消费者的 dropped
+ *   （图表、首页等只关心最新数据的消费者）
+ * - Backpressure：生产者不会覆盖该消费者未读的样本，环满时 publish 返回 false 并计入 rejected
+ *   （数据库写入等不能丢数据的消费者）
+ *
+ * 槽位内容按 64 位原子字存储，每个槽位带版本号（写入中为奇数），
+ * 读者读到一半被覆盖时通过版本号检测出来并按丢弃处理，不会读到撕裂的样本。
+ * T 必须是平凡可复制类型。消费者可以在任意线程读取；subscribe / unsubscribe 只在初始化时调用。
+ */
+template <typename T, std::size_t Capacity = 1024>
+class SampleBus
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SampleBus requires a trivially copyable sample type");
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    enum Policy {
+        DropOldest,
+        Backpressure
+    };
+
+    static constexpr int MAX_CONSUMERS = 8;
+
+    /**
+     * @brief 消费者统计
+     */
+    struct ConsumerStats {
+        uint64_t delivered = 0;   // 已读取的样本数
+        uint64_t dropped = 0;     // 被覆盖而未读到的样本数
+        uint64_t lag = 0;         // 当前未读的样本数
+    };
+
+    SampleBus() {
+        for (Slot& slot : m_slots) slot.version.store(0, std::memory_order_relaxed);
+    }
+    SampleBus(const SampleBus&) = delete;
+    SampleBus& operator=(const SampleBus&) = delete;
+
+    /**
+     * @brief 注册消费者，从下一个发布的样本开始读取
+     * @return 消费者编号，消费者已满时返回 -1
+     */
+    int subscribe(const char* name, Policy policy) {
+        for (int i = 0; i < MAX_CONSUMERS; ++i) {
+            Consumer& c = m_consumers[i];
+            if (c.active.load(std::memory_order_acquire)) continue;
+            c.name = name;
+            c.policy = policy;
+            c.delivered.store(0, std::memory_order_relaxed);
+            c.dropped.store(0, std::memory_order_relaxed);
+            c.cursor.store(m_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+            c.active.store(true, std::memory_order_release);
+            return i;
+        }
+        return -1;
+    }
+
+    void unsubscribe(int consumer) {
+        if (valid(consumer)) m_consumers[consumer].active.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @brief 发布一个样本（只能由一个线程调用）
+     * @return Backpressure 消费者的未读样本已占满环形缓冲区时返回 false，样本被丢弃
+     */
+    bool publish(const T& value) {
+        const uint64_t seq = m_head.load(std::memory_order_relaxed);
+        for (const Consumer& c : m_consumers) {
+            if (c.policy == Backpressure && c.active.load(std::memory_order_acquire)
+                && seq - c.cursor.load(std::memory_order_acquire) >= Capacity) {
+                m_rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        uint64_t words[WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        Slot& slot = m_slots[seq & MASK];
+        slot.version.store(2 * seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.version.store(2 * seq + 2, std::memory_order_release);
+        m_head.store(seq + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 读取该消费者的下一个样本（每个消费者只能由一个线程读取）
+     * @return 没有新样本时返回 false
+     */
+    bool poll(int consumer, T& out) {
+        Consumer& c = m_consumers[consumer];
+        uint64_t pos = c.cursor.load(std::memory_order_relaxed);
+
+        for (;;) {
+            const uint64_t head = m_head.load(std::memory_order_acquire);
+            if (pos >= head) {
+                c.cursor.store(pos, std::memory_order_release);
+                return false;
+            }
+            if (head - pos > Capacity) {
+                // 落后超过一圈：跳到仍然有效的最旧样本
+                c.dropped.fetch_add(head - pos - Capacity, std::memory_order_relaxed);
+                pos = head - Capacity;
+            }
+
+            const Slot& slot = m_slots[pos & MASK];
+            const uint64_t expected = 2 * pos + 2;
+            const uint64_t before = slot.version.load(std::memory_order_acquire);
+            if (before == expected) {
+                uint64_t words[WORDS];
+                for (std::size_t i = 0; i < WORDS; ++i) {
+                    words[i] = slot.words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.version.load(std::memory_order_relaxed) == expected) {
+                    std::memcpy(&out, words, sizeof(T));
+                    c.cursor.store(pos + 1, std::memory_order_release);
+                    c.delivered.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            // 读取期间槽位被新样本覆盖
+            c.dropped.fetch_add(1, std::memory_order_relaxed);
+            ++pos;
+        }
+    }
+
+    /**
+     * @brief 依次读取至多 maxCount 个样本并交给 fn
+     * @return 读取的样本数
+     */
+    template <typename Fn>
+    std::size_t drain(int consumer, Fn&& fn, std::size_t maxCount = Capacity) {
+        std::size_t count = 0;
+        T value;
+        while (count < maxCount && poll(consumer, value)) {
+            fn(static_cast<const T&>(value));
+            ++count;
+        }
+        return count;
+    }
+
+    ConsumerStats stats(int consumer) const {
+        ConsumerStats s;
+        if (!valid(consumer)) return s;
+        const Consumer& c = m_consumers[consumer];
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        const uint64_t cursor = c.cursor.load(std::memory_order_acquire);
+        s.delivered = c.delivered.load(std::memory_order_relaxed);
+        s.dropped = c.dropped.load(std::memory_order_relaxed);
+        s.lag = head > cursor ? head - cursor : 0;
+        return s;
+    }
+
+    const char* consumerName(int consumer) const { return valid(consumer) ? m_consumers[consumer].name : ""; }
+    bool isActive(int consumer) const { return valid(consumer) && m_consumers[consumer].active.load(std::memory_order_acquire); }
+    uint64_t published() const { return m_head.load(std::memory_order_acquire); }
+    uint64_t rejected() const { return m_rejected.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint64_t> version;
+        std::atomic<uint64_t> words[WORDS];
+    };
+
+    // 每个消费者独占缓存行，避免多个读线程更新游标时互相失效
+    struct alignas(64) Consumer {
+        std::atomic<uint64_t> cursor{0};
+        std::atomic<uint64_t> delivered{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<bool> active{false};
+        Policy policy = DropOldest;
+        const char* name = "";
+    };
+
+    bool valid(int consumer) const { return consumer >= 0 && consumer < MAX_CONSUMERS; }
+
+    Slot m_slots[Capacity];
+    Consumer m_consumers[MAX_CONSUMERS];
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    std::atomic<uint64_t> m_rejected{0};
+};
+
+#endif // SAMPLEBUS_H
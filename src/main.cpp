@@ -2,6 +2,11 @@
 #include "sqlite_orm.h"
 
 #include <QApplication>
+#include <QTimer>
+#include "untils/Log.h"
+#include "untils/StartupTrace.h"
+#include "model/Database/ConnectionManager.h"
+#include "model/Database/HotTierCache.h"
 #include "../src/widget/Login/Login.h"
 #include "../src/widget/UserInfo/userinfo.h"
 
@@ -13,7 +18,20 @@
 using namespace sqlite_orm;
 int main(int argc, char *argv[])
 {
+    StartupTrace::begin();
     QApplication a(argc, argv);
+    StartupTrace::mark("创建 QApplication");
+
+    // 异步日志：写入程序目录下 logs/，qDebug 输出也一并转入
+    LogConfig logConfig;
+    logConfig.directory = (QApplication::applicationDirPath() + "/logs").toStdString();
+#ifndef NDEBUG
+    logConfig.level = LogLevel::Debug;
+    logConfig.echoToStderr = true;
+#endif
+    Log::init(logConfig);
+    StartupTrace::mark("初始化日志");
+
     // MainWindow w;
     // w.show();
 
@@ -22,10 +40,19 @@ int main(int argc, char *argv[])
     // test test;
     // test.show();
     MainWindow w;
+    StartupTrace::mark("构建主窗口");
     w.show();
+    StartupTrace::mark("显示主窗口");
+    // 事件循环处理完第一批事件（含首次绘制）后记为首帧，输出各启动阶段耗时
+    QTimer::singleShot(0, []() { StartupTrace::finish(); });
     Toast::setPosition(ToastPosition::BOTTOM_RIGHT);
     Toast::setSpacing(20);
     Toast::setMaximumOnScreen(5);
 
-    return a.exec();
+    int ret = a.exec();
+    // 先停止热数据缓存的加载、写完排队中的数据库写入，再关闭日志
+    HotTierCache::instance().stop();
+    ConnectionManager::instance().shutdown();
+    Log::shutdown();
+    return ret;
 }
@@ -1,52 +1,259 @@
 #include "ActuatorState.h"
+#include <future>
 #include <iostream>
+#include <QDateTime>
 
-ActuatorState::ActuatorState(const std::string &dbPath)
-:storage(sqlite_orm::make_storage(dbPath,
-        sqlite_orm::make_table("actuator_states",
-            sqlite_orm::make_column("id",&State::id,sqlite_orm::primary_key().autoincrement()),
-            sqlite_orm::make_column("fan",&State::fan),
-            sqlite_orm::make_column("water_pump",&State::water_pump),
-            sqlite_orm::make_column("light_bulb",&State::light_bulb),
-            sqlite_orm::make_column("StartTime",&State::StartTime),
-            sqlite_orm::make_column("EndTime",&State::EndTime)))){
-    storage.sync_schema();
+#include "model/Database/ConnectionManager.h"
+#include "model/Database/SchemaMigrations.h"
+
+namespace {
+
+const char* const kInsertStateSql =
+    "INSERT INTO actuator_states(fan, water_pump, light_bulb, StartTime, EndTime) VALUES(?1, ?2, ?3, ?4, ?5)";
+
+const char* const kInsertRtreeSql =
+    "INSERT OR REPLACE INTO actuator_states_rtree(id, start_epoch, end_epoch) VALUES(?1, ?2, ?3)";
+
+// R*Tree 按区间重叠过滤，再回表取状态
+const char* const kSelectStateRangeSql =
+    "SELECT s.id, s.fan, s.water_pump, s.light_bulb, s.StartTime, s.EndTime "
+    "FROM actuator_states_rtree r JOIN actuator_states s ON s.id = r.id "
+    "WHERE r.end_epoch >= ?1 AND r.start_epoch <= ?2 ORDER BY s.StartTime";
+
+const char* const kDeleteStateRangeSql =
+    "DELETE FROM actuator_states WHERE id IN "
+    "(SELECT id FROM actuator_states_rtree WHERE end_epoch >= ?1 AND start_epoch <= ?2)";
+
+const char* const kDeleteRtreeRangeSql =
+    "DELETE FROM actuator_states_rtree WHERE end_epoch >= ?1 AND start_epoch <= ?2";
+
+const char* const kUpdateEndTimeSql =
+    "UPDATE actuator_states SET EndTime = ?2 WHERE id = ?1";
+
+const char* const kUpdateRtreeEndSql =
+    "UPDATE actuator_states_rtree SET end_epoch = ?2 WHERE id = ?1";
+
+const char* const kSelectDanglingSql =
+    "SELECT s.id, s.StartTime, s.EndTime FROM actuator_states_rtree r JOIN actuator_states s ON s.id = r.id "
+    "WHERE r.end_epoch >= ?1";
+
+// "yyyy-MM-dd hh:mm:ss"（本地时间，与 record_time 一致）转 epoch 秒；只有日期时取当天 0 点
+int64_t toEpochSecs(const std::string& text) {
+    const QString str = QString::fromStdString(text);
+    QDateTime time = QDateTime::fromString(str, "yyyy-MM-dd hh:mm:ss");
+    if (!time.isValid()) {
+        time = QDateTime(QDate::fromString(str, "yyyy-MM-dd"), QTime(0, 0));
+    }
+    return time.isValid() ? time.toSecsSinceEpoch() : -1;
 }
 
-bool ActuatorState::insertState(const State &state) {
-    try {
-        storage.insert(state);
-        return true;
-    }catch (const std::exception& e) {
-        std::cerr << "电机状态插入失败"<<e.what()<<std::endl;
+// rtree_i32 只存 32 位整数
+int32_t clampEpoch(int64_t secs) {
+    if (secs < 0) return 0;
+    if (secs > ActuatorState::OPEN_END) return ActuatorState::OPEN_END;
+    return static_cast<int32_t>(secs);
+}
+
+bool indexInterval(SqliteConnection& conn, int64_t id, const std::string& startTime, const std::string& endTime) {
+    const int64_t start = toEpochSecs(startTime);
+    if (start < 0) {
+        std::cerr << "执行器区间时间格式错误: " << startTime << std::endl;
         return false;
     }
+    const int64_t end = endTime.empty() ? start : toEpochSecs(endTime);
+
+    SqliteStatement* stmt = conn.prepare(kInsertRtreeSql);
+    if (!stmt) return false;
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, id);
+    stmt->bind(2, static_cast<int>(clampEpoch(start)));
+    stmt->bind(3, static_cast<int>(clampEpoch(end < start ? start : end)));
+    return stmt->step() == SQLITE_DONE;
+}
+
+bool insertRow(SqliteConnection& conn, const State& state) {
+    SqliteStatement* stmt = conn.prepare(kInsertStateSql);
+    if (!stmt) return false;
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, state.fan);
+    stmt->bind(2, state.water_pump);
+    stmt->bind(3, state.light_bulb);
+    stmt->bind(4, state.StartTime);
+    stmt->bind(5, state.EndTime);
+    return stmt->step() == SQLITE_DONE;
+}
+
+bool updateEndTime(SqliteConnection& conn, int64_t id, const std::string& endTime) {
+    SqliteStatement* stmt = conn.prepare(kUpdateEndTimeSql);
+    if (!stmt) return false;
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, id);
+    stmt->bind(2, endTime);
+    return stmt->step() == SQLITE_DONE;
+}
+
+bool updateRtreeEnd(SqliteConnection& conn, int64_t id, int64_t endSecs) {
+    SqliteStatement* stmt = conn.prepare(kUpdateRtreeEndSql);
+    if (!stmt) return false;
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, id);
+    stmt->bind(2, static_cast<int>(clampEpoch(endSecs)));
+    return stmt->step() == SQLITE_DONE;
+}
+
+} // namespace
+
+ActuatorState::ActuatorState(const std::string &dbPath)
+:m_openId(std::make_shared<int64_t>(0)){
+    // actuator_states 表及其 R*Tree 索引由 SchemaMigrations 维护（旧区间的索引在后台回填），
+    // 数据读写经由 ConnectionManager
+    (void)dbPath;
+    SchemaMigrations::ensureLatest();
+}
+
+
+bool ActuatorState::insertState(const State &state) {
+    ConnectionManager::instance().post([state](SqliteConnection& conn) {
+        if (!insertRow(conn, state) || !indexInterval(conn, conn.lastInsertRowId(), state.StartTime, state.EndTime)) {
+            std::cerr << "电机状态插入失败"<<conn.lastError()<<std::endl;
+        }
+    });
+    return true;
 }
 
 std::vector<State> ActuatorState::QueryInRange(const std::string &startTime, const std::string &endTime) {
-    try {
-        storage.get_all<State>(
-            sqlite_orm::where(
-        sqlite_orm::c(&State::StartTime)>=startTime &&
-                sqlite_orm::c(&State::StartTime)<=endTime),
-                sqlite_orm::order_by(&State::StartTime)
-        );
-
-    }catch (const std::exception& e) {
-        std::cerr << "查询电机状态失败"<<e.what()<<std::endl;
+    std::vector<State> result;
+
+    const int64_t start = toEpochSecs(startTime);
+    const int64_t end = toEpochSecs(endTime);
+    if (start < 0 || end < 0) {
+        std::cerr << "查询电机状态失败: 时间格式错误"<<std::endl;
+        return result;
+    }
+
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kSelectStateRangeSql) : nullptr;
+    if (!stmt) {
+        std::cerr << "查询电机状态失败"<<std::endl;
+        return result;
+    }
+
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, static_cast<int>(clampEpoch(start)));
+    stmt->bind(2, static_cast<int>(clampEpoch(end)));
+    int rc;
+    while ((rc = stmt->step()) == SQLITE_ROW) {
+        State state;
+        state.id = stmt->columnInt(0);
+        state.fan = stmt->columnInt(1);
+        state.water_pump = stmt->columnInt(2);
+        state.light_bulb = stmt->columnInt(3);
+        state.StartTime = stmt->columnText(4);
+        state.EndTime = stmt->columnText(5);
+        result.push_back(std::move(state));
+    }
+    if (rc != SQLITE_DONE) {
+        std::cerr << "查询电机状态失败"<<conn->lastError()<<std::endl;
         return {};
     }
+    return result;
 }
 
 bool ActuatorState::deleteInRange(const std::string &startTime, const std::string &endTime) {
-    try {
-            storage.remove_all<State>(
-                sqlite_orm::where(
-                    sqlite_orm::c(&State::StartTime)<=endTime &&
-                    startTime<=sqlite_orm::c(&State::EndTime)));
-        return true;
-    }catch (const std::exception& e) {
-        std::cerr << "电机状态删除失败"<<e.what()<<std::endl;
+    const int64_t start = toEpochSecs(startTime);
+    const int64_t end = toEpochSecs(endTime);
+    if (start < 0 || end < 0) {
+        std::cerr << "电机状态删除失败: 时间格式错误"<<std::endl;
         return false;
     }
+
+    // 删除与 [startTime, endTime] 有重叠的区间（先删主表，再删索引）
+    std::future<bool> result = ConnectionManager::instance().submit([start, end](SqliteConnection& conn) {
+        for (const char* sql : {kDeleteStateRangeSql, kDeleteRtreeRangeSql}) {
+            SqliteStatement* stmt = conn.prepare(sql);
+            if (!stmt) return false;
+            SqliteStatementScope scope(*stmt);
+            stmt->bind(1, static_cast<int>(clampEpoch(start)));
+            stmt->bind(2, static_cast<int>(clampEpoch(end)));
+            if (stmt->step() != SQLITE_DONE) return false;
+        }
+        return true;
+    });
+    bool ok = false;
+    try {
+        ok = result.get();
+    } catch (const std::exception& e) {
+        std::cerr << "电机状态删除事务提交失败: " << e.what() << std::endl;
+    }
+    if (!ok) {
+        std::cerr << "电机状态删除失败"<<std::endl;
+    }
+    return ok;
+}
+
+// ========================================
+// 进行中的区间
+// ========================================
+
+void ActuatorState::beginInterval(const State &state) {
+    std::shared_ptr<int64_t> openId = m_openId;
+    ConnectionManager::instance().post([state, openId](SqliteConnection& conn) {
+        *openId = 0;
+        const int64_t start = toEpochSecs(state.StartTime);
+        if (start < 0 || !insertRow(conn, state)) {
+            std::cerr << "电机状态插入失败"<<conn.lastError()<<std::endl;
+            return;
+        }
+        const int64_t id = conn.lastInsertRowId();
+        SqliteStatement* stmt = conn.prepare(kInsertRtreeSql);
+        if (!stmt) return;
+        SqliteStatementScope scope(*stmt);
+        stmt->bind(1, id);
+        stmt->bind(2, static_cast<int>(clampEpoch(start)));
+        stmt->bind(3, static_cast<int>(OPEN_END));
+        if (stmt->step() == SQLITE_DONE) {
+            *openId = id;
+        }
+    });
+}
+
+void ActuatorState::extendInterval(const std::string &endTime) {
+    std::shared_ptr<int64_t> openId = m_openId;
+    ConnectionManager::instance().post([endTime, openId](SqliteConnection& conn) {
+        if (*openId != 0) updateEndTime(conn, *openId, endTime);
+    });
+}
+
+void ActuatorState::endInterval(const std::string &endTime) {
+    std::shared_ptr<int64_t> openId = m_openId;
+    ConnectionManager::instance().post([endTime, openId](SqliteConnection& conn) {
+        if (*openId == 0) return;
+        if (!updateEndTime(conn, *openId, endTime) || !updateRtreeEnd(conn, *openId, toEpochSecs(endTime))) {
+            std::cerr << "电机状态区间结束失败"<<conn.lastError()<<std::endl;
+        }
+        *openId = 0;
+    });
+}
+
+void ActuatorState::closeDanglingIntervals() {
+    ConnectionManager::instance().post([](SqliteConnection& conn) {
+        SqliteStatement* stmt = conn.prepare(kSelectDanglingSql);
+        if (!stmt) return;
+        std::vector<State> dangling;
+        {
+            SqliteStatementScope scope(*stmt);
+            stmt->bind(1, static_cast<int>(OPEN_END));
+            while (stmt->step() == SQLITE_ROW) {
+                State state;
+                state.id = stmt->columnInt(0);
+                state.StartTime = stmt->columnText(1);
+                state.EndTime = stmt->columnText(2);
+                dangling.push_back(std::move(state));
+            }
+        }
+        for (const State& state : dangling) {
+            const int64_t end = toEpochSecs(state.EndTime);
+            updateRtreeEnd(conn, state.id, end < 0 ? toEpochSecs(state.StartTime) : end);
+        }
+    });
 }
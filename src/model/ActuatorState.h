@@ -1,10 +1,12 @@
 #ifndef ACTUATORSTATE_H
 #define ACTUATORSTATE_H
+#include <cstdint>
+#include <memory>
 #include <string>
-
-#include "sqlite_orm.h"
+#include <vector>
 
 //0表示关，1表示开
+//每行是一段状态不变的区间 [StartTime, EndTime]（游程编码）
 struct State {
     int id=0;
     int fan=0;//风扇
@@ -13,26 +15,38 @@ struct State {
     std::string StartTime;
     std::string EndTime;
 };
+/**
+ * @brief 执行器状态区间表 actuator_states
+ *
+ * 区间的起止时间（epoch 秒）另外存放在 R*Tree 虚表 actuator_states_rtree 中，
+ * "A 到 B 之间有哪些状态" 这类重叠查询走 R*Tree 索引，不再全表扫描。
+ * 所有读写经由 ConnectionManager（写入在写线程上排队执行）。
+ */
 class ActuatorState {
 public:
     explicit ActuatorState(const std::string& dbPath);
-    //增加
+    //增加（完整的区间）
     bool insertState(const State& state);
-    //查询
+    //查询：返回与 [startTime, endTime] 有重叠的区间，按开始时间排序
     std::vector<State> QueryInRange(const std::string& startTime,const std::string& endTime);
-    //删除
+    //删除：删除与 [startTime, endTime] 有重叠的区间
     bool deleteInRange(const std::string& startTime,const std::string& endTime);
+
+    // ========== 进行中的区间（由 ActuatorTimeline 维护） ==========
+    //开始新区间（EndTime 暂等于 StartTime，R*Tree 中的结束时间记为无穷大）
+    void beginInterval(const State& state);
+    //把进行中区间的 EndTime 推进到 endTime（只更新普通表，异常退出时最多丢失一个推进周期）
+    void extendInterval(const std::string& endTime);
+    //结束进行中的区间
+    void endInterval(const std::string& endTime);
+    //把上次运行遗留的未结束区间在其最后 EndTime 处结束（启动时调用）
+    void closeDanglingIntervals();
+
+    //R*Tree 中进行中区间的结束时间
+    static const int32_t OPEN_END = 2147483647;
+
 private:
-    using StorageType=decltype(sqlite_orm::make_storage(
-        "",
-        sqlite_orm::make_table("actuator_states",
-            sqlite_orm::make_column("id",&State::id,sqlite_orm::primary_key().autoincrement()),
-            sqlite_orm::make_column("fan",&State::fan),
-            sqlite_orm::make_column("water_pump",&State::water_pump),
-            sqlite_orm::make_column("light_bulb",&State::light_bulb),
-            sqlite_orm::make_column("StartTime",&State::StartTime),
-            sqlite_orm::make_column("EndTime",&State::EndTime)
-            )));
-    StorageType storage;
+    //进行中区间的行 id，只在写线程的任务中读写
+    std::shared_ptr<int64_t> m_openId;
 };
 #endif // ACTUATORSTATE_H
@@ -0,0 +1,72 @@
+#include "ActuatorTimeline.h"
+
+#include <QDateTime>
+
+namespace {
+
+std::string formatTime(int64_t secs) {
+    return QDateTime::fromSecsSinceEpoch(secs).toString("yyyy-MM-dd hh:mm:ss").toStdString();
+}
+
+} // namespace
+
+ActuatorTimeline& ActuatorTimeline::instance() {
+    static ActuatorTimeline timeline;
+    return timeline;
+}
+
+ActuatorTimeline::ActuatorTimeline()
+    : m_store("green-house.db") {
+    // 上次运行未正常结束的区间（崩溃、断电）在其最后记录的时间处结束
+    m_store.closeDanglingIntervals();
+}
+
+void ActuatorTimeline::onState(const ActuatorStateData& data, int64_t nowSecs) {
+    if (!m_hasOpen) {
+        begin(data, nowSecs);
+        return;
+    }
+
+    // 中断过久：不把断线期间算进上一个状态
+    if (nowSecs - m_lastSeenSecs > STALE_SECS) {
+        close();
+        begin(data, nowSecs);
+        return;
+    }
+
+    if (data.fanStatus != m_fan || data.pumpStatus != m_pump || data.lampStatus != m_lamp) {
+        m_store.endInterval(formatTime(nowSecs));
+        m_hasOpen = false;
+        begin(data, nowSecs);
+        return;
+    }
+
+    m_lastSeenSecs = nowSecs;
+    if (nowSecs - m_lastExtendSecs >= EXTEND_INTERVAL_SECS) {
+        m_store.extendInterval(formatTime(nowSecs));
+        m_lastExtendSecs = nowSecs;
+    }
+}
+
+void ActuatorTimeline::close() {
+    if (!m_hasOpen) return;
+    m_store.endInterval(formatTime(m_lastSeenSecs));
+    m_hasOpen = false;
+}
+
+void ActuatorTimeline::begin(const ActuatorStateData& data, int64_t nowSecs) {
+    State state;
+    state.fan = data.fanStatus;
+    state.water_pump = data.pumpStatus;
+    state.light_bulb = data.lampStatus;
+    state.StartTime = formatTime(nowSecs);
+    state.EndTime = state.StartTime;
+    m_store.beginInterval(state);
+
+    m_hasOpen = true;
+    m_fan = data.fanStatus;
+    m_pump = data.pumpStatus;
+    m_lamp = data.lampStatus;
+    m_lastSeenSecs = nowSecs;
+    m_lastExtendSecs = nowSecs;
+}
@@ -0,0 +1,53 @@
+#ifndef ACTUATORTIMELINE_H
+#define ACTUATORTIMELINE_H
+
+#include <cstdint>
+
+#include "ActuatorState.h"
+#include "ActuatorStateData.h"
+
+/**
+ * @brief 执行器状态时间线：把 CMD_MOTOR_STATE 状态帧压缩成游程区间写入 actuator_states
+ *
+ * - 风扇/水泵/灯光组合不变时只推进当前区间的结束时间（每 EXTEND_INTERVAL_SECS 写一次）
+ * - 组合变化时结束当前区间并开始新区间
+ * - 超过 STALE_SECS 没有收到状态帧（断线）时，当前区间在最后一次收到帧的时间结束
+ *
+ * 只在 UI 线程调用。
+ */
+class ActuatorTimeline
+{
+public:
+    static ActuatorTimeline& instance();
+
+    /**
+     * @brief 处理一帧执行器状态
+     * @param nowSecs 收到该帧的时间（epoch 秒）
+     */
+    void onState(const ActuatorStateData& data, int64_t nowSecs);
+
+    /**
+     * @brief 在最后一次收到帧的时间结束当前区间（断开连接、退出时调用）
+     */
+    void close();
+
+    ActuatorState& store() { return m_store; }
+
+private:
+    ActuatorTimeline();
+
+    void begin(const ActuatorStateData& data, int64_t nowSecs);
+
+    static const int EXTEND_INTERVAL_SECS = 30;   // 区间结束时间的推进周期
+    static const int STALE_SECS = 120;            // 超过该时间无状态帧视为中断
+
+    ActuatorState m_store;
+    bool m_hasOpen = false;
+    uint8_t m_fan = 0;
+    uint8_t m_pump = 0;
+    uint8_t m_lamp = 0;
+    int64_t m_lastSeenSecs = 0;
+    int64_t m_lastExtendSecs = 0;
+};
+
+#endif // ACTUATORTIMELINE_H
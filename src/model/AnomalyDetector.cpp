@@ -0,0 +1,173 @@
+#include "AnomalyDetector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// 随机逼近的步长系数：每个样本让中位数 / MAD 估计向样本方向移动 ETA 个尺度
+constexpr double ETA = 0.05;
+
+// 正态分布下 MAD 与标准差的换算系数
+constexpr double MAD_TO_SIGMA = 1.4826;
+
+AnomalyDetector::ChannelLimits makeLimits(int rangeMin, int rangeMax, double maxRatePerSec, double minSigma) {
+    AnomalyDetector::ChannelLimits limits;
+    limits.rangeMin = rangeMin;
+    limits.rangeMax = rangeMax;
+    limits.maxRatePerSec = maxRatePerSec;
+    limits.minSigma = minSigma;
+    return limits;
+}
+
+} // namespace
+
+AnomalyDetector::AnomalyDetector()
+    : m_zLimit(4.0)
+    , m_madLimit(5.0)
+    , m_stuckSamples(120) {
+    // 量程与 SensorViewModel 的有效范围一致；速率按大棚环境的物理变化上限估计
+    m_limits[CHANNEL_AIR_TEMP] = makeLimits(-20, 60, 0.5, 0.5);
+    m_limits[CHANNEL_AIR_HUMID] = makeLimits(0, 100, 2.0, 1.0);
+    m_limits[CHANNEL_SOIL_HUMID] = makeLimits(0, 100, 1.0, 1.0);
+    m_limits[CHANNEL_LIGHT] = makeLimits(0, 100, 10.0, 2.0);
+}
+
+int AnomalyDetector::channelValue(const SensorSample& sample, SensorChannel channel) {
+    switch (channel) {
+    case CHANNEL_AIR_TEMP: return sample.airTemp;
+    case CHANNEL_AIR_HUMID: return sample.airHumid;
+    case CHANNEL_SOIL_HUMID: return sample.soilHumid;
+    case CHANNEL_LIGHT: return sample.lightIntensity;
+    default: return 0;
+    }
+}
+
+void AnomalyDetector::reset() {
+    m_zones.clear();
+}
+
+int AnomalyDetector::process(const SensorSample& sample, AnomalyEvent* out) {
+    const int zone = sample.deviceId;
+    const int64_t nowMs = sample.tsMs;
+    if (zone < 0) return 0;
+    if (zone >= static_cast<int>(m_zones.size())) {
+        m_zones.resize(zone + 1);
+    }
+
+    ZoneState& state = m_zones[zone];
+    int events = 0;
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        const SensorChannel channel = static_cast<SensorChannel>(c);
+        const int value = channelValue(sample, channel);
+        const int n = inspect(state.channels[c], m_limits[c], value, nowMs, out + events);
+        for (int i = 0; i < n; ++i) {
+            out[events + i].tsMs = nowMs;
+            out[events + i].zone = zone;
+            out[events + i].channel = channel;
+            out[events + i].value = value;
+        }
+        events += n;
+    }
+    return events;
+}
+
+// ========================================
+// 单通道检测
+// ========================================
+
+int AnomalyDetector::inspect(ChannelState& s, const ChannelLimits& limits, int value, int64_t nowMs,
+                             AnomalyEvent* out) const {
+    // 超量程的读数不进入统计，避免污染窗口
+    if (value < limits.rangeMin || value > limits.rangeMax) {
+        out[0].kind = ANOMALY_OUT_OF_RANGE;
+        out[0].score = 0;
+        return 1;
+    }
+
+    int events = 0;
+
+    // 1. 变化速率
+    if (s.hasPrev && limits.maxRatePerSec > 0 && nowMs > s.prevMs) {
+        const double rate = std::abs(value - s.prev) * 1000.0 / static_cast<double>(nowMs - s.prevMs);
+        if (rate > limits.maxRatePerSec) {
+            out[events].kind = ANOMALY_RATE;
+            out[events].score = rate;
+            ++events;
+        }
+    }
+
+    // 2. 突刺：z 分数和 MAD 分数同时超限（同一跳变已按速率报告过的不重复报告；
+    //    报告后冷却 WARMUP 个样本，电平整体跳变（如补光灯开启）只报告一次）
+    if (s.spikeCooldown > 0) {
+        --s.spikeCooldown;
+    } else if (s.count >= WARMUP && events == 0) {
+        const double mean = static_cast<double>(s.sum) / s.count;
+        const double variance = static_cast<double>(s.sumSq) / s.count - mean * mean;
+        const double sigma = std::max(std::sqrt(std::max(variance, 0.0)), limits.minSigma);
+        const double z = std::abs(value - mean) / sigma;
+        const double robust = std::abs(value - s.median) / std::max(MAD_TO_SIGMA * s.mad, limits.minSigma);
+        if (z >= m_zLimit && robust >= m_madLimit) {
+            out[events].kind = ANOMALY_SPIKE;
+            out[events].score = z;
+            ++events;
+            s.spikeCooldown = WARMUP;
+        }
+    }
+
+    // 3. 卡死（量程端点的持续读数是正常的，如夜间光照为 0、饱和湿度 100）
+    const int same = (s.hasPrev && value == s.prev) ? s.sameCount + 1 : 0;
+    if (same + 1 >= m_stuckSamples && !s.stuckReported
+        && value != limits.rangeMin && value != limits.rangeMax) {
+        out[events].kind = ANOMALY_STUCK;
+        out[events].score = same + 1;
+        ++events;
+    }
+
+    update(s, limits, value, nowMs);
+    return events;
+}
+
+void AnomalyDetector::update(ChannelState& s, const ChannelLimits& limits, int value, int64_t nowMs) const {
+    // 卡死计数
+    if (s.hasPrev && value == s.prev) {
+        ++s.sameCount;
+        if (s.sameCount + 1 >= m_stuckSamples) s.stuckReported = true;
+    } else {
+        s.sameCount = 0;
+        s.stuckReported = false;
+    }
+    s.prev = value;
+    s.prevMs = nowMs;
+    s.hasPrev = true;
+
+    // 环形窗口：移出最旧的样本，加入新样本
+    if (s.count == WINDOW) {
+        const int64_t old = s.ring[s.head];
+        s.sum -= old;
+        s.sumSq -= old * old;
+    } else {
+        ++s.count;
+    }
+    s.ring[s.head] = value;
+    s.sum += value;
+    s.sumSq += static_cast<int64_t>(value) * value;
+    s.head = (s.head + 1) % WINDOW;
+
+    // 中位数 / MAD：预热结束时用均值和标准差初始化，之后随机逼近
+    if (s.count == WARMUP) {
+        const double mean = static_cast<double>(s.sum) / s.count;
+        const double variance = static_cast<double>(s.sumSq) / s.count - mean * mean;
+        s.median = mean;
+        s.mad = std::sqrt(std::max(variance, 0.0)) / MAD_TO_SIGMA;
+    } else if (s.count > WARMUP) {
+        const double step = ETA * std::max(MAD_TO_SIGMA * s.mad, limits.minSigma);
+        if (value > s.median) s.median += step;
+        else if (value < s.median) s.median -= step;
+
+        const double deviation = std::abs(value - s.median);
+        if (deviation > s.mad) s.mad += step / 2;
+        else if (deviation < s.mad) s.mad = std::max(s.mad - step / 2, 0.0);
+    }
+}
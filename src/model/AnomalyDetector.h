@@ -0,0 +1,118 @@
+#ifndef ANOMALYDETECTOR_H
+#define ANOMALYDETECTOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include "SensorData.h"
+
+/**
+ * @brief 异常类型
+ */
+enum AnomalyKind : uint8_t {
+    ANOMALY_OUT_OF_RANGE = 0,   // 超出传感器量程
+    ANOMALY_SPIKE = 1,          // 偏离近期分布（z 分数 / MAD 分数）
+    ANOMALY_RATE = 2,           // 变化速率超限
+    ANOMALY_STUCK = 3           // 长时间读数不变（传感器疑似卡死）
+};
+
+/**
+ * @brief 一条异常事件（anomaly_events 表的一行）
+ */
+struct AnomalyEvent {
+    int64_t tsMs = 0;
+    int zone = 0;
+    SensorChannel channel = CHANNEL_AIR_TEMP;
+    AnomalyKind kind = ANOMALY_SPIKE;
+    double value = 0;
+    double score = 0;           // SPIKE: z 分数；RATE: 单位/秒；STUCK: 连续样本数；OUT_OF_RANGE: 0
+};
+
+/**
+ * @brief 流式传感器异常检测（每个区域每个通道独立统计）
+ *
+ * 每个样本的计算量是常数，与窗口长度和区域数无关：
+ * - z 分数：定长环形窗口内的累加和 / 平方和，增量更新均值和方差
+ * - MAD 分数：中位数和中位绝对偏差用随机逼近增量估计（不排序），对突刺不敏感；
+ *   z 分数和 MAD 分数同时超限才判定为突刺，避免窗口内已有离群点时误报/漏报
+ * - 变化速率：与上一个样本的差值除以时间间隔
+ * - 卡死：连续 N 个样本完全相同（量程端点除外，如夜间光照为 0）
+ *
+ * 状态全部是定长数组，只有出现新区域时才分配内存。只在 UI 线程调用。
+ */
+class AnomalyDetector
+{
+public:
+    static constexpr int WINDOW = 64;               // z 分数窗口（样本数）
+    static constexpr int WARMUP = 16;               // 统计量稳定前不判定突刺
+    static constexpr int MAX_EVENTS_PER_SAMPLE = CHANNEL_COUNT * 2;
+
+    /**
+     * @brief 通道参数
+     */
+    struct ChannelLimits {
+        int rangeMin = 0;
+        int rangeMax = 0;
+        double maxRatePerSec = 0;   // 0 表示不检查
+        double minSigma = 1.0;      // 标准差 / MAD 下限（量化步长），避免平稳信号被判为突刺
+    };
+
+    AnomalyDetector();
+
+    void setLimits(SensorChannel channel, const ChannelLimits& limits) { m_limits[channel] = limits; }
+    const ChannelLimits& limits(SensorChannel channel) const { return m_limits[channel]; }
+
+    void setZLimit(double z) { m_zLimit = z; }
+    void setMadLimit(double score) { m_madLimit = score; }
+    void setStuckSamples(int samples) { m_stuckSamples = samples < 2 ? 2 : samples; }
+
+    /**
+     * @brief 处理一个样本（时间取 tsMs，区域取 deviceId）
+     * @param out 输出缓冲区，至少 MAX_EVENTS_PER_SAMPLE 个元素
+     * @return 产生的异常事件数
+     */
+    int process(const SensorSample& sample, AnomalyEvent* out);
+
+    /**
+     * @brief 清空所有区域的统计（重新连接时调用）
+     */
+    void reset();
+
+    static int channelValue(const SensorSample& sample, SensorChannel channel);
+
+private:
+    struct ChannelState {
+        int ring[WINDOW];
+        int head = 0;
+        int count = 0;
+        int64_t sum = 0;
+        int64_t sumSq = 0;
+
+        double median = 0;          // 随机逼近的中位数
+        double mad = 0;             // 随机逼近的中位绝对偏差
+        int spikeCooldown = 0;
+
+        int prev = 0;
+        int64_t prevMs = 0;
+        bool hasPrev = false;
+
+        int sameCount = 0;
+        bool stuckReported = false;
+    };
+
+    struct ZoneState {
+        ChannelState channels[CHANNEL_COUNT];
+    };
+
+    int inspect(ChannelState& s, const ChannelLimits& limits, int value, int64_t nowMs,
+                AnomalyEvent* out) const;
+    void update(ChannelState& s, const ChannelLimits& limits, int value, int64_t nowMs) const;
+
+    std::vector<ZoneState> m_zones;
+    ChannelLimits m_limits[CHANNEL_COUNT];
+    double m_zLimit;
+    double m_madLimit;
+    int m_stuckSamples;
+};
+
+#endif // ANOMALYDETECTOR_H
@@ -0,0 +1,80 @@
+#include "AnomalyEventStore.h"
+
+#include <iostream>
+
+#include "Database/ConnectionManager.h"
+#include "Database/SchemaMigrations.h"
+
+namespace {
+
+const char* const kInsertSql =
+    "INSERT INTO anomaly_events(ts_ms, zone, channel, kind, value, score) VALUES(?1, ?2, ?3, ?4, ?5, ?6)";
+
+const char* const kSelectRangeSql =
+    "SELECT ts_ms, zone, channel, kind, value, score FROM anomaly_events"
+    " WHERE ts_ms BETWEEN ?1 AND ?2 AND (?3 < 0 OR zone = ?3) ORDER BY ts_ms";
+
+const char* const kDeleteBeforeSql =
+    "DELETE FROM anomaly_events WHERE ts_ms < ?1";
+
+} // namespace
+
+AnomalyEventStore& AnomalyEventStore::instance() {
+    static AnomalyEventStore store;
+    return store;
+}
+
+AnomalyEventStore::AnomalyEventStore() {
+    // anomaly_events 表由 SchemaMigrations 维护
+    SchemaMigrations::ensureLatest();
+}
+
+void AnomalyEventStore::insert(const AnomalyEvent& event) {
+    ConnectionManager::instance().post([event](SqliteConnection& conn) {
+        SqliteStatement* stmt = conn.prepare(kInsertSql);
+        if (!stmt) return;
+        SqliteStatementScope scope(*stmt);
+        stmt->bind(1, static_cast<int64_t>(event.tsMs));
+        stmt->bind(2, event.zone);
+        stmt->bind(3, static_cast<int>(event.channel));
+        stmt->bind(4, static_cast<int>(event.kind));
+        stmt->bind(5, event.value);
+        stmt->bind(6, event.score);
+        if (stmt->step() != SQLITE_DONE) {
+            std::cerr << "异常事件写入失败: " << conn.lastError() << std::endl;
+        }
+    });
+}
+
+std::vector<AnomalyEvent> AnomalyEventStore::queryRange(int64_t fromMs, int64_t toMs, int zone) {
+    std::vector<AnomalyEvent> events;
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kSelectRangeSql) : nullptr;
+    if (!stmt) return events;
+
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, static_cast<int64_t>(fromMs));
+    stmt->bind(2, static_cast<int64_t>(toMs));
+    stmt->bind(3, zone);
+    while (stmt->step() == SQLITE_ROW) {
+        AnomalyEvent event;
+        event.tsMs = stmt->columnInt64(0);
+        event.zone = stmt->columnInt(1);
+        event.channel = static_cast<SensorChannel>(stmt->columnInt(2));
+        event.kind = static_cast<AnomalyKind>(stmt->columnInt(3));
+        event.value = stmt->columnDouble(4);
+        event.score = stmt->columnDouble(5);
+        events.push_back(event);
+    }
+    return events;
+}
+
+void AnomalyEventStore::deleteBefore(int64_t toMs) {
+    ConnectionManager::instance().post([toMs](SqliteConnection& conn) {
+        SqliteStatement* stmt = conn.prepare(kDeleteBeforeSql);
+        if (!stmt) return;
+        SqliteStatementScope scope(*stmt);
+        stmt->bind(1, static_cast<int64_t>(toMs));
+        stmt->step();
+    });
+}
@@ -0,0 +1,40 @@
+#ifndef ANOMALYEVENTSTORE_H
+#define ANOMALYEVENTSTORE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "AnomalyDetector.h"
+
+/**
+ * @brief 传感器异常事件表 anomaly_events
+ *
+ * 写入经由 ConnectionManager 写线程排队执行（不阻塞 UI 线程），
+ * 按时间范围查询走 ts_ms 索引。
+ */
+class AnomalyEventStore
+{
+public:
+    static AnomalyEventStore& instance();
+
+    /**
+     * @brief 追加一条事件（异步）
+     */
+    void insert(const AnomalyEvent& event);
+
+    /**
+     * @brief 查询 [fromMs, toMs] 内的事件，按时间排序
+     * @param zone 区域，-1 表示全部
+     */
+    std::vector<AnomalyEvent> queryRange(int64_t fromMs, int64_t toMs, int zone = -1);
+
+    /**
+     * @brief 删除 toMs 之前的事件（异步）
+     */
+    void deleteBefore(int64_t toMs);
+
+private:
+    AnomalyEventStore();
+};
+
+#endif // ANOMALYEVENTSTORE_H
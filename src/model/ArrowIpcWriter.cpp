@@ -0,0 +1,425 @@
+#include "ArrowIpcWriter.h"
+
+#include <cstring>
+
+#include "Database/Database.h"
+
+// ========================================
+// FlatBuffers 编码（只实现 Arrow 元数据用到的部分）
+// ========================================
+
+namespace {
+
+/**
+ * @brief 从后往前构建的 FlatBuffer（与官方 FlatBufferBuilder 的布局一致）
+ *
+ * 子对象（字符串、向量、子表）先写，父表引用它们返回的位置。
+ * 位置以"距缓冲区末尾的字节数"表示，最终缓冲区按最大对齐补齐，
+ * 因此相对末尾对齐等价于相对开头对齐。
+ */
+class FlatBufferBuilder
+{
+public:
+    using Offset = uint32_t;
+
+    std::size_t size() const { return m_rev.size(); }
+
+    // 填充到写入 additional 字节后按 align 对齐
+    void prep(std::size_t align, std::size_t additional) {
+        if (align > m_minAlign) m_minAlign = align;
+        const std::size_t pad = (~(size() + additional) + 1) & (align - 1);
+        m_rev.insert(m_rev.end(), pad, 0);
+    }
+
+    // 按最终顺序 bytes[0..n) 放在当前内容之前
+    void pushBytes(const uint8_t* bytes, std::size_t n) {
+        for (std::size_t i = n; i > 0; --i) m_rev.push_back(bytes[i - 1]);
+    }
+
+    template <typename T>
+    void pushScalar(T value) {
+        uint8_t bytes[sizeof(T)];
+        const uint64_t v = static_cast<uint64_t>(value);   // 只用于整数类型，按小端拆字节
+        for (std::size_t i = 0; i < sizeof(T); ++i) bytes[i] = static_cast<uint8_t>(v >> (8 * i));
+        prep(sizeof(T), 0);
+        pushBytes(bytes, sizeof(T));
+    }
+
+    void pushOffset(Offset target) {
+        prep(4, 0);
+        pushScalar<uint32_t>(static_cast<uint32_t>(size() + 4 - target));
+    }
+
+    Offset createString(const char* text) {
+        const std::size_t n = std::strlen(text);
+        prep(4, n + 1);
+        m_rev.push_back(0);
+        pushBytes(reinterpret_cast<const uint8_t*>(text), n);
+        pushScalar<uint32_t>(static_cast<uint32_t>(n));
+        return static_cast<Offset>(size());
+    }
+
+    Offset createOffsetVector(const std::vector<Offset>& items) {
+        prep(4, items.size() * 4);
+        for (std::size_t i = items.size(); i > 0; --i) pushOffset(items[i - 1]);
+        pushScalar<uint32_t>(static_cast<uint32_t>(items.size()));
+        return static_cast<Offset>(size());
+    }
+
+    // 结构体向量：structs 为按最终顺序排好的 count 个 structSize 字节
+    Offset createStructVector(const uint8_t* structs, std::size_t count, std::size_t structSize, std::size_t align) {
+        prep(4, count * structSize);
+        prep(align, count * structSize);
+        pushBytes(structs, count * structSize);
+        pushScalar<uint32_t>(static_cast<uint32_t>(count));
+        return static_cast<Offset>(size());
+    }
+
+    // ---------- 表 ----------
+    void startTable() {
+        m_fields.clear();
+        m_tableStart = size();
+    }
+
+    template <typename T>
+    void addScalar(int id, T value) {
+        pushScalar<T>(value);
+        m_fields.push_back({id, static_cast<Offset>(size())});
+    }
+
+    void addOffset(int id, Offset target) {
+        pushOffset(target);
+        m_fields.push_back({id, static_cast<Offset>(size())});
+    }
+
+    Offset endTable() {
+        pushScalar<int32_t>(0);  // vtable 偏移，稍后回填
+        const Offset object = static_cast<Offset>(size());
+
+        int fieldCount = 0;
+        for (const FieldLoc& f : m_fields) {
+            if (f.id + 1 > fieldCount) fieldCount = f.id + 1;
+        }
+        std::vector<uint16_t> slots(static_cast<std::size_t>(fieldCount), 0);
+        for (const FieldLoc& f : m_fields) {
+            slots[static_cast<std::size_t>(f.id)] = static_cast<uint16_t>(object - f.pos);
+        }
+
+        for (std::size_t i = slots.size(); i > 0; --i) pushScalar<uint16_t>(slots[i - 1]);
+        pushScalar<uint16_t>(static_cast<uint16_t>(object - m_tableStart));
+        pushScalar<uint16_t>(static_cast<uint16_t>((2 + fieldCount) * 2));
+        const Offset vtable = static_cast<Offset>(size());
+
+        // vtable 在表之前：vtable 地址 = 表地址 - soffset
+        patchInt32(object, static_cast<int32_t>(vtable - object));
+        return object;
+    }
+
+    /**
+     * @brief 写入根表偏移，返回按正序排列的缓冲区
+     */
+    std::vector<uint8_t> finish(Offset root) {
+        prep(m_minAlign, 4);
+        pushOffset(root);
+        return std::vector<uint8_t>(m_rev.rbegin(), m_rev.rend());
+    }
+
+private:
+    struct FieldLoc {
+        int id;
+        Offset pos;
+    };
+
+    void patchInt32(Offset pos, int32_t value) {
+        const uint32_t v = static_cast<uint32_t>(value);
+        for (std::size_t k = 0; k < 4; ++k) {
+            m_rev[pos - 1 - k] = static_cast<uint8_t>(v >> (8 * k));
+        }
+    }
+
+    std::vector<uint8_t> m_rev;     // 逆序存放
+    std::vector<FieldLoc> m_fields;
+    std::size_t m_tableStart = 0;
+    std::size_t m_minAlign = 1;
+};
+
+// ========================================
+// Arrow 元数据（format/Schema.fbs、Message.fbs、File.fbs）
+// ========================================
+
+const int16_t kMetadataV5 = 4;
+const uint8_t kHeaderSchema = 1;
+const uint8_t kHeaderRecordBatch = 3;
+const uint8_t kTypeInt = 2;
+const uint8_t kTypeTimestamp = 10;
+const int16_t kTimeUnitMillisecond = 1;
+
+const char kMagic[8] = {'A', 'R', 'R', 'O', 'W', '1', 0, 0};
+const uint32_t kContinuation = 0xFFFFFFFFu;
+
+struct ColumnDesc {
+    const char* name;
+    uint8_t type;
+    int bitWidth;       // Int 类型的位宽；Timestamp 为 64
+};
+
+const ColumnDesc kColumns[] = {
+    {"id", kTypeInt, 64},
+    {"record_time", kTypeTimestamp, 64},
+    {"air_temp", kTypeInt, 32},
+    {"air_humid", kTypeInt, 32},
+    {"soil_humid", kTypeInt, 32},
+    {"light_intensity", kTypeInt, 32},
+};
+const std::size_t kColumnCount = sizeof(kColumns) / sizeof(kColumns[0]);
+
+FlatBufferBuilder::Offset buildSchema(FlatBufferBuilder& fbb) {
+    std::vector<FlatBufferBuilder::Offset> fields;
+    for (const ColumnDesc& col : kColumns) {
+        const FlatBufferBuilder::Offset name = fbb.createString(col.name);
+        const FlatBufferBuilder::Offset children = fbb.createOffsetVector({});
+
+        fbb.startTable();
+        if (col.type == kTypeTimestamp) {
+            fbb.addScalar<int16_t>(0, kTimeUnitMillisecond);     // Timestamp.unit
+        } else {
+            fbb.addScalar<int32_t>(0, col.bitWidth);             // Int.bitWidth
+            fbb.addScalar<uint8_t>(1, 1);                        // Int.is_signed
+        }
+        const FlatBufferBuilder::Offset type = fbb.endTable();
+
+        fbb.startTable();
+        fbb.addOffset(0, name);                                  // Field.name
+        fbb.addOffset(3, type);                                  // Field.type
+        fbb.addOffset(5, children);                              // Field.children
+        fbb.addScalar<uint8_t>(1, 0);                            // Field.nullable
+        fbb.addScalar<uint8_t>(2, col.type);                     // Field.type_type
+        fields.push_back(fbb.endTable());
+    }
+    const FlatBufferBuilder::Offset fieldVector = fbb.createOffsetVector(fields);
+
+    fbb.startTable();
+    fbb.addOffset(1, fieldVector);                               // Schema.fields
+    fbb.addScalar<int16_t>(0, 0);                                // Schema.endianness = Little
+    return fbb.endTable();
+}
+
+std::vector<uint8_t> buildMessage(FlatBufferBuilder& fbb, uint8_t headerType,
+                                  FlatBufferBuilder::Offset header, int64_t bodyLength) {
+    fbb.startTable();
+    fbb.addScalar<int64_t>(3, bodyLength);                       // Message.bodyLength
+    fbb.addOffset(2, header);                                    // Message.header
+    fbb.addScalar<int16_t>(0, kMetadataV5);                      // Message.version
+    fbb.addScalar<uint8_t>(1, headerType);                       // Message.header_type
+    return fbb.finish(fbb.endTable());
+}
+
+void putLE64(uint8_t* p, int64_t value) {
+    const uint64_t v = static_cast<uint64_t>(value);
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+void putLE32(uint8_t* p, int32_t value) {
+    const uint32_t v = static_cast<uint32_t>(value);
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+uint64_t padded8(uint64_t n) { return (n + 7) & ~static_cast<uint64_t>(7); }
+
+// 1970-01-01 起的天数（proleptic Gregorian）
+int64_t daysFromCivil(int64_t y, int m, int d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const int64_t yoe = y - era * 400;
+    const int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+} // namespace
+
+// ========================================
+// ArrowIpcWriter
+// ========================================
+
+ArrowIpcWriter::ArrowIpcWriter(int rowsPerBatch)
+    : m_rowsPerBatch(rowsPerBatch > 0 ? rowsPerBatch : DEFAULT_ROWS_PER_BATCH) {
+}
+
+bool ArrowIpcWriter::parseRecordTime(const char* text, int length, int64_t& outMs) {
+    // yyyy-MM-dd hh:mm:ss
+    if (length < 19) return false;
+    int v[6];
+    const int starts[6] = {0, 5, 8, 11, 14, 17};
+    const int widths[6] = {4, 2, 2, 2, 2, 2};
+    for (int f = 0; f < 6; ++f) {
+        int n = 0;
+        for (int i = 0; i < widths[f]; ++i) {
+            const char c = text[starts[f] + i];
+            if (c < '0' || c > '9') return false;
+            n = n * 10 + (c - '0');
+        }
+        v[f] = n;
+    }
+    if (v[1] < 1 || v[1] > 12 || v[2] < 1 || v[2] > 31) return false;
+
+    const int64_t days = daysFromCivil(v[0], v[1], v[2]);
+    outMs = ((days * 24 + v[3]) * 60 + v[4]) * 60000LL + v[5] * 1000LL;
+    return true;
+}
+
+bool ArrowIpcWriter::open(const std::string& path) {
+    m_rows = 0;
+    m_blocks.clear();
+    m_open = m_out.open(path);
+    if (!m_open) return false;
+
+    const std::size_t capacity = static_cast<std::size_t>(m_rowsPerBatch);
+    m_id.reserve(capacity);
+    m_time.reserve(capacity);
+    m_airTemp.reserve(capacity);
+    m_airHumid.reserve(capacity);
+    m_soilHumid.reserve(capacity);
+    m_light.reserve(capacity);
+
+    m_out.write(kMagic, sizeof(kMagic));
+
+    FlatBufferBuilder fbb;
+    const FlatBufferBuilder::Offset schema = buildSchema(fbb);
+    writeMessage(buildMessage(fbb, kHeaderSchema, schema, 0));
+    return m_out.ok();
+}
+
+void ArrowIpcWriter::writeRow(const SensorRowView& row) {
+    int64_t ms = 0;
+    parseRecordTime(row.recordTime, row.recordTimeLength, ms);
+
+    m_id.push_back(row.id);
+    m_time.push_back(ms);
+    m_airTemp.push_back(row.airTemp);
+    m_airHumid.push_back(row.airHumid);
+    m_soilHumid.push_back(row.soilHumid);
+    m_light.push_back(row.lightIntensity);
+    ++m_rows;
+
+    if (m_id.size() >= static_cast<std::size_t>(m_rowsPerBatch)) {
+        flushBatch();
+    }
+}
+
+void ArrowIpcWriter::flushBatch() {
+    const int64_t length = static_cast<int64_t>(m_id.size());
+    if (length == 0) return;
+
+    struct Column {
+        const void* data;
+        uint64_t bytes;
+    };
+    const Column columns[kColumnCount] = {
+        {m_id.data(), m_id.size() * sizeof(int64_t)},
+        {m_time.data(), m_time.size() * sizeof(int64_t)},
+        {m_airTemp.data(), m_airTemp.size() * sizeof(int32_t)},
+        {m_airHumid.data(), m_airHumid.size() * sizeof(int32_t)},
+        {m_soilHumid.data(), m_soilHumid.size() * sizeof(int32_t)},
+        {m_light.data(), m_light.size() * sizeof(int32_t)},
+    };
+
+    // 每列两个缓冲区：有效位图（无空值，长度 0）+ 数据（按 8 字节对齐）
+    uint8_t nodes[kColumnCount * 16];
+    uint8_t buffers[kColumnCount * 2 * 16];
+    uint64_t bodyLength = 0;
+    for (std::size_t i = 0; i < kColumnCount; ++i) {
+        putLE64(nodes + i * 16, length);
+        putLE64(nodes + i * 16 + 8, 0);
+
+        putLE64(buffers + i * 32, static_cast<int64_t>(bodyLength));
+        putLE64(buffers + i * 32 + 8, 0);
+        putLE64(buffers + i * 32 + 16, static_cast<int64_t>(bodyLength));
+        putLE64(buffers + i * 32 + 24, static_cast<int64_t>(columns[i].bytes));
+        bodyLength += padded8(columns[i].bytes);
+    }
+
+    FlatBufferBuilder fbb;
+    const FlatBufferBuilder::Offset buffersVec = fbb.createStructVector(buffers, kColumnCount * 2, 16, 8);
+    const FlatBufferBuilder::Offset nodesVec = fbb.createStructVector(nodes, kColumnCount, 16, 8);
+    fbb.startTable();
+    fbb.addScalar<int64_t>(0, length);                           // RecordBatch.length
+    fbb.addOffset(1, nodesVec);                                  // RecordBatch.nodes
+    fbb.addOffset(2, buffersVec);                                // RecordBatch.buffers
+    const FlatBufferBuilder::Offset batch = fbb.endTable();
+
+    Block block;
+    block.offset = static_cast<int64_t>(m_out.position());
+    block.metaDataLength = writeMessage(buildMessage(fbb, kHeaderRecordBatch, batch,
+                                                     static_cast<int64_t>(bodyLength)));
+    block.bodyLength = static_cast<int64_t>(bodyLength);
+    m_blocks.push_back(block);
+
+    for (const Column& col : columns) {
+        m_out.write(static_cast<const char*>(col.data), static_cast<std::size_t>(col.bytes));
+        writePadding(padded8(col.bytes) - col.bytes);
+    }
+
+    m_id.clear();
+    m_time.clear();
+    m_airTemp.clear();
+    m_airHumid.clear();
+    m_soilHumid.clear();
+    m_light.clear();
+}
+
+int32_t ArrowIpcWriter::writeMessage(const std::vector<uint8_t>& metadata) {
+    // 续行标记 + 长度共 8 字节，元数据补齐到 8 字节，保证消息体从 8 字节边界开始
+    const uint64_t metadataSize = padded8(metadata.size());
+    uint8_t prefix[8];
+    putLE32(prefix, static_cast<int32_t>(kContinuation));
+    putLE32(prefix + 4, static_cast<int32_t>(metadataSize));
+    m_out.write(reinterpret_cast<const char*>(prefix), sizeof(prefix));
+    m_out.write(reinterpret_cast<const char*>(metadata.data()), metadata.size());
+    writePadding(metadataSize - metadata.size());
+    return static_cast<int32_t>(8 + metadataSize);
+}
+
+void ArrowIpcWriter::writePadding(uint64_t length) {
+    static const char zeros[8] = {};
+    m_out.write(zeros, static_cast<std::size_t>(length));
+}
+
+bool ArrowIpcWriter::finish() {
+    if (!m_open) return false;
+    m_open = false;
+    flushBatch();
+
+    // 流结束标记
+    uint8_t eos[8];
+    putLE32(eos, static_cast<int32_t>(kContinuation));
+    putLE32(eos + 4, 0);
+    m_out.write(reinterpret_cast<const char*>(eos), sizeof(eos));
+
+    // Footer：Schema + 各行组位置（Block 结构体 24 字节：offset, metaDataLength, 填充, bodyLength）
+    std::vector<uint8_t> blocks(m_blocks.size() * 24, 0);
+    for (std::size_t i = 0; i < m_blocks.size(); ++i) {
+        putLE64(&blocks[i * 24], m_blocks[i].offset);
+        putLE32(&blocks[i * 24 + 8], m_blocks[i].metaDataLength);
+        putLE64(&blocks[i * 24 + 16], m_blocks[i].bodyLength);
+    }
+
+    FlatBufferBuilder fbb;
+    const FlatBufferBuilder::Offset batches = fbb.createStructVector(blocks.data(), m_blocks.size(), 24, 8);
+    const FlatBufferBuilder::Offset dictionaries = fbb.createStructVector(nullptr, 0, 24, 8);
+    const FlatBufferBuilder::Offset schema = buildSchema(fbb);
+    fbb.startTable();
+    fbb.addOffset(1, schema);                                    // Footer.schema
+    fbb.addOffset(2, dictionaries);                              // Footer.dictionaries
+    fbb.addOffset(3, batches);                                   // Footer.recordBatches
+    fbb.addScalar<int16_t>(0, kMetadataV5);                      // Footer.version
+    const std::vector<uint8_t> footer = fbb.finish(fbb.endTable());
+
+    m_out.write(reinterpret_cast<const char*>(footer.data()), footer.size());
+    uint8_t footerSize[4];
+    putLE32(footerSize, static_cast<int32_t>(footer.size()));
+    m_out.write(reinterpret_cast<const char*>(footerSize), sizeof(footerSize));
+    m_out.write(kMagic, 6);
+
+    return m_out.close();
+}
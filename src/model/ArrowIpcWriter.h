@@ -0,0 +1,82 @@
+#ifndef ARROWIPCWRITER_H
+#define ARROWIPCWRITER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "untils/BufferedFileWriter.h"
+
+struct SensorRowView;
+
+/**
+ * @brief green_data 的 Arrow IPC 文件（Feather v2）写入器
+ *
+ * 列式二进制格式，pandas / pyarrow / polars 等可直接读取：
+ *     pd.read_feather("x.arrow")  或  pyarrow.ipc.open_file("x.arrow").read_all()
+ *
+ * 列（均不可为空）：
+ * - id               int64
+ * - record_time      timestamp[ms]，无时区（按本地时间的墙上时钟存储，与 record_time 文本一致）
+ * - air_temp / air_humid / soil_humid / light_intensity   int32
+ *
+ * 每 rowsPerBatch 行组成一个 RecordBatch（行组）写出，内存只占一个行组的列缓冲区；
+ * 文件尾部的 Footer 记录各行组的位置，读取端可以按行组随机访问。
+ * 不压缩：Arrow 只定义了 LZ4_FRAME / ZSTD 两种压缩，项目未引入这两个库。
+ */
+class ArrowIpcWriter
+{
+public:
+    static constexpr int DEFAULT_ROWS_PER_BATCH = 65536;
+
+    explicit ArrowIpcWriter(int rowsPerBatch = DEFAULT_ROWS_PER_BATCH);
+
+    /**
+     * @brief 创建文件并写入文件头和 Schema
+     */
+    bool open(const std::string& path);
+
+    void writeRow(const SensorRowView& row);
+
+    /**
+     * @brief 写出剩余的行组和 Footer 并关闭文件
+     */
+    bool finish();
+
+    int64_t rows() const { return m_rows; }
+    uint64_t bytesWritten() const { return m_out.bytesWritten(); }
+
+    /**
+     * @brief "yyyy-MM-dd hh:mm:ss" 转为毫秒（按 UTC 计算，即保留墙上时钟），格式错误返回 false
+     */
+    static bool parseRecordTime(const char* text, int length, int64_t& outMs);
+
+private:
+    struct Block {
+        int64_t offset;
+        int32_t metaDataLength;
+        int64_t bodyLength;
+    };
+
+    void flushBatch();
+    // 写出一条封装消息（续行标记 + 长度 + 元数据 + 填充），返回元数据部分的总长度
+    int32_t writeMessage(const std::vector<uint8_t>& metadata);
+    void writePadding(uint64_t length);
+
+    BufferedFileWriter m_out;
+    int m_rowsPerBatch;
+    int64_t m_rows = 0;
+    bool m_open = false;
+
+    // 当前行组的列缓冲区（容量固定为 rowsPerBatch）
+    std::vector<int64_t> m_id;
+    std::vector<int64_t> m_time;
+    std::vector<int32_t> m_airTemp;
+    std::vector<int32_t> m_airHumid;
+    std::vector<int32_t> m_soilHumid;
+    std::vector<int32_t> m_light;
+
+    std::vector<Block> m_blocks;
+};
+
+#endif // ARROWIPCWRITER_H
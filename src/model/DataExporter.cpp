@@ -0,0 +1,176 @@
+#include "DataExporter.h"
+
+#include <chrono>
+#include <ctime>
+
+#include "ArrowIpcWriter.h"
+#include "Database/Database.h"
+#include "untils/Log.h"
+#include "untils/TimerUtil.h"
+
+namespace {
+
+const char kCsvHeader[] = "时间,温度(°C),空气湿度(%),土壤湿度(%),光照强度(Lux)\n";
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void appendRow(SensorExportWriter& writer, const SensorRowView& row) {
+    writer.writeRow(row.recordTime, row.recordTimeLength,
+                    row.airTemp, row.airHumid, row.soilHumid, row.lightIntensity);
+}
+
+void appendRow(ArrowIpcWriter& writer, const SensorRowView& row) {
+    writer.writeRow(row);
+}
+
+bool openWriter(SensorExportWriter& writer, const std::string& path, ExportFormat format) {
+    return writer.open(path, format);
+}
+
+bool openWriter(ArrowIpcWriter& writer, const std::string& path, ExportFormat) {
+    return writer.open(path);
+}
+
+// 游标逐行读出并写入 writer，进度 / 取消 / 结果处理对各格式相同
+template <typename Writer>
+DataExporter::Result scanInto(Writer& writer, const std::string& path, ExportFormat format,
+                              const std::string& startTime, const std::string& endTime,
+                              const DataExporter::ProgressFn& progress,
+                              const std::atomic<bool>* cancel) {
+    DataExporter::Result result;
+
+    // 总行数只用于显示进度，走 record_time 索引，失败时按未知处理
+    const int64_t total = progress ? Database::instance().countByTime(startTime, endTime) : -1;
+    if (progress) progress(0, total);
+
+    if (!openWriter(writer, path, format)) {
+        result.error = "无法创建导出文件: " + path;
+        return result;
+    }
+
+    const int64_t scanned = Database::instance().scanByTime(startTime, endTime,
+        [&](const SensorRowView& row) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) {
+                result.cancelled = true;
+                return false;
+            }
+            appendRow(writer, row);
+            if (progress && writer.rows() % DataExporter::PROGRESS_INTERVAL_ROWS == 0) {
+                progress(writer.rows(), total);
+            }
+            return true;
+        });
+
+    const bool written = writer.finish();
+    result.rows = writer.rows();
+    result.bytes = writer.bytesWritten();
+
+    if (scanned < 0) {
+        result.error = "数据库查询失败";
+    } else if (!written) {
+        result.error = "写入导出文件失败: " + path;
+    } else {
+        result.ok = !result.cancelled;
+        if (progress) progress(result.rows, total);
+    }
+    return result;
+}
+
+} // namespace
+
+// ========================================
+// SensorExportWriter
+// ========================================
+
+bool SensorExportWriter::open(const std::string& path, ExportFormat format) {
+    if (format == ExportFormat::Arrow) return false;
+    m_format = format;
+    m_rows = 0;
+    m_json.reset();
+    if (!m_out.open(path)) return false;
+
+    if (m_format == ExportFormat::Csv) {
+        m_out.write(kCsvHeader, sizeof(kCsvHeader) - 1);
+    } else {
+        m_json.beginObject();
+        m_json.key("data");
+        m_json.beginArray();
+    }
+    return m_out.ok();
+}
+
+void SensorExportWriter::writeRow(const char* recordTime, int recordTimeLength,
+                                  int airTemp, int airHumid, int soilHumid, int lightIntensity) {
+    const std::size_t timeLength = recordTimeLength > 0 ? static_cast<std::size_t>(recordTimeLength) : 0;
+    if (m_format == ExportFormat::Csv) {
+        m_out.write(recordTime, timeLength);
+        m_out.put(',');
+        m_out.writeInt(airTemp);
+        m_out.put(',');
+        m_out.writeInt(airHumid);
+        m_out.put(',');
+        m_out.writeInt(soilHumid);
+        m_out.put(',');
+        m_out.writeInt(lightIntensity);
+        m_out.put('\n');
+    } else {
+        m_json.newline();
+        m_json.beginObject();
+        m_json.key("time");
+        m_json.value(recordTime, timeLength);
+        m_json.key("temperature");
+        m_json.value(airTemp);
+        m_json.key("air_humidity");
+        m_json.value(airHumid);
+        m_json.key("soil_humidity");
+        m_json.value(soilHumid);
+        m_json.key("light_intensity");
+        m_json.value(lightIntensity);
+        m_json.endObject();
+    }
+    ++m_rows;
+}
+
+bool SensorExportWriter::finish() {
+    if (!m_out.isOpen()) return false;
+
+    if (m_format == ExportFormat::Json) {
+        char exportTime[TimerUtil::RECORD_TIME_SIZE];
+        const std::size_t exportTimeLength = TimerUtil::formatRecordTime(nowMs(), exportTime);
+
+        m_json.newline();
+        m_json.endArray();
+        m_json.key("count");
+        m_json.value(m_rows);
+        m_json.key("export_time");
+        m_json.value(exportTime, exportTimeLength);
+        m_json.endObject();
+        m_json.newline();
+    }
+    return m_out.close();
+}
+
+// ========================================
+// DataExporter
+// ========================================
+
+DataExporter::Result DataExporter::exportRange(const std::string& path, ExportFormat format,
+                                               const std::string& startTime, const std::string& endTime,
+                                               const ProgressFn& progress,
+                                               const std::atomic<bool>* cancel) {
+    Result result;
+    if (format == ExportFormat::Arrow) {
+        ArrowIpcWriter writer;
+        result = scanInto(writer, path, format, startTime, endTime, progress, cancel);
+    } else {
+        SensorExportWriter writer;
+        result = scanInto(writer, path, format, startTime, endTime, progress, cancel);
+    }
+
+    LOG_INFO("导出 {} 行到 {}（{} 字节）{}", result.rows, path, result.bytes,
+             result.cancelled ? "，已取消" : "");
+    return result;
+}
@@ -0,0 +1,91 @@
+#ifndef DATAEXPORTER_H
+#define DATAEXPORTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "untils/BufferedFileWriter.h"
+#include "untils/JsonStreamWriter.h"
+
+/**
+ * @brief 导出格式
+ */
+enum class ExportFormat {
+    Csv,
+    Json,
+    Arrow       // Arrow IPC 文件（Feather v2），见 ArrowIpcWriter
+};
+
+/**
+ * @brief 传感器数据导出文件（CSV / JSON），逐行流式写入
+ *
+ * 每行直接编码进 BufferedFileWriter 的定长缓冲区，不构造中间字符串或 JSON 文档，
+ * 内存占用只有写缓冲区，与导出行数无关。
+ * 文件格式与 ChartViewModel 原有的导出一致：
+ * - CSV：时间,温度(°C),空气湿度(%),土壤湿度(%),光照强度(Lux)
+ * - JSON：{"data":[{"time":..,"temperature":..,...}],"count":N,"export_time":".."}
+ */
+class SensorExportWriter
+{
+public:
+    SensorExportWriter() : m_json(m_out) {}
+
+    /**
+     * @brief 创建文件并写入表头（只支持 Csv / Json）
+     */
+    bool open(const std::string& path, ExportFormat format);
+
+    void writeRow(const char* recordTime, int recordTimeLength,
+                  int airTemp, int airHumid, int soilHumid, int lightIntensity);
+
+    /**
+     * @brief 写入结尾（JSON 的 count / export_time）并关闭文件
+     * @return 所有内容写入成功
+     */
+    bool finish();
+
+    int64_t rows() const { return m_rows; }
+    uint64_t bytesWritten() const { return m_out.bytesWritten(); }
+
+private:
+    BufferedFileWriter m_out;
+    JsonStreamWriter m_json;
+    ExportFormat m_format = ExportFormat::Csv;
+    int64_t m_rows = 0;
+};
+
+/**
+ * @brief 从数据库按时间范围导出
+ *
+ * 数据库游标逐行读取、逐行写文件（Arrow 格式按行组写出），千万行级别的导出也只占用几 MB 内存。
+ * 在调用线程上同步执行（由 ExportViewModel 放到后台线程）。
+ */
+class DataExporter
+{
+public:
+    struct Result {
+        bool ok = false;
+        bool cancelled = false;
+        int64_t rows = 0;
+        uint64_t bytes = 0;
+        std::string error;
+    };
+
+    /// 进度回调：已导出行数、总行数（未知时为 -1）
+    using ProgressFn = std::function<void(int64_t done, int64_t total)>;
+
+    static constexpr int64_t PROGRESS_INTERVAL_ROWS = 65536;
+
+    /**
+     * @param startTime / endTime "yyyy-MM-dd hh:mm:ss"，闭区间
+     * @param cancel 非空时每行检查一次，置为 true 后尽快结束（已写出的文件保留）
+     */
+    static Result exportRange(const std::string& path, ExportFormat format,
+                              const std::string& startTime, const std::string& endTime,
+                              const ProgressFn& progress = ProgressFn(),
+                              const std::atomic<bool>* cancel = nullptr);
+};
+
+#endif // DATAEXPORTER_H
@@ -0,0 +1,327 @@
+#include "DataImporter.h"
+
+#include <QFile>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Database/ConnectionManager.h"
+#include "Database/Database.h"
+#include "Database/HistoryTileCache.h"
+#include "Database/HotTierCache.h"
+#include "untils/Log.h"
+
+namespace {
+
+// 同一设备同一时刻已有数据时不插入。ts_ms 由 record_time（本地时间）换算，二者一一对应，
+// 判断走 record_time 索引；同一事务中先插入的行也可见
+const char* const kInsertUniqueSql =
+    "INSERT INTO green_data(record_time, air_temp, air_humid, soil_humid, light_intensity, ts_ms, device_id) "
+    "SELECT ?1, ?2, ?3, ?4, ?5, CAST(strftime('%s', ?1, 'utc') AS INTEGER) * 1000, ?6 "
+    "WHERE NOT EXISTS (SELECT 1 FROM green_data WHERE record_time = ?1 AND device_id = ?6)";
+
+const char* const kInsertSql =
+    "INSERT INTO green_data(record_time, air_temp, air_humid, soil_humid, light_intensity, ts_ms, device_id) "
+    "VALUES(?1, ?2, ?3, ?4, ?5, CAST(strftime('%s', ?1, 'utc') AS INTEGER) * 1000, ?6)";
+
+const int RECORD_TIME_LENGTH = 19;   // yyyy-MM-dd hh:mm:ss
+const int MAX_THREADS = 8;
+// 每个写任务最多写入的行数：一轮可达上百万行，拆成多个任务后采集写入可以插在其间，不必等整轮写完
+const std::size_t MAX_ROWS_PER_TASK = 20000;
+
+/**
+ * @brief 解析出的一行，time 指向映射内存中的 19 个字符
+ */
+struct ImportRow {
+    const char* time;
+    int32_t airTemp;
+    int32_t airHumid;
+    int32_t soilHumid;
+    int32_t lightIntensity;
+};
+
+struct Chunk {
+    const char* begin;
+    const char* end;
+    std::vector<ImportRow> rows;
+    int64_t malformed = 0;
+};
+
+struct InsertStats {
+    int64_t inserted = 0;
+    int64_t duplicates = 0;
+    bool ok = true;
+};
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// yyyy-MM-dd hh:mm:ss：只检查字符类别，不做日期换算（原样写入 record_time）
+bool isRecordTime(const char* p) {
+    for (int i = 0; i < RECORD_TIME_LENGTH; ++i) {
+        const char c = p[i];
+        switch (i) {
+        case 4: case 7: if (c != '-') return false; break;
+        case 10:        if (c != ' ') return false; break;
+        case 13: case 16: if (c != ':') return false; break;
+        default:        if (!isDigit(c)) return false; break;
+        }
+    }
+    return true;
+}
+
+bool parseInt(const char*& p, const char* end, int32_t& out) {
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        ++p;
+    }
+    const char* digits = p;
+    int64_t value = 0;
+    while (p < end && isDigit(*p)) {
+        value = value * 10 + (*p - '0');
+        if (value > static_cast<int64_t>(INT32_MAX) + 1) return false;
+        ++p;
+    }
+    if (p == digits) return false;
+    value = negative ? -value : value;
+    if (value > INT32_MAX) return false;
+    out = static_cast<int32_t>(value);
+    return true;
+}
+
+// 一行（不含换行符）：时间,温度,空气湿度,土壤湿度,光照强度
+bool parseLine(const char* p, const char* end, ImportRow& row) {
+    if (end - p < RECORD_TIME_LENGTH + 8 || !isRecordTime(p)) return false;
+    row.time = p;
+    p += RECORD_TIME_LENGTH;
+
+    int32_t* const fields[4] = {&row.airTemp, &row.airHumid, &row.soilHumid, &row.lightIntensity};
+    for (int32_t* field : fields) {
+        if (p >= end || *p != ',') return false;
+        ++p;
+        if (!parseInt(p, end, *field)) return false;
+    }
+    return p == end;
+}
+
+void parseChunk(Chunk& chunk) {
+    // 每行至少 28 字节，按 32 字节估算一次预留
+    chunk.rows.reserve(static_cast<std::size_t>(chunk.end - chunk.begin) / 32 + 1);
+
+    const char* line = chunk.begin;
+    while (line < chunk.end) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(chunk.end - line)));
+        const char* lineEnd = newline ? newline : chunk.end;
+        const char* contentEnd = (lineEnd > line && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+
+        if (contentEnd > line) {
+            ImportRow row;
+            if (parseLine(line, contentEnd, row)) {
+                chunk.rows.push_back(row);
+            } else {
+                ++chunk.malformed;
+            }
+        }
+        line = newline ? newline + 1 : chunk.end;
+    }
+}
+
+// 按行边界切块：每块约 chunkBytes，结尾延伸到下一个换行符之后
+std::vector<Chunk> splitChunks(const char* begin, const char* end, std::size_t chunkBytes) {
+    std::vector<Chunk> chunks;
+    const char* pos = begin;
+    while (pos < end) {
+        const char* cut = static_cast<std::size_t>(end - pos) > chunkBytes ? pos + chunkBytes : end;
+        if (cut < end) {
+            const char* newline = static_cast<const char*>(std::memchr(cut, '\n', static_cast<std::size_t>(end - cut)));
+            cut = newline ? newline + 1 : end;
+        }
+        Chunk chunk;
+        chunk.begin = pos;
+        chunk.end = cut;
+        chunks.push_back(std::move(chunk));
+        pos = cut;
+    }
+    return chunks;
+}
+
+InsertStats insertRows(SqliteConnection& conn, const ImportRow* rows, std::size_t count, bool skipDuplicates, int deviceId) {
+    InsertStats stats;
+    SqliteStatement* stmt = conn.prepare(skipDuplicates ? kInsertUniqueSql : kInsertSql);
+    if (!stmt) {
+        stats.ok = false;
+        return stats;
+    }
+
+    // 一段在保存点内写入：中途失败时撤销本段已写入的行，不随同组的其他写入一起提交
+    if (!conn.exec("SAVEPOINT import")) {
+        stats.ok = false;
+        return stats;
+    }
+    bool ok = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        const ImportRow& row = rows[i];
+        SqliteStatementScope scope(*stmt);
+        stmt->bind(1, row.time, RECORD_TIME_LENGTH);
+        stmt->bind(2, static_cast<int>(row.airTemp));
+        stmt->bind(3, static_cast<int>(row.airHumid));
+        stmt->bind(4, static_cast<int>(row.soilHumid));
+        stmt->bind(5, static_cast<int>(row.lightIntensity));
+        stmt->bind(6, deviceId);
+        if (stmt->step() != SQLITE_DONE) {
+            ok = false;
+            break;
+        }
+        if (conn.changes() > 0) ++stats.inserted;
+        else ++stats.duplicates;
+    }
+
+    if (!ok) {
+        LOG_ERROR("导入写入失败，回滚本段：{}", conn.lastError());
+        conn.exec("ROLLBACK TO import");
+        conn.exec("RELEASE import");
+        InsertStats failed;
+        failed.ok = false;
+        return failed;
+    }
+    conn.exec("RELEASE import");
+    return stats;
+}
+
+} // namespace
+
+DataImporter::Result DataImporter::importCsv(const std::string& path, const Options& options,
+                                             const ProgressFn& progress,
+                                             const std::atomic<bool>* cancel) {
+    Result result;
+
+    QFile file(QFile::decodeName(path.c_str()));
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.error = "无法打开导入文件: " + path;
+        return result;
+    }
+    const int64_t totalBytes = file.size();
+    if (totalBytes == 0) {
+        result.ok = true;
+        return result;
+    }
+    // 映射在所有写任务完成之前保持有效（写线程直接绑定映射内存中的时间字符串）
+    const uchar* mapped = file.map(0, totalBytes);
+    if (!mapped) {
+        result.error = "无法映射导入文件: " + path;
+        return result;
+    }
+
+    const char* begin = reinterpret_cast<const char*>(mapped);
+    const char* const end = begin + totalBytes;
+
+    // UTF-8 BOM 与表头（首行不以数字开头）
+    if (end - begin >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0) begin += 3;
+    if (begin < end && !isDigit(*begin)) {
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+        begin = newline ? newline + 1 : end;
+    }
+
+    int threads = options.threads;
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+        threads = threads < 1 ? 1 : (threads > MAX_THREADS ? MAX_THREADS : threads);
+    }
+    const std::size_t chunkBytes = options.chunkBytes > 0 ? options.chunkBytes : (4 << 20);
+
+    std::vector<Chunk> chunks = splitChunks(begin, end, chunkBytes);
+    Database::instance();   // 确保表结构已创建（写任务直接使用写连接）
+    if (progress) progress(begin - reinterpret_cast<const char*>(mapped), totalBytes);
+
+    // 每轮并行解析 threads 个块，按 MAX_ROWS_PER_TASK 行一段交给写线程（每段一个写任务）；
+    // 写入上一轮的同时解析下一轮，至多一轮在写线程排队
+    std::vector<std::future<InsertStats>> pending;
+    bool insertFailed = false;
+    // 某一段写入失败后，同一轮中排在其后的段不再写入（写任务按顺序在写线程上执行）
+    auto writeFailed = std::make_shared<bool>(false);
+    auto collect = [&]() {
+        for (std::future<InsertStats>& future : pending) {
+            try {
+                const InsertStats stats = future.get();
+                result.rowsInserted += stats.inserted;
+                result.duplicates += stats.duplicates;
+                if (!stats.ok) insertFailed = true;
+            } catch (const std::exception&) {
+                insertFailed = true;
+            }
+        }
+        pending.clear();
+    };
+
+    for (std::size_t first = 0; first < chunks.size() && !insertFailed; first += static_cast<std::size_t>(threads)) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) {
+            result.cancelled = true;
+            break;
+        }
+
+        const std::size_t last = std::min(chunks.size(), first + static_cast<std::size_t>(threads));
+        auto round = std::make_shared<std::vector<Chunk>>();
+        round->reserve(last - first);
+        for (std::size_t i = first; i < last; ++i) round->push_back(std::move(chunks[i]));
+
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < round->size(); ++i) {
+            workers.emplace_back(parseChunk, std::ref((*round)[i]));
+        }
+        parseChunk((*round)[0]);
+        for (std::thread& worker : workers) worker.join();
+
+        for (const Chunk& chunk : *round) {
+            result.rowsParsed += static_cast<int64_t>(chunk.rows.size());
+            result.malformed += chunk.malformed;
+        }
+        const int64_t doneBytes = round->back().end - reinterpret_cast<const char*>(mapped);
+
+        collect();
+        if (insertFailed) break;
+        const bool skipDuplicates = options.skipDuplicates;
+        const int deviceId = options.deviceId;
+        for (const Chunk& chunk : *round) {
+            for (std::size_t offset = 0; offset < chunk.rows.size(); offset += MAX_ROWS_PER_TASK) {
+                const ImportRow* rows = chunk.rows.data() + offset;
+                const std::size_t count = std::min(MAX_ROWS_PER_TASK, chunk.rows.size() - offset);
+                // round 随任务持有，保证行数据在写入前有效
+                pending.push_back(ConnectionManager::instance().submit(
+                    [round, rows, count, skipDuplicates, deviceId, writeFailed](SqliteConnection& conn) {
+                        if (*writeFailed) {
+                            InsertStats skipped;
+                            skipped.ok = false;
+                            return skipped;
+                        }
+                        InsertStats stats = insertRows(conn, rows, count, skipDuplicates, deviceId);
+                        if (!stats.ok) *writeFailed = true;
+                        return stats;
+                    }));
+            }
+        }
+
+        if (progress) progress(doneBytes, totalBytes);
+    }
+    collect();
+    file.unmap(const_cast<uchar*>(mapped));
+
+    // 导入的行不经过写线程的追加路径，可能落在热数据窗口或已缓存的瓦片内
+    if (result.rowsInserted > 0) {
+        HotTierCache::instance().reload();
+        HistoryTileCache::instance().clear();
+    }
+
+    if (insertFailed) {
+        result.error = "写入数据库失败";
+    } else {
+        result.ok = !result.cancelled;
+    }
+
+    LOG_INFO("导入 {}：解析 {} 行，写入 {} 行，重复 {} 行，格式错误 {} 行{}", path, result.rowsParsed,
+             result.rowsInserted, result.duplicates, result.malformed, result.cancelled ? "，已取消" : "");
+    return result;
+}
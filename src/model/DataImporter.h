@@ -0,0 +1,54 @@
+#ifndef DATAIMPORTER_H
+#define DATAIMPORTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @brief 历史数据批量导入（CSV → green_data）
+ *
+ * 文件格式与导出的 CSV 相同（表头可有可无，可带 UTF-8 BOM，\n 或 \r\n 换行）：
+ *     yyyy-MM-dd hh:mm:ss,温度,空气湿度,土壤湿度,光照强度
+ *
+ * - 文件整体内存映射，按行边界切成若干块，多个线程并行解析；
+ *   解析结果只记录指向映射内存的时间字符串指针和 4 个整数，不复制文本
+ * - 每一轮解析完的行作为一个写任务交给写线程（一个大事务 + 预编译语句），
+ *   写入与下一轮解析重叠进行，内存占用与文件大小无关
+ * - 去重：同一设备（device_id）同一时刻已存在的行跳过，文件内部的重复行同样只保留第一条；
+ *   判断在 INSERT 语句内完成（走 record_time 索引），对已有数据和本次导入一视同仁
+ *
+ * 在调用线程上同步执行（由 ImportViewModel 放到后台线程）。
+ */
+class DataImporter
+{
+public:
+    struct Options {
+        bool skipDuplicates = true;
+        int deviceId = 0;                       // CSV 中没有设备列，整个文件归属同一设备
+        int threads = 0;                        // 0 = 按 CPU 核数（至多 8）
+        std::size_t chunkBytes = 4 << 20;       // 每个解析块的大小
+    };
+
+    struct Result {
+        bool ok = false;
+        bool cancelled = false;
+        int64_t rowsParsed = 0;
+        int64_t rowsInserted = 0;
+        int64_t duplicates = 0;
+        int64_t malformed = 0;                  // 无法解析的行（不含表头和空行）
+        std::string error;
+    };
+
+    /// 进度回调：已处理字节数、文件总字节数
+    using ProgressFn = std::function<void(int64_t doneBytes, int64_t totalBytes)>;
+
+    static Result importCsv(const std::string& path, const Options& options,
+                            const ProgressFn& progress = ProgressFn(),
+                            const std::atomic<bool>* cancel = nullptr);
+
+    static Result importCsv(const std::string& path) { return importCsv(path, Options()); }
+};
+
+#endif // DATAIMPORTER_H
@@ -0,0 +1,189 @@
+#include "ConnectionManager.h"
+
+#include <exception>
+#include <iostream>
+
+#include "untils/Metrics.h"
+
+namespace {
+
+Histogram& writeBatchSize() {
+    static Histogram& h = Metrics::histogram("gh_db_write_batch_size", "Write tasks per committed transaction", "tasks");
+    return h;
+}
+
+} // namespace
+
+// ========================================
+// ReaderLease
+// ========================================
+
+ReaderLease::~ReaderLease() {
+    if (m_conn) m_owner->release(m_conn);
+}
+
+// ========================================
+// ConnectionManager
+// ========================================
+
+ConnectionManager& ConnectionManager::instance() {
+    static ConnectionManager manager("green-house.db");
+    return manager;
+}
+
+ConnectionManager::ConnectionManager(const std::string& path)
+    : m_path(path)
+    , m_writer(new SqliteConnection) {
+    // 写连接在当前线程打开（确保数据库文件存在、WAL 已启用），之后交给写线程独占
+    if (m_writer->open(m_path)) {
+        m_writer->exec("PRAGMA journal_mode=WAL");
+        // WAL 下 NORMAL 只在检查点时 fsync，掉电最多丢失最近一批已提交事务
+        m_writer->exec("PRAGMA synchronous=NORMAL");
+    }
+    m_writerThread = std::thread(&ConnectionManager::writerLoop, this);
+}
+
+ConnectionManager::~ConnectionManager() {
+    shutdown();
+}
+
+void ConnectionManager::post(WriteTask task) {
+    enqueue(std::move(task), DoneHandler());
+}
+
+void ConnectionManager::post(WriteTask task, DoneHandler done) {
+    enqueue(std::move(task), std::move(done));
+}
+
+void ConnectionManager::enqueue(WriteTask task, DoneHandler done) {
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (!m_stopping) {
+            m_queue.push_back(WriteEntry{std::move(task), std::move(done)});
+            PipelineMetrics::dbQueueDepth().set(static_cast<int64_t>(m_queue.size() + m_inFlight));
+            m_writeCv.notify_one();
+            return;
+        }
+    }
+    std::cerr << "数据库已关闭，写任务被丢弃" << std::endl;
+    if (done) done(false);
+}
+
+void ConnectionManager::flush() {
+    std::unique_lock<std::mutex> lock(m_writeMutex);
+    m_idleCv.wait(lock, [this]() { return m_queue.empty() && m_inFlight == 0; });
+}
+
+void ConnectionManager::writerLoop() {
+    std::deque<WriteEntry> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_writeMutex);
+            m_writeCv.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty()) break;   // m_stopping 且已写完
+
+            // 取出当前排队的任务（最多 MAX_BATCH 个）组成一个事务
+            const std::size_t n = m_queue.size() < MAX_BATCH ? m_queue.size() : MAX_BATCH;
+            for (std::size_t i = 0; i < n; ++i) {
+                batch.push_back(std::move(m_queue.front()));
+                m_queue.pop_front();
+            }
+            m_inFlight = n;
+        }
+
+        bool committed = true;
+        {
+            ScopedTimer timer(PipelineMetrics::dbCommitUs());
+            const bool inTransaction = m_writer->exec("BEGIN IMMEDIATE");
+            for (WriteEntry& entry : batch) {
+                // 每个任务在自己的保存点中执行：任务抛出异常时只撤销它自己的写入，
+                // 不影响同批其他任务，也不会把写了一半的结果随整批提交
+                const bool savepoint = inTransaction && m_writer->exec("SAVEPOINT write_task");
+                try {
+                    entry.task(*m_writer);
+                } catch (const std::exception& e) {
+                    entry.failed = true;
+                    std::cerr << "写任务执行失败: " << e.what() << std::endl;
+                } catch (...) {
+                    entry.failed = true;
+                    std::cerr << "写任务执行失败: 未知异常" << std::endl;
+                }
+                if (!savepoint) continue;
+                if (entry.failed) m_writer->exec("ROLLBACK TO write_task");
+                m_writer->exec("RELEASE write_task");
+            }
+            if (inTransaction && !m_writer->exec("COMMIT")) {
+                m_writer->exec("ROLLBACK");
+                PipelineMetrics::dbWriteFailures().inc();
+                committed = false;
+            }
+        }
+        // 事务结束后才通知等待结果的调用方，保证其随后的读取能看到这次写入；
+        // 被撤销的任务按未提交处理
+        for (WriteEntry& entry : batch) {
+            if (entry.done) entry.done(committed && !entry.failed);
+        }
+        writeBatchSize().record(batch.size());
+        batch.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            m_inFlight = 0;
+            PipelineMetrics::dbQueueDepth().set(static_cast<int64_t>(m_queue.size()));
+            if (m_queue.empty()) m_idleCv.notify_all();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_idleCv.notify_all();
+}
+
+ReaderLease ConnectionManager::reader() {
+    std::unique_lock<std::mutex> lock(m_readMutex);
+    for (;;) {
+        if (m_closed) return ReaderLease(this, nullptr);
+
+        if (!m_idleReaders.empty()) {
+            SqliteConnection* conn = m_idleReaders.back();
+            m_idleReaders.pop_back();
+            return ReaderLease(this, conn);
+        }
+        if (m_readers.size() < MAX_READERS) {
+            std::unique_ptr<SqliteConnection> conn(new SqliteConnection);
+            // 只读打开：WAL 下读连接看到的是开始读事务时的快照，不受并发写入影响
+            if (!conn->open(m_path, SQLITE_OPEN_READONLY)) {
+                return ReaderLease(this, nullptr);
+            }
+            conn->exec("PRAGMA query_only=1");
+            SqliteConnection* raw = conn.get();
+            m_readers.push_back(std::move(conn));
+            return ReaderLease(this, raw);
+        }
+        m_readCv.wait(lock);
+    }
+}
+
+void ConnectionManager::release(SqliteConnection* conn) {
+    {
+        std::lock_guard<std::mutex> lock(m_readMutex);
+        m_idleReaders.push_back(conn);
+    }
+    m_readCv.notify_one();
+}
+
+void ConnectionManager::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (m_stopping) return;
+        m_stopping = true;
+    }
+    m_writeCv.notify_all();
+    if (m_writerThread.joinable()) m_writerThread.join();
+    m_writer->close();
+
+    // 正在使用中的读连接由各自的租约归还，这里只关闭空闲连接
+    std::lock_guard<std::mutex> lock(m_readMutex);
+    m_closed = true;
+    for (SqliteConnection* conn : m_idleReaders) conn->close();
+    m_readCv.notify_all();
+}
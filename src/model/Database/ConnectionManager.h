@@ -0,0 +1,201 @@
+#ifndef CONNECTIONMANAGER_H
+#define CONNECTIONMANAGER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SqliteConnection.h"
+
+class ConnectionManager;
+
+/**
+ * @brief 暂存写任务的返回值，事务提交后再设置到 promise（void 单独特化）
+ */
+template <typename R>
+struct DeferredResult {
+    template <typename F>
+    void run(F& func, SqliteConnection& conn) { value = func(conn); }
+    void deliver(std::promise<R>& promise) { promise.set_value(std::move(value)); }
+    R value{};
+};
+
+template <>
+struct DeferredResult<void> {
+    template <typename F>
+    void run(F& func, SqliteConnection& conn) { func(conn); }
+    void deliver(std::promise<void>& promise) { promise.set_value(); }
+};
+
+/**
+ * @brief 读连接租约，析构时自动归还连接池
+ */
+class ReaderLease
+{
+public:
+    ReaderLease(ConnectionManager* owner, SqliteConnection* conn) : m_owner(owner), m_conn(conn) {}
+    ReaderLease(ReaderLease&& other) noexcept : m_owner(other.m_owner), m_conn(other.m_conn) {
+        other.m_conn = nullptr;
+    }
+    ~ReaderLease();
+
+    ReaderLease(const ReaderLease&) = delete;
+    ReaderLease& operator=(const ReaderLease&) = delete;
+    ReaderLease& operator=(ReaderLease&&) = delete;
+
+    explicit operator bool() const { return m_conn != nullptr && m_conn->isOpen(); }
+    SqliteConnection* operator->() const { return m_conn; }
+    SqliteConnection& operator*() const { return *m_conn; }
+
+private:
+    ConnectionManager* m_owner;
+    SqliteConnection* m_conn;
+};
+
+/**
+ * @brief green-house.db 的共享连接管理
+ *
+ * - 写：唯一的写连接归后台写线程所有，所有写操作以任务形式排队；
+ *   写线程每次取出一批任务放在同一个事务中执行（组提交），一批只刷一次盘
+ * - 读：只读连接池（WAL 模式），历史查询、导出、登录校验各自借用一个连接，
+ *   长时间扫描不会阻塞写入，写入也不会阻塞读取
+ *
+ * 同一批中的每个任务在各自的保存点（SAVEPOINT write_task）中执行：任务抛出异常时
+ * 回滚到保存点，只撤销该任务自己的写入，done 收到 committed == false。
+ * 需要整体撤销的多语句写任务在失败时抛出异常即可，不必自己管理保存点。
+ *
+ * 写任务运行在写线程上，不要在任务中开启/提交事务，也不要访问界面对象。
+ */
+class ConnectionManager
+{
+public:
+    using WriteTask = std::function<void(SqliteConnection&)>;
+    using DoneHandler = std::function<void(bool committed)>;
+
+    static ConnectionManager& instance();
+
+    /**
+     * @brief 提交写任务，不等待结果
+     */
+    void post(WriteTask task);
+
+    /**
+     * @brief 提交写任务，任务所在事务结束（提交或回滚）后在写线程上调用 done
+     *
+     * 用于写入对其他线程可见之后才能做的事（如使查询缓存失效）。
+     */
+    void post(WriteTask task, DoneHandler done);
+
+    /**
+     * @brief 提交写任务并返回 future，用于需要结果的写操作（如返回新行 id）
+     *
+     * future 在任务所在事务提交之后才就绪，拿到结果后立即读取也能看到这次写入；
+     * 事务提交失败时 future 抛出 std::runtime_error。
+     */
+    template <typename F>
+    auto submit(F func) -> std::future<decltype(func(std::declval<SqliteConnection&>()))> {
+        using R = decltype(func(std::declval<SqliteConnection&>()));
+        auto call = std::make_shared<SubmitCall<F, R>>(std::move(func));
+        std::future<R> result = call->promise.get_future();
+        enqueue([call](SqliteConnection& conn) { call->run(conn); },
+                [call](bool committed) { call->finish(committed); });
+        return result;
+    }
+
+    /**
+     * @brief 阻塞直到此前提交的写任务全部提交到数据库
+     */
+    void flush();
+
+    /**
+     * @brief 借用一个只读连接（池中无空闲连接时等待）
+     */
+    ReaderLease reader();
+
+    /**
+     * @brief 写完剩余任务并关闭所有连接（程序退出前调用）
+     */
+    void shutdown();
+
+    const std::string& path() const { return m_path; }
+
+private:
+    friend class ReaderLease;
+
+    struct WriteEntry {
+        WriteTask task;
+        DoneHandler done;   // 事务结束后调用，可为空
+        bool failed = false;   // 任务抛出异常，写入已回滚到保存点
+    };
+
+    /**
+     * @brief submit 的执行体：任务在事务中执行，结果暂存，事务结束后再交给 promise
+     */
+    template <typename F, typename R>
+    struct SubmitCall {
+        explicit SubmitCall(F f) : func(std::move(f)) {}
+
+        void run(SqliteConnection& conn) {
+            try {
+                result.run(func, conn);
+            } catch (...) {
+                // 交给写线程回滚本任务的保存点，finish 时再交给 promise
+                error = std::current_exception();
+                throw;
+            }
+        }
+        void finish(bool committed) {
+            if (!error && !committed) {
+                error = std::make_exception_ptr(std::runtime_error("write transaction failed to commit"));
+            }
+            if (error) promise.set_exception(error);
+            else result.deliver(promise);
+        }
+
+        F func;
+        DeferredResult<R> result;
+        std::exception_ptr error;
+        std::promise<R> promise;
+    };
+
+    void enqueue(WriteTask task, DoneHandler done);
+
+    explicit ConnectionManager(const std::string& path);
+    ~ConnectionManager();
+
+    void writerLoop();
+    void release(SqliteConnection* conn);
+
+    std::string m_path;
+
+    // ---------- 写 ----------
+    std::unique_ptr<SqliteConnection> m_writer;
+    std::thread m_writerThread;
+    std::mutex m_writeMutex;
+    std::condition_variable m_writeCv;       // 有新任务 / 需要退出
+    std::condition_variable m_idleCv;        // 队列已清空（flush 等待）
+    std::deque<WriteEntry> m_queue;
+    std::size_t m_inFlight = 0;              // 已取出但尚未提交的任务数
+    bool m_stopping = false;
+
+    // ---------- 读 ----------
+    std::mutex m_readMutex;
+    std::condition_variable m_readCv;
+    std::vector<std::unique_ptr<SqliteConnection>> m_readers;  // 已创建的全部只读连接
+    std::vector<SqliteConnection*> m_idleReaders;
+    bool m_closed = false;
+
+    static constexpr std::size_t MAX_BATCH = 256;    // 每个事务最多包含的写任务数
+    static constexpr std::size_t MAX_READERS = 4;    // 只读连接上限
+};
+
+#endif // CONNECTIONMANAGER_H
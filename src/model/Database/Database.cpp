@@ -1,26 +1,134 @@
 #include "Database.h"
+#include <algorithm>
+#include <climits>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <utility>
 #include <QDebug>
 
+#include "ConnectionManager.h"
+#include "HistoryTileCache.h"
+#include "HotTierCache.h"
+#include "SchemaMigrations.h"
+#include "untils/Log.h"
+#include "untils/Metrics.h"
+#include "untils/StartupTrace.h"
+#include "untils/TimerUtil.h"
 
-// 静态辅助函数：创建存储（用于初始化 m_storage）
-static auto makeStorage() {
-    return sqlite_orm::make_storage("green-house.db",
-        sqlite_orm::make_table("green_data",
-            sqlite_orm::make_column("id", &SensorRecord::id, sqlite_orm::primary_key().autoincrement()),
-            sqlite_orm::make_column("record_time", &SensorRecord::record_time),
-            sqlite_orm::make_column("air_temp", &SensorRecord::air_temp),
-            sqlite_orm::make_column("air_humid", &SensorRecord::air_humid),
-            sqlite_orm::make_column("soil_humid", &SensorRecord::soil_humid),
-            sqlite_orm::make_column("light_intensity", &SensorRecord::light_intensity)
-        )
-    );
+
+// ========================================
+// 预编译语句
+// ========================================
+
+namespace {
+
+const char* const kInsertSql =
+    "INSERT INTO green_data(record_time, air_temp, air_humid, soil_humid, light_intensity, ts_ms, device_id) "
+    "VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7)";
+
+// SensorRecord 只有 record_time（本地时间），ts_ms 由 SQLite 换算
+const char* const kInsertRecordSql =
+    "INSERT INTO green_data(record_time, air_temp, air_humid, soil_humid, light_intensity, ts_ms) "
+    "VALUES(?1, ?2, ?3, ?4, ?5, CAST(strftime('%s', ?1, 'utc') AS INTEGER) * 1000)";
+
+const char* const kSelectRangeSql =
+    "SELECT id, record_time, air_temp, air_humid, soil_humid, light_intensity "
+    "FROM green_data WHERE record_time BETWEEN ?1 AND ?2";
+
+const char* const kDeleteRangeSql =
+    "DELETE FROM green_data WHERE record_time BETWEEN ?1 AND ?2";
+
+const char* const kScanRangeSql =
+    "SELECT id, record_time, air_temp, air_humid, soil_humid, light_intensity "
+    "FROM green_data WHERE record_time BETWEEN ?1 AND ?2 ORDER BY record_time, id";
+
+// ts_ms 可能尚未回填，按 record_time 换算
+const char* const kScanSamplesSql =
+    "SELECT id, COALESCE(ts_ms, CAST(strftime('%s', record_time, 'utc') AS INTEGER) * 1000), device_id, "
+    "air_temp, air_humid, soil_humid, light_intensity "
+    "FROM green_data WHERE record_time >= ?1 ORDER BY record_time, id";
+
+// 桶号 = ts / 桶宽，四个读数各取最小 / 最大值
+const char* const kAggregateRangeSql =
+    "SELECT ts / ?3, COUNT(*), MIN(air_temp), MAX(air_temp), MIN(air_humid), MAX(air_humid), "
+    "MIN(soil_humid), MAX(soil_humid), MIN(light_intensity), MAX(light_intensity) "
+    "FROM (SELECT COALESCE(ts_ms, CAST(strftime('%s', record_time, 'utc') AS INTEGER) * 1000) AS ts, "
+    "air_temp, air_humid, soil_humid, light_intensity "
+    "FROM green_data WHERE record_time BETWEEN ?1 AND ?2) "
+    "GROUP BY 1 ORDER BY 1";
+
+const char* const kCountRangeSql =
+    "SELECT COUNT(*) FROM green_data WHERE record_time BETWEEN ?1 AND ?2";
+
+const char* const kSelectLatestSql =
+    "SELECT id, record_time, air_temp, air_humid, soil_humid, light_intensity "
+    "FROM green_data ORDER BY record_time DESC, id DESC LIMIT ?1";
+
+// 按 SELECT 的列顺序读取一行
+SensorRecord readRecord(const SqliteStatement& stmt) {
+    SensorRecord record;
+    record.id = stmt.columnInt(0);
+    record.record_time = stmt.columnText(1);
+    record.air_temp = stmt.columnInt(2);
+    record.air_humid = stmt.columnInt(3);
+    record.soil_humid = stmt.columnInt(4);
+    record.light_intensity = stmt.columnInt(5);
+    return record;
+}
+
+// 在读连接上执行 SELECT，结果追加到 out
+template <typename Binder>
+bool selectRecords(const char* sql, Binder bindParams, std::vector<SensorRecord>& out) {
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(sql) : nullptr;
+    if (!stmt) {
+        qDebug()<< "数据库查询异常:" << (conn ? conn->lastError().c_str() : "no reader connection");
+        return false;
+    }
+
+    SqliteStatementScope scope(*stmt);
+    bindParams(*stmt);
+
+    int rc;
+    while ((rc = stmt->step()) == SQLITE_ROW) {
+        out.push_back(readRecord(*stmt));
+    }
+    if (rc != SQLITE_DONE) {
+        qDebug()<< "数据库查询异常:" << conn->lastError().c_str();
+        return false;
+    }
+    return true;
 }
 
+// 写事务中插入成功的行 (id, 样本)；事务提交后才追加到 HotTierCache，回滚的行不会出现在热数据层
+using InsertedRows = std::vector<std::pair<int64_t, SensorSample>>;
+
+void appendCommitted(const InsertedRows& rows) {
+    HotTierCache& hot = HotTierCache::instance();
+    for (const auto& row : rows) {
+        hot.append(row.first, row.second);
+    }
+}
+
+} // namespace
+
 Database::Database()
-    : m_storage(makeStorage())  // 实际初始化
 {
-    m_storage.sync_schema();
+    StartupTrace::Scope trace("数据库初始化");
+
+    // 表结构由版本化迁移维护：已是最新版本时只读取一次 user_version
+    const int version = SchemaMigrations::ensureLatest();
+    if (version < SchemaMigrations::LATEST_VERSION) {
+        std::cerr << "数据库迁移未完成，当前版本 " << version << std::endl;
+    }
+
+    // 在写连接上预先编译插入语句
+    ConnectionManager::instance().submit([](SqliteConnection& conn) {
+        conn.prepare(kInsertSql);
+        conn.prepare(kInsertRecordSql);
+        conn.prepare(kDeleteRangeSql);
+    }).wait();
     std::cout << "数据库初始化成功" << std::endl;
 }
 
@@ -29,44 +137,311 @@ Database& Database::instance() {
     return db;
 }
 
-auto& Database::getStorage() {
-    return m_storage;
-}
 bool Database::insert(const SensorRecord &data) {
-    try {
-        m_storage.insert(data);
-        return true;
-    }catch (const std::exception& e) {
-        std::cerr<<"插入失败"<<e.what()<<std::endl;
-        return false;
-    }
+    int64_t secs = 0;
+    const int64_t tsMs = TimerUtil::parseRecordTime(data.record_time.data(), data.record_time.size(), secs)
+                         ? secs * 1000 : -1;
+    auto inserted = std::make_shared<InsertedRows>();
+    // 写入交给写线程排队（与同一时段的其他写入合并为一个事务），不阻塞调用线程
+    ConnectionManager::instance().post([data, tsMs, inserted](SqliteConnection& conn) {
+        SqliteStatement* stmt = conn.prepare(kInsertRecordSql);
+        bool ok = false;
+        if (stmt) {
+            SqliteStatementScope scope(*stmt);
+            stmt->bind(1, data.record_time);
+            stmt->bind(2, data.air_temp);
+            stmt->bind(3, data.air_humid);
+            stmt->bind(4, data.soil_humid);
+            stmt->bind(5, data.light_intensity);
+            ok = stmt->step() == SQLITE_DONE;
+        }
+        if (!ok) {
+            PipelineMetrics::dbWriteFailures().inc();
+            std::cerr<<"插入失败"<<conn.lastError()<<std::endl;
+            return;
+        }
+        PipelineMetrics::samplesStored().inc();
+
+        if (tsMs >= 0) {
+            SensorSample sample;
+            sample.tsMs = tsMs;
+            sample.airTemp = data.air_temp;
+            sample.airHumid = data.air_humid;
+            sample.soilHumid = data.soil_humid;
+            sample.lightIntensity = data.light_intensity;
+            inserted->emplace_back(conn.lastInsertRowId(), sample);
+        }
+    }, [tsMs, inserted](bool committed) {
+        if (committed) appendCommitted(*inserted);
+        if (tsMs >= 0) HistoryTileCache::instance().invalidate(tsMs, tsMs + 999);
+    });
+    return true;
+}
+
+bool Database::insertBatch(SensorBus::Batch* batch) {
+    if (!batch) return false;
+    // 写入的时间范围，事务结束后用于使历史瓦片失效
+    auto range = std::make_shared<std::pair<int64_t, int64_t>>(INT64_MAX, INT64_MIN);
+    auto inserted = std::make_shared<InsertedRows>();
+    // 时间字符串在写线程上格式化到栈缓冲区，样本本身在 UI 线程上不产生字符串
+    ConnectionManager::instance().post([batch, range, inserted](SqliteConnection& conn) {
+        SqliteStatement* stmt = conn.prepare(kInsertSql);
+        inserted->reserve(batch->size);
+        int stored = 0;
+        int failed = 0;
+        char timeBuf[TimerUtil::RECORD_TIME_SIZE];
+        for (const SensorSample& sample : *batch) {
+            bool ok = false;
+            if (stmt) {
+                SqliteStatementScope scope(*stmt);
+                const std::size_t timeLen = TimerUtil::formatRecordTime(sample.tsMs, timeBuf);
+                stmt->bind(1, timeBuf, static_cast<int>(timeLen));
+                stmt->bind(2, static_cast<int>(sample.airTemp));
+                stmt->bind(3, static_cast<int>(sample.airHumid));
+                stmt->bind(4, static_cast<int>(sample.soilHumid));
+                stmt->bind(5, static_cast<int>(sample.lightIntensity));
+                stmt->bind(6, sample.tsMs);
+                stmt->bind(7, static_cast<int>(sample.deviceId));
+                ok = stmt->step() == SQLITE_DONE;
+            }
+            if (ok) {
+                ++stored;
+                inserted->emplace_back(conn.lastInsertRowId(), sample);
+                range->first = std::min(range->first, sample.tsMs);
+                range->second = std::max(range->second, sample.tsMs);
+            } else {
+                ++failed;
+            }
+        }
+
+        PipelineMetrics::samplesStored().inc(stored);
+        if (failed > 0) {
+            PipelineMetrics::dbWriteFailures().inc(failed);
+            std::cerr<<"批量插入失败 "<<failed<<" 条: "<<conn.lastError()<<std::endl;
+        }
+    }, [batch, range, inserted](bool committed) {
+        if (committed) appendCommitted(*inserted);
+        // 在 done 中归还：数据库已关闭、任务被丢弃时同样会调用
+        SensorBus::batchPool().release(batch);
+        HistoryTileCache::instance().invalidate(range->first, range->second);
+    });
+    return true;
 }
 
 bool Database::queryByTime(const std::string &startTime, const std::string &endTime,std::vector<SensorRecord>& outResults) {
-    try {
-        outResults = m_storage.get_all<SensorRecord>(
-             sqlite_orm::where(
-                sqlite_orm::between(&SensorRecord::record_time, startTime, endTime)
-             )
-         );
-        return true; // 成功
-    } catch (const std::exception& e) {
-        qDebug()<< "数据库查询异常:" << e.what();
-        outResults.clear(); // 确保输出是干净的
-        return false;       // 失败
+    outResults.clear(); // 确保输出是干净的
+
+    // 与热数据层重叠的部分（ts >= hotStart）从内存取，磁盘只查 [startTime, hotStart 前一秒]
+    int64_t startSecs = 0;
+    int64_t endSecs = 0;
+    int64_t hotStartMs = -1;
+    std::vector<SensorRecord> hotRows;
+    if (TimerUtil::parseRecordTime(startTime.data(), startTime.size(), startSecs)
+        && TimerUtil::parseRecordTime(endTime.data(), endTime.size(), endSecs)
+        && startSecs <= endSecs) {
+        hotStartMs = HotTierCache::instance().query(startSecs * 1000, endSecs * 1000 + 999, hotRows);
+    }
+
+    std::string coldEnd = endTime;
+    bool needCold = true;
+    if (hotStartMs >= 0 && hotStartMs <= endSecs * 1000 + 999) {
+        if (hotStartMs <= startSecs * 1000) {
+            needCold = false;
+        } else {
+            char timeBuf[TimerUtil::RECORD_TIME_SIZE];
+            TimerUtil::formatRecordTime(hotStartMs - 1000, timeBuf);
+            coldEnd = timeBuf;
+        }
     }
+
+    if (needCold) {
+        const bool ok = selectRecords(kSelectRangeSql, [&](SqliteStatement& stmt) {
+            stmt.bind(1, startTime);
+            stmt.bind(2, coldEnd);
+        }, outResults);
+        if (!ok) {
+            outResults.clear();
+            return false;
+        }
+    }
+    if (outResults.empty()) {
+        outResults.swap(hotRows);
+    } else {
+        outResults.insert(outResults.end(), std::make_move_iterator(hotRows.begin()),
+                          std::make_move_iterator(hotRows.end()));
+    }
+    return true;
 }
 
 bool Database::deleteByTime(const std::string &startTime, const std::string &endTime) {
+    // 删除需要告知调用方结果，等待写线程执行完毕
+    std::future<int> result = ConnectionManager::instance().submit([startTime, endTime](SqliteConnection& conn) {
+        SqliteStatement* stmt = conn.prepare(kDeleteRangeSql);
+        if (!stmt) return -1;
+        SqliteStatementScope scope(*stmt);
+        stmt->bind(1, startTime);
+        stmt->bind(2, endTime);
+        return stmt->step() == SQLITE_DONE ? conn.changes() : -1;
+    });
+    int deleted = -1;
     try {
-        m_storage.remove_all<SensorRecord>(
-             sqlite_orm::where(
-                 sqlite_orm::between(&SensorRecord::record_time,startTime,endTime)
-        ));
-        std::cout<<"删除成功"<<std::endl;
-        return true;
-    }catch (const std::exception& e) {
-        std::cerr<<"按时间删除失败"<<e.what()<<std::endl;
+        deleted = result.get();
+    } catch (const std::exception& e) {
+        // 事务提交失败（已回滚）或数据库已关闭
+        std::cerr<<"按时间删除事务提交失败: "<<e.what()<<std::endl;
+    }
+
+    if (deleted < 0) {
+        std::cerr<<"按时间删除失败"<<std::endl;
+        return false;
+    }
+    LOG_INFO("按时间删除完成: {} 行", deleted);
+
+    int64_t startSecs = 0;
+    int64_t endSecs = 0;
+    if (TimerUtil::parseRecordTime(startTime.data(), startTime.size(), startSecs)
+        && TimerUtil::parseRecordTime(endTime.data(), endTime.size(), endSecs)) {
+        HotTierCache::instance().erase(startSecs * 1000, endSecs * 1000 + 999);
+        HistoryTileCache::instance().invalidate(startSecs * 1000, endSecs * 1000 + 999);
+    } else if (deleted > 0) {
+        // 无法换算成时间戳时无从判断删了哪些行，重新加载
+        HotTierCache::instance().reload();
+        HistoryTileCache::instance().clear();
+    }
+    return true;
+}
+
+bool Database::queryLatest(int count, std::vector<SensorRecord>& outResults) {
+    outResults.clear();
+    if (count <= 0) return true;
+
+    outResults.reserve(static_cast<std::size_t>(count));
+    const bool ok = selectRecords(kSelectLatestSql, [count](SqliteStatement& stmt) {
+        stmt.bind(1, count);
+    }, outResults);
+    if (!ok) {
+        outResults.clear();
+        return false;
+    }
+    // 倒序查出，翻转为时间升序
+    std::reverse(outResults.begin(), outResults.end());
+    return true;
+}
+
+int64_t Database::countByTime(const std::string &startTime, const std::string &endTime) {
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kCountRangeSql) : nullptr;
+    if (!stmt) return -1;
+
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, startTime);
+    stmt->bind(2, endTime);
+    return stmt->step() == SQLITE_ROW ? stmt->columnInt64(0) : -1;
+}
+
+int64_t Database::scanByTime(const std::string &startTime, const std::string &endTime,
+                             const std::function<bool(const SensorRowView&)>& visitor) {
+    // 整个遍历占用一个读连接（WAL 下不阻塞写线程），逐行交给 visitor，不在内存中保留结果
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kScanRangeSql) : nullptr;
+    if (!stmt) {
+        qDebug()<< "数据库查询异常:" << (conn ? conn->lastError().c_str() : "no reader connection");
+        return -1;
+    }
+
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, startTime);
+    stmt->bind(2, endTime);
+
+    int64_t rows = 0;
+    SensorRowView row;
+    int rc;
+    while ((rc = stmt->step()) == SQLITE_ROW) {
+        row.id = stmt->columnInt64(0);
+        row.recordTime = stmt->columnTextView(1, &row.recordTimeLength);
+        row.airTemp = stmt->columnInt(2);
+        row.airHumid = stmt->columnInt(3);
+        row.soilHumid = stmt->columnInt(4);
+        row.lightIntensity = stmt->columnInt(5);
+        ++rows;
+        if (!visitor(row)) return rows;
+    }
+    if (rc != SQLITE_DONE) {
+        qDebug()<< "数据库查询异常:" << conn->lastError().c_str();
+        return -1;
+    }
+    return rows;
+}
+
+int64_t Database::scanSamplesSince(const std::string &sinceTime,
+                                   const std::function<bool(int64_t id, const SensorSample&)>& visitor) {
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kScanSamplesSql) : nullptr;
+    if (!stmt) {
+        qDebug()<< "数据库查询异常:" << (conn ? conn->lastError().c_str() : "no reader connection");
+        return -1;
+    }
+
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, sinceTime);
+
+    int64_t rows = 0;
+    SensorSample sample;
+    sample.flags = SAMPLE_VALID;
+    int rc;
+    while ((rc = stmt->step()) == SQLITE_ROW) {
+        sample.tsMs = stmt->columnInt64(1);
+        sample.deviceId = stmt->columnInt(2);
+        sample.airTemp = stmt->columnInt(3);
+        sample.airHumid = stmt->columnInt(4);
+        sample.soilHumid = stmt->columnInt(5);
+        sample.lightIntensity = stmt->columnInt(6);
+        ++rows;
+        if (!visitor(stmt->columnInt64(0), sample)) return rows;
+    }
+    if (rc != SQLITE_DONE) {
+        qDebug()<< "数据库查询异常:" << conn->lastError().c_str();
+        return -1;
+    }
+    return rows;
+}
+
+bool Database::aggregateByTime(int64_t fromMs, int64_t toMs, int64_t bucketMs, std::vector<SensorBucket>& outBuckets) {
+    outBuckets.clear();
+    if (bucketMs <= 0 || fromMs > toMs) return false;
+
+    char startBuf[TimerUtil::RECORD_TIME_SIZE];
+    char endBuf[TimerUtil::RECORD_TIME_SIZE];
+    const std::size_t startLen = TimerUtil::formatRecordTime(fromMs, startBuf);
+    const std::size_t endLen = TimerUtil::formatRecordTime(toMs, endBuf);
+
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kAggregateRangeSql) : nullptr;
+    if (!stmt) {
+        qDebug()<< "数据库查询异常:" << (conn ? conn->lastError().c_str() : "no reader connection");
+        return false;
+    }
+
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, startBuf, static_cast<int>(startLen));
+    stmt->bind(2, endBuf, static_cast<int>(endLen));
+    stmt->bind(3, bucketMs);
+
+    int rc;
+    while ((rc = stmt->step()) == SQLITE_ROW) {
+        SensorBucket bucket;
+        bucket.startMs = stmt->columnInt64(0) * bucketMs;
+        bucket.count = stmt->columnInt(1);
+        for (int c = 0; c < CHANNEL_COUNT; ++c) {
+            bucket.minValue[c] = stmt->columnInt(2 + c * 2);
+            bucket.maxValue[c] = stmt->columnInt(3 + c * 2);
+        }
+        outBuckets.push_back(bucket);
+    }
+    if (rc != SQLITE_DONE) {
+        qDebug()<< "数据库查询异常:" << conn->lastError().c_str();
+        outBuckets.clear();
         return false;
     }
-}
\ No newline at end of file
+    return true;
+}
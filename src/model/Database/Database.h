@@ -1,32 +1,74 @@
 #ifndef DATABASE_H
 #define DATABASE_H
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include "model/SensorData.h"
+#include "model/SensorBus.h"
 #include <vector>
-#include "sqlite_orm.h"
+
+/**
+ * @brief green_data 的一行（游标遍历用）
+ *
+ * recordTime 指向语句内部的缓冲区，只在回调期间有效，不以 '\0' 结尾。
+ */
+struct SensorRowView {
+    int64_t id = 0;
+    const char* recordTime = nullptr;
+    int recordTimeLength = 0;
+    int airTemp = 0;
+    int airHumid = 0;
+    int soilHumid = 0;
+    int lightIntensity = 0;
+};
+
+/**
+ * @brief 一个时间桶内的聚合结果（按 SensorChannel 下标的最小 / 最大值）
+ */
+struct SensorBucket {
+    int64_t startMs = 0;
+    int32_t count = 0;
+    int32_t minValue[CHANNEL_COUNT] = {};
+    int32_t maxValue[CHANNEL_COUNT] = {};
+};
+
+/**
+ * @brief 传感器数据库（green_data 表）
+ *
+ * 表结构由 SchemaMigrations 按版本迁移（列：id, record_time, 4 个读数, ts_ms, device_id）；
+ * 数据操作通过 ConnectionManager：插入/删除在写线程上执行，查询使用只读连接池，
+ * 均使用各连接上缓存的预编译语句。
+ * 最近一段时间的数据同时保存在 HotTierCache 中，queryByTime 只对缓存之外的部分查询磁盘。
+ */
 class Database {
 public:
     static Database& instance();
-    auto& getStorage();
-    bool insert(const SensorRecord& data);//插入
+    //插入（异步：只排入写队列，不等待写入结果，总是返回 true；失败计入 gh_db_write_failures_total）
+    bool insert(const SensorRecord& data);
+    //批量插入（写线程上一次执行完；batch 在事务结束或写任务被丢弃后归还给 SensorBus::batchPool）
+    bool insertBatch(SensorBus::Batch* batch);
     //查询指定时间范围的数据
     bool queryByTime(const std::string& startTime,const std::string& endTime,std::vector<SensorRecord>& outResults);
     bool deleteByTime(const std::string& startTime,const std::string&  endTime);
+    //查询最新的 count 条数据（按时间升序返回）
+    bool queryLatest(int count, std::vector<SensorRecord>& outResults);
+    //统计指定时间范围的行数，失败返回 -1
+    int64_t countByTime(const std::string& startTime, const std::string& endTime);
+    //按时间升序逐行遍历指定范围（不缓存结果，内存占用与行数无关）；visitor 返回 false 时提前结束
+    //返回遍历的行数，失败返回 -1
+    int64_t scanByTime(const std::string& startTime, const std::string& endTime,
+                       const std::function<bool(const SensorRowView&)>& visitor);
+    //按时间升序遍历 record_time >= sinceTime 的行，带 ts_ms / device_id（供 HotTierCache 加载）
+    //返回遍历的行数，失败返回 -1
+    int64_t scanSamplesSince(const std::string& sinceTime,
+                             const std::function<bool(int64_t id, const SensorSample&)>& visitor);
+    //把 [fromMs, toMs] 按 bucketMs 宽的时间桶（从 Unix 纪元起对齐）聚合，只返回有数据的桶，按时间升序
+    //fromMs / toMs 需对齐到整秒（toMs 为某一秒的最后一毫秒），与 record_time 的范围一一对应
+    bool aggregateByTime(int64_t fromMs, int64_t toMs, int64_t bucketMs, std::vector<SensorBucket>& outBuckets);
 private:
     Database();
     ~Database()=default;
-    decltype(sqlite_orm::make_storage(
-       std::string{},  // 占位符，实际类型由 .cpp 中的初始化决定
-       sqlite_orm::make_table("green_data",
-           sqlite_orm::make_column("id", &SensorRecord::id, sqlite_orm::primary_key().autoincrement()),
-           sqlite_orm::make_column("record_time", &SensorRecord::record_time),
-           sqlite_orm::make_column("air_temp", &SensorRecord::air_temp),
-           sqlite_orm::make_column("air_humid", &SensorRecord::air_humid),
-           sqlite_orm::make_column("soil_humid", &SensorRecord::soil_humid),
-           sqlite_orm::make_column("light_intensity", &SensorRecord::light_intensity)
-       )
-   )) m_storage;  // 类型由 decltype 推断e;
 };
 
 #endif // DATABASE_H
\ No newline at end of file
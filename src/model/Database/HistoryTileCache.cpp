@@ -0,0 +1,194 @@
+#include "HistoryTileCache.h"
+
+#include "Database.h"
+#include "untils/Log.h"
+#include "untils/Metrics.h"
+
+namespace {
+
+// 单次取数覆盖的瓦片数上限（调用方应通过 levelForSpan 选级别，正常只有几块）
+const int64_t MAX_FETCH_TILES = 256;
+
+Counter& tilesHit() {
+    static Counter& c = Metrics::counter("gh_history_tiles_hit", "History chart tiles served from the tile cache");
+    return c;
+}
+
+Counter& tilesFetched() {
+    static Counter& c = Metrics::counter("gh_history_tiles_fetched", "History chart tiles aggregated from the database");
+    return c;
+}
+
+} // namespace
+
+HistoryTileCache& HistoryTileCache::instance()
+{
+    static HistoryTileCache cache;
+    return cache;
+}
+
+int64_t HistoryTileCache::bucketMs(int level)
+{
+    return static_cast<int64_t>(1000) << (2 * level);
+}
+
+int64_t HistoryTileCache::tileSpanMs(int level)
+{
+    return bucketMs(level) * TILE_BUCKETS;
+}
+
+int HistoryTileCache::levelForSpan(int64_t spanMs, int maxBuckets)
+{
+    if (maxBuckets < 1) maxBuckets = 1;
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        if (spanMs / bucketMs(level) <= maxBuckets) return level;
+    }
+    return LEVEL_COUNT - 1;
+}
+
+// ========================================
+// 取数
+// ========================================
+
+bool HistoryTileCache::fetch(unsigned channelMask, int level, int64_t fromMs, int64_t toMs, HistoryBuckets& out)
+{
+    for (auto& buckets : out) buckets.clear();
+    if (level < 0 || level >= LEVEL_COUNT || fromMs > toMs) return false;
+    if (fromMs < 0) fromMs = 0;
+
+    const int64_t span = tileSpanMs(level);
+    const int64_t first = fromMs / span;
+    const int64_t tileCount = toMs / span - first + 1;
+    if (tileCount > MAX_FETCH_TILES) {
+        LOG_WARN("历史瓦片请求过大: 级别 {}，{} 块", level, tileCount);
+        return false;
+    }
+
+    std::vector<std::array<TilePtr, CHANNEL_COUNT>> tiles(static_cast<std::size_t>(tileCount));
+    std::vector<unsigned> missing(static_cast<std::size_t>(tileCount), 0);
+    uint64_t epoch;
+    uint64_t hits = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        epoch = m_epoch;
+        for (int64_t i = 0; i < tileCount; ++i) {
+            for (int c = 0; c < CHANNEL_COUNT; ++c) {
+                if (!(channelMask & (1u << c))) continue;
+                auto it = m_index.find(makeKey(c, level, first + i));
+                if (it == m_index.end()) {
+                    missing[i] |= 1u << c;
+                    continue;
+                }
+                m_lru.splice(m_lru.begin(), m_lru, it->second);
+                tiles[i][c] = it->second->tile;
+                ++hits;
+            }
+        }
+    }
+    tilesHit().inc(hits);
+
+    // 相邻的缺失瓦片合并成一次聚合查询，再按瓦片边界切开
+    std::vector<SensorBucket> rows;
+    uint64_t fetched = 0;
+    for (int64_t i = 0; i < tileCount;) {
+        if (!missing[i]) {
+            ++i;
+            continue;
+        }
+        int64_t j = i;
+        while (j + 1 < tileCount && missing[j + 1]) ++j;
+
+        const int64_t runFrom = (first + i) * span;
+        const int64_t runTo = (first + j + 1) * span - 1;
+        if (!Database::instance().aggregateByTime(runFrom, runTo, bucketMs(level), rows)) return false;
+
+        std::size_t r = 0;
+        for (int64_t k = i; k <= j; ++k) {
+            const int64_t tileEnd = (first + k + 1) * span;
+            std::array<std::shared_ptr<Tile>, CHANNEL_COUNT> built;
+            for (int c = 0; c < CHANNEL_COUNT; ++c) {
+                if (missing[k] & (1u << c)) built[c] = std::make_shared<Tile>();
+            }
+            for (; r < rows.size() && rows[r].startMs < tileEnd; ++r) {
+                for (int c = 0; c < CHANNEL_COUNT; ++c) {
+                    if (built[c]) built[c]->push_back({rows[r].startMs, rows[r].minValue[c], rows[r].maxValue[c]});
+                }
+            }
+            for (int c = 0; c < CHANNEL_COUNT; ++c) {
+                if (!built[c]) continue;
+                tiles[k][c] = std::move(built[c]);
+                ++fetched;
+            }
+        }
+        i = j + 1;
+    }
+    tilesFetched().inc(fetched);
+
+    if (fetched > 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 查询期间有写入提交时，新瓦片可能不含这次写入，只用于本次结果
+        if (m_epoch == epoch) {
+            for (int64_t i = 0; i < tileCount; ++i) {
+                for (int c = 0; c < CHANNEL_COUNT; ++c) {
+                    if (missing[i] & (1u << c)) insertLocked(makeKey(c, level, first + i), tiles[i][c]);
+                }
+            }
+        }
+    }
+
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        if (!(channelMask & (1u << c))) continue;
+        for (const auto& tile : tiles) {
+            if (tile[c]) out[c].insert(out[c].end(), tile[c]->begin(), tile[c]->end());
+        }
+    }
+    return true;
+}
+
+void HistoryTileCache::insertLocked(uint64_t key, TilePtr tile)
+{
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        it->second->tile = std::move(tile);
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return;
+    }
+    m_lru.push_front(Entry{key, std::move(tile)});
+    m_index[key] = m_lru.begin();
+    while (m_lru.size() > CAPACITY_TILES) {
+        m_index.erase(m_lru.back().key);
+        m_lru.pop_back();
+    }
+}
+
+// ========================================
+// 失效
+// ========================================
+
+void HistoryTileCache::invalidate(int64_t fromMs, int64_t toMs)
+{
+    if (fromMs > toMs) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_epoch;
+    if (m_lru.empty()) return;
+
+    for (auto it = m_lru.begin(); it != m_lru.end();) {
+        const int64_t index = static_cast<int64_t>(it->key >> 6);
+        const int level = static_cast<int>((it->key >> 2) & 0xF);
+        const int64_t span = tileSpanMs(level);
+        if (index * span <= toMs && (index + 1) * span > fromMs) {
+            m_index.erase(it->key);
+            it = m_lru.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void HistoryTileCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_epoch;
+    m_lru.clear();
+    m_index.clear();
+}
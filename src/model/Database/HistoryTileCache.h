@@ -0,0 +1,91 @@
+#ifndef HISTORYTILECACHE_H
+#define HISTORYTILECACHE_H
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "model/SensorData.h"
+
+/**
+ * @brief 降采样后的一个时间桶（某个通道在桶内的最小 / 最大值）
+ */
+struct TileBucket {
+    int64_t startMs = 0;
+    int32_t minValue = 0;
+    int32_t maxValue = 0;
+};
+
+/// 每个通道一串按时间升序的桶（只含有数据的桶）
+using HistoryBuckets = std::array<std::vector<TileBucket>, CHANNEL_COUNT>;
+
+/**
+ * @brief 历史曲线的降采样瓦片缓存（LRU）
+ *
+ * 与地图瓦片类似：分辨率级别 level 的桶宽为 1 秒 × 4^level，每块瓦片固定 TILE_BUCKETS 个桶、
+ * 从 Unix 纪元起对齐，键为 (通道, 级别, 瓦片序号)。
+ * - 缩放 / 平移时按可见跨度选级别，只查询缓存中缺少的瓦片；相邻的缺失瓦片合并成一次聚合查询
+ *   （Database::aggregateByTime，GROUP BY 在 SQLite 内完成，不把原始行读进内存）
+ * - 写入落到已缓存的桶所在时间范围时，对应的瓦片失效（在写事务提交之后）
+ *
+ * 可在任意线程调用。
+ */
+class HistoryTileCache
+{
+public:
+    static constexpr int TILE_BUCKETS = 256;
+    static constexpr int LEVEL_COUNT = 10;             // 1 秒 ~ 约 3 天一个桶
+    static constexpr std::size_t CAPACITY_TILES = 2048; // 约 8 MB
+
+    static HistoryTileCache& instance();
+
+    static int64_t bucketMs(int level);
+    static int64_t tileSpanMs(int level);
+
+    /**
+     * @brief 选择使 spanMs 内的桶数不超过 maxBuckets 的最细级别
+     */
+    static int levelForSpan(int64_t spanMs, int maxBuckets);
+
+    /**
+     * @brief 取出覆盖 [fromMs, toMs] 的瓦片中 channelMask 各通道的桶（整块瓦片，可能略超出范围）
+     * @param channelMask 1 << SensorChannel 的组合
+     * @return 缺失瓦片查询失败时返回 false
+     */
+    bool fetch(unsigned channelMask, int level, int64_t fromMs, int64_t toMs, HistoryBuckets& out);
+
+    /**
+     * @brief 时间范围 [fromMs, toMs] 内有数据写入 / 删除（写事务提交之后调用）
+     */
+    void invalidate(int64_t fromMs, int64_t toMs);
+
+    void clear();
+
+private:
+    using Tile = std::vector<TileBucket>;
+    using TilePtr = std::shared_ptr<const Tile>;
+
+    struct Entry {
+        uint64_t key;
+        TilePtr tile;
+    };
+
+    HistoryTileCache() = default;
+
+    static uint64_t makeKey(int channel, int level, int64_t index) {
+        return (static_cast<uint64_t>(index) << 6) | (static_cast<uint64_t>(level) << 2) | static_cast<uint64_t>(channel);
+    }
+
+    void insertLocked(uint64_t key, TilePtr tile);
+
+    std::mutex m_mutex;
+    std::list<Entry> m_lru;                            // 头部为最近使用
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> m_index;
+    uint64_t m_epoch = 0;                              // 每次失效加一；查询期间有写入时结果不入缓存
+};
+
+#endif // HISTORYTILECACHE_H
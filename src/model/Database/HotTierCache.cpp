@@ -0,0 +1,373 @@
+#include "HotTierCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <iterator>
+
+#include "ConnectionManager.h"
+#include "Database.h"
+#include "untils/Log.h"
+#include "untils/Metrics.h"
+#include "untils/TimerUtil.h"
+
+// ========================================
+// 列式块
+// ========================================
+
+struct HotTierCache::Chunk {
+    explicit Chunk(int64_t baseTs) : baseTsMs(baseTs), maxTsMs(baseTs) {}
+
+    bool accepts(int64_t tsMs) const {
+        return count < CHUNK_ROWS && tsMs >= baseTsMs && tsMs - baseTsMs <= static_cast<int64_t>(UINT32_MAX);
+    }
+
+    void push(int64_t rowId, const SensorSample& sample) {
+        tsOffset[count] = static_cast<uint32_t>(sample.tsMs - baseTsMs);
+        id[count] = static_cast<int32_t>(rowId);
+        airTemp[count] = sample.airTemp;
+        airHumid[count] = sample.airHumid;
+        soilHumid[count] = sample.soilHumid;
+        lightIntensity[count] = sample.lightIntensity;
+        maxTsMs = std::max(maxTsMs, sample.tsMs);
+        ++count;
+    }
+
+    int64_t ts(int i) const { return baseTsMs + tsOffset[i]; }
+
+    int64_t baseTsMs;   // 块内最小时间戳（只接收不早于它的行）
+    int64_t maxTsMs;
+    int count = 0;
+    uint32_t tsOffset[CHUNK_ROWS];
+    int32_t id[CHUNK_ROWS];
+    int32_t airTemp[CHUNK_ROWS];
+    int32_t airHumid[CHUNK_ROWS];
+    int32_t soilHumid[CHUNK_ROWS];
+    int32_t lightIntensity[CHUNK_ROWS];
+};
+
+namespace {
+
+int64_t wallClockMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int64_t ceilToSecond(int64_t ms) {
+    return ms <= 0 ? 0 : (ms + 999) / 1000 * 1000;
+}
+
+Gauge& rowsGauge() {
+    static Gauge& g = Metrics::gauge("gh_hot_cache_rows", "Rows held by the in-memory hot tier");
+    return g;
+}
+
+Counter& servedCounter() {
+    static Counter& c = Metrics::counter("gh_hot_cache_rows_served", "History rows served from the hot tier instead of disk");
+    return c;
+}
+
+struct HotRow {
+    int64_t tsMs;
+    int32_t id;
+    int32_t airTemp;
+    int32_t airHumid;
+    int32_t soilHumid;
+    int32_t lightIntensity;
+};
+
+} // namespace
+
+// ========================================
+// 生命周期
+// ========================================
+
+HotTierCache::HotTierCache()
+{
+    // 先构造连接管理器，保证它晚于缓存析构（退出时加载线程可能还在借用读连接）
+    ConnectionManager::instance();
+}
+
+HotTierCache::~HotTierCache()
+{
+    stop();
+}
+
+HotTierCache& HotTierCache::instance()
+{
+    static HotTierCache cache;
+    return cache;
+}
+
+void HotTierCache::start(int windowHours)
+{
+    restartLoader(windowHours > 0 ? static_cast<int64_t>(windowHours) * 3600 * 1000 : 0);
+}
+
+void HotTierCache::reload()
+{
+    int64_t windowMs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state == State::Disabled) return;
+        windowMs = m_windowMs;
+    }
+    restartLoader(windowMs);
+}
+
+void HotTierCache::stop()
+{
+    restartLoader(0);
+}
+
+void HotTierCache::restartLoader(int64_t windowMs)
+{
+    std::lock_guard<std::mutex> loaderLock(m_loaderMutex);
+
+    uint64_t generation;
+    int64_t hotStartMs = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        generation = ++m_generation;
+        m_windowMs = windowMs;
+        m_devices.clear();
+        m_pending.clear();
+        m_rows = 0;
+        m_state = windowMs > 0 ? State::Loading : State::Disabled;
+        if (windowMs > 0) {
+            hotStartMs = ceilToSecond(wallClockMs() - windowMs);
+            m_hotStartMs = hotStartMs;
+        }
+        publishRowsLocked();
+    }
+
+    // 旧的加载线程看到 generation 变化后会尽快结束
+    if (m_loader.joinable()) m_loader.join();
+    if (windowMs > 0) {
+        m_loader = std::thread(&HotTierCache::loadFromDisk, this, generation, hotStartMs);
+    }
+}
+
+// ========================================
+// 加载
+// ========================================
+
+void HotTierCache::loadFromDisk(uint64_t generation, int64_t hotStartMs)
+{
+    const auto started = std::chrono::steady_clock::now();
+
+    char sinceBuf[TimerUtil::RECORD_TIME_SIZE];
+    TimerUtil::formatRecordTime(hotStartMs, sinceBuf);
+
+    // 一条 SELECT 读到的是同一个快照；快照之后提交的行都在 m_pending 中，id 大于快照内的所有行
+    DeviceMap devices;
+    int64_t rows = 0;
+    int64_t maxId = 0;
+    const int64_t scanned = Database::instance().scanSamplesSince(sinceBuf,
+        [&](int64_t id, const SensorSample& sample) {
+            if (m_generation.load(std::memory_order_relaxed) != generation) return false;
+            appendTo(devices, id, sample);
+            ++rows;
+            maxId = std::max(maxId, id);
+            return true;
+        });
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_generation.load(std::memory_order_relaxed) != generation) return;   // 已被重新加载或停用取代
+    if (scanned < 0) {
+        LOG_WARN("热数据缓存加载失败，历史查询全部走磁盘");
+        m_state = State::Disabled;
+        m_pending.clear();
+        return;
+    }
+
+    m_devices.swap(devices);
+    m_rows = rows;
+    for (const auto& entry : m_pending) {
+        if (entry.first <= maxId) continue;
+        appendTo(m_devices, entry.first, entry.second);
+        ++m_rows;
+    }
+    m_pending.clear();
+    m_pending.shrink_to_fit();
+    m_state = State::Ready;
+    evictLocked();
+
+    const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started).count();
+    LOG_INFO("热数据缓存加载完成: {} 行，{} 个设备，起点 {}，耗时 {} ms",
+             m_rows, m_devices.size(), sinceBuf, static_cast<int64_t>(elapsedMs));
+}
+
+// ========================================
+// 写入 / 删除
+// ========================================
+
+void HotTierCache::append(int64_t id, const SensorSample& sample)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    switch (m_state) {
+    case State::Disabled:
+        return;
+    case State::Loading:
+        m_pending.emplace_back(id, sample);
+        return;
+    case State::Ready:
+        break;
+    }
+
+    const bool chunkFull = appendTo(m_devices, id, sample);
+    ++m_rows;
+    // 每写满一块检查一次窗口
+    if (chunkFull) evictLocked();
+    else rowsGauge().set(m_rows);
+}
+
+bool HotTierCache::appendTo(DeviceMap& devices, int64_t id, const SensorSample& sample)
+{
+    Series& series = devices[sample.deviceId];
+    if (series.empty() || !series.back()->accepts(sample.tsMs)) {
+        series.emplace_back(new Chunk(sample.tsMs));
+    }
+    Chunk& chunk = *series.back();
+    chunk.push(id, sample);
+    return chunk.count == CHUNK_ROWS;
+}
+
+void HotTierCache::erase(int64_t fromMs, int64_t toMs)
+{
+    bool needReload = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state == State::Loading) {
+            // 快照可能在删除之前读取，直接重新加载
+            needReload = true;
+        } else if (m_state == State::Ready) {
+            for (auto& device : m_devices) {
+                Series& series = device.second;
+                const bool overlaps = std::any_of(series.begin(), series.end(), [&](const std::unique_ptr<Chunk>& chunk) {
+                    return chunk->baseTsMs <= toMs && chunk->maxTsMs >= fromMs;
+                });
+                if (!overlaps) continue;
+
+                // 删除很少发生：把保留的行重新写入新块
+                DeviceMap rebuilt;
+                SensorSample sample;
+                sample.deviceId = device.first;
+                sample.flags = SAMPLE_VALID;
+                for (const auto& chunk : series) {
+                    for (int i = 0; i < chunk->count; ++i) {
+                        sample.tsMs = chunk->ts(i);
+                        if (sample.tsMs >= fromMs && sample.tsMs <= toMs) {
+                            --m_rows;
+                            continue;
+                        }
+                        sample.airTemp = chunk->airTemp[i];
+                        sample.airHumid = chunk->airHumid[i];
+                        sample.soilHumid = chunk->soilHumid[i];
+                        sample.lightIntensity = chunk->lightIntensity[i];
+                        appendTo(rebuilt, chunk->id[i], sample);
+                    }
+                }
+                series.swap(rebuilt[device.first]);
+            }
+            publishRowsLocked();
+        }
+    }
+    if (needReload) reload();
+}
+
+void HotTierCache::evictLocked()
+{
+    const int64_t cutoff = wallClockMs() - m_windowMs;
+    for (auto it = m_devices.begin(); it != m_devices.end();) {
+        Series& series = it->second;
+        while (!series.empty() && series.front()->maxTsMs < cutoff) {
+            m_rows -= series.front()->count;
+            series.pop_front();
+        }
+        it = series.empty() ? m_devices.erase(it) : std::next(it);
+    }
+    // 被淘汰的块整块早于 cutoff，cutoff 之后的行仍全部在缓存中
+    m_hotStartMs = std::max(m_hotStartMs, ceilToSecond(cutoff));
+    publishRowsLocked();
+}
+
+void HotTierCache::publishRowsLocked()
+{
+    rowsGauge().set(m_rows);
+}
+
+// ========================================
+// 查询
+// ========================================
+
+int64_t HotTierCache::query(int64_t fromMs, int64_t toMs, std::vector<SensorRecord>& out)
+{
+    std::vector<HotRow> hits;
+    int64_t hotStartMs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state != State::Ready) return -1;
+        hotStartMs = m_hotStartMs;
+
+        const int64_t from = std::max(fromMs, hotStartMs);
+        for (const auto& device : m_devices) {
+            for (const auto& chunk : device.second) {
+                if (chunk->baseTsMs > toMs || chunk->maxTsMs < from) continue;
+                for (int i = 0; i < chunk->count; ++i) {
+                    const int64_t ts = chunk->ts(i);
+                    if (ts < from || ts > toMs) continue;
+                    hits.push_back({ts, chunk->id[i], chunk->airTemp[i], chunk->airHumid[i],
+                                    chunk->soilHumid[i], chunk->lightIntensity[i]});
+                }
+            }
+        }
+    }
+
+    // 与 record_time 索引的顺序一致；单设备顺序写入时已经有序
+    auto byTime = [](const HotRow& a, const HotRow& b) {
+        return a.tsMs != b.tsMs ? a.tsMs < b.tsMs : a.id < b.id;
+    };
+    if (!std::is_sorted(hits.begin(), hits.end(), byTime)) {
+        std::sort(hits.begin(), hits.end(), byTime);
+    }
+
+    // 同一分钟内只改写秒数，每分钟格式化一次本地时间
+    char timeBuf[TimerUtil::RECORD_TIME_SIZE];
+    int64_t minuteSecs = -1;
+    out.reserve(out.size() + hits.size());
+    for (const HotRow& hit : hits) {
+        const int64_t secs = hit.tsMs / 1000;
+        if (secs - secs % 60 != minuteSecs) {
+            minuteSecs = secs - secs % 60;
+            TimerUtil::formatRecordTime(minuteSecs * 1000, timeBuf);
+        }
+        const int second = static_cast<int>(secs - minuteSecs);
+        timeBuf[17] = static_cast<char>('0' + second / 10);
+        timeBuf[18] = static_cast<char>('0' + second % 10);
+
+        SensorRecord record;
+        record.id = hit.id;
+        record.record_time.assign(timeBuf, TimerUtil::RECORD_TIME_SIZE - 1);
+        record.air_temp = hit.airTemp;
+        record.air_humid = hit.airHumid;
+        record.soil_humid = hit.soilHumid;
+        record.light_intensity = hit.lightIntensity;
+        out.push_back(std::move(record));
+    }
+    servedCounter().inc(hits.size());
+    return hotStartMs;
+}
+
+bool HotTierCache::isReady() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_state == State::Ready;
+}
+
+int64_t HotTierCache::rows() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_rows;
+}
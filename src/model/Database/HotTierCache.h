@@ -0,0 +1,108 @@
+#ifndef HOTTIERCACHE_H
+#define HOTTIERCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "model/SensorData.h"
+
+/**
+ * @brief green_data 最近一段时间（默认 48 小时）的内存热数据层
+ *
+ * 每个设备一串定长列式块：时间戳存相对块首的毫秒偏移（uint32），id 与 4 个读数各一列，
+ * 每行 24 字节，48 小时 1 Hz 采样约 4 MB / 设备。
+ *
+ * - 数据来源：启动时后台线程从磁盘加载窗口内的行；之后由写线程在每行插入成功后追加，
+ *   与数据库保持一致（加载期间的追加先暂存，加载完成后按 id 去掉快照中已有的行）
+ * - 覆盖范围：ts >= hotStartMs() 的行全部在缓存中；hotStartMs 对齐到整秒，
+ *   与 record_time（精确到秒）的区间一一对应。旧块按窗口淘汰时只会把起点往后推
+ * - Database::queryByTime 与缓存重叠的部分从内存取，只对更早的部分查询磁盘
+ *
+ * 绕过写线程追加的批量写入（导入）结束后调用 reload() 重新加载。
+ * 除 append 在写线程上调用外，其余接口可在任意线程调用。
+ */
+class HotTierCache
+{
+public:
+    static constexpr int CHUNK_ROWS = 4096;
+    static constexpr int DEFAULT_WINDOW_HOURS = 48;
+
+    static HotTierCache& instance();
+
+    /**
+     * @brief 设置窗口并在后台从磁盘加载，加载完成前查询全部走磁盘
+     * @param windowHours 窗口小时数，<= 0 表示停用（释放内存）
+     */
+    void start(int windowHours);
+
+    /**
+     * @brief 丢弃内存中的数据并重新加载（未启用时不做任何事）
+     */
+    void reload();
+
+    /**
+     * @brief 停用并等待后台加载线程结束（程序退出前、关闭数据库之前调用）
+     */
+    void stop();
+
+    /**
+     * @brief 记录一行刚插入 green_data 的样本（写线程上、插入所在事务提交后调用）
+     */
+    void append(int64_t id, const SensorSample& sample);
+
+    /**
+     * @brief 删除 ts 落在 [fromMs, toMs] 内的行（与数据库删除保持一致）
+     */
+    void erase(int64_t fromMs, int64_t toMs);
+
+    /**
+     * @brief 取出 ts 落在 [max(fromMs, hotStartMs), toMs] 内的行，按 (ts, id) 升序追加到 out
+     * @return 本次使用的 hotStartMs；缓存未就绪时返回 -1，out 不变
+     */
+    int64_t query(int64_t fromMs, int64_t toMs, std::vector<SensorRecord>& out);
+
+    bool isReady() const;
+    int64_t rows() const;
+
+private:
+    struct Chunk;
+    using Series = std::deque<std::unique_ptr<Chunk>>;
+    using DeviceMap = std::map<int32_t, Series>;
+
+    enum class State {
+        Disabled,
+        Loading,
+        Ready
+    };
+
+    HotTierCache();
+    ~HotTierCache();
+
+    void restartLoader(int64_t windowMs);
+    void loadFromDisk(uint64_t generation, int64_t hotStartMs);
+    // 返回 true 表示这一行写满了当前块
+    static bool appendTo(DeviceMap& devices, int64_t id, const SensorSample& sample);
+    void evictLocked();
+    void publishRowsLocked();
+
+    mutable std::mutex m_mutex;
+    State m_state = State::Disabled;
+    int64_t m_windowMs = 0;
+    int64_t m_hotStartMs = 0;
+    int64_t m_rows = 0;
+    DeviceMap m_devices;
+    std::vector<std::pair<int64_t, SensorSample>> m_pending;   // 加载期间写入的行
+
+    std::atomic<uint64_t> m_generation{0};                     // 每次重新加载加一，旧的加载线程据此放弃
+    std::mutex m_loaderMutex;
+    std::thread m_loader;
+};
+
+#endif // HOTTIERCACHE_H
@@ -0,0 +1,418 @@
+#include "SchemaMigrations.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConnectionManager.h"
+#include "untils/Log.h"
+#include "untils/Metrics.h"
+
+namespace {
+
+// ========================================
+// 迁移步骤
+// ========================================
+
+bool execAll(SqliteConnection& conn, std::initializer_list<const char*> statements) {
+    for (const char* sql : statements) {
+        if (!conn.exec(sql)) return false;
+    }
+    return true;
+}
+
+bool hasColumn(SqliteConnection& conn, const char* table, const char* column) {
+    SqliteStatement* stmt = conn.prepare("SELECT 1 FROM pragma_table_info(?1) WHERE name = ?2");
+    if (!stmt) return false;
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, table, -1);
+    stmt->bind(2, column, -1);
+    return stmt->step() == SQLITE_ROW;
+}
+
+// v1：green_data 及 record_time 索引（与原 sync_schema 建出的表结构一致，已有的表保持不变）
+bool migrateGreenData(SqliteConnection& conn) {
+    return execAll(conn, {
+        "CREATE TABLE IF NOT EXISTS green_data ("
+        " \"id\" INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL,"
+        " \"record_time\" TEXT NOT NULL,"
+        " \"air_temp\" INTEGER NOT NULL,"
+        " \"air_humid\" INTEGER NOT NULL,"
+        " \"soil_humid\" INTEGER NOT NULL,"
+        " \"light_intensity\" INTEGER NOT NULL)",
+        "CREATE INDEX IF NOT EXISTS idx_green_data_record_time ON green_data(record_time)"
+    });
+}
+
+// v2：用户表、执行器状态表（原先由 Person / ActuatorState 各自 sync_schema）
+bool migrateUserAndActuatorTables(SqliteConnection& conn) {
+    return execAll(conn, {
+        "CREATE TABLE IF NOT EXISTS Persons ("
+        " \"id\" INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL,"
+        " \"username\" TEXT NOT NULL,"
+        " \"password\" TEXT NOT NULL)",
+        "CREATE TABLE IF NOT EXISTS actuator_states ("
+        " \"id\" INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL,"
+        " \"fan\" INTEGER NOT NULL,"
+        " \"water_pump\" INTEGER NOT NULL,"
+        " \"light_bulb\" INTEGER NOT NULL,"
+        " \"StartTime\" TEXT NOT NULL,"
+        " \"EndTime\" TEXT NOT NULL)"
+    });
+}
+
+// v3：green_data 增加 ts_ms（Unix 毫秒）与 device_id。
+// ADD COLUMN 只改表定义，不改写已有行；旧行的 ts_ms 为 NULL，由回填任务按 record_time 补算
+bool migrateSampleKeys(SqliteConnection& conn) {
+    if (!hasColumn(conn, "green_data", "ts_ms")
+        && !conn.exec("ALTER TABLE green_data ADD COLUMN ts_ms INTEGER")) {
+        return false;
+    }
+    if (!hasColumn(conn, "green_data", "device_id")
+        && !conn.exec("ALTER TABLE green_data ADD COLUMN device_id INTEGER NOT NULL DEFAULT 0")) {
+        return false;
+    }
+    // 只需回填迁移时已存在的行，之后的新行在插入时即写入 ts_ms
+    return execAll(conn, {
+        "CREATE TABLE IF NOT EXISTS schema_backfill ("
+        " name TEXT PRIMARY KEY,"
+        " next_id INTEGER NOT NULL,"
+        " end_id INTEGER NOT NULL)",
+        "INSERT OR IGNORE INTO schema_backfill(name, next_id, end_id)"
+        " SELECT 'green_data.ts_ms', 1, IFNULL(MAX(id), 0) FROM green_data"
+    });
+}
+
+// v4：执行器每日统计汇总表（原先由 ActuatorAnalyticsViewModel 构造时建表）
+bool migrateActuatorRollup(SqliteConnection& conn) {
+    return execAll(conn, {
+        "CREATE TABLE IF NOT EXISTS actuator_daily_rollup ("
+        " day TEXT NOT NULL,"
+        " zone INTEGER NOT NULL DEFAULT 0,"
+        " covered_secs INTEGER NOT NULL DEFAULT 0,"
+        " fan_on_secs INTEGER NOT NULL DEFAULT 0,"
+        " pump_on_secs INTEGER NOT NULL DEFAULT 0,"
+        " lamp_on_secs INTEGER NOT NULL DEFAULT 0,"
+        " fan_switches INTEGER NOT NULL DEFAULT 0,"
+        " pump_switches INTEGER NOT NULL DEFAULT 0,"
+        " lamp_switches INTEGER NOT NULL DEFAULT 0,"
+        " fan_wh REAL NOT NULL DEFAULT 0,"
+        " pump_wh REAL NOT NULL DEFAULT 0,"
+        " lamp_wh REAL NOT NULL DEFAULT 0,"
+        " PRIMARY KEY(day, zone))"
+    });
+}
+
+// v5：执行器区间的 R*Tree 索引（原先在 ActuatorState 构造时建表并同步补建索引）。
+// 已有区间的索引登记为回填任务，新区间在插入时写入索引
+bool migrateActuatorRtree(SqliteConnection& conn) {
+    return execAll(conn, {
+        "CREATE VIRTUAL TABLE IF NOT EXISTS actuator_states_rtree USING rtree_i32(id, start_epoch, end_epoch)",
+        "INSERT OR IGNORE INTO schema_backfill(name, next_id, end_id)"
+        " SELECT 'actuator_states_rtree', 1, IFNULL(MAX(id), 0) FROM actuator_states"
+    });
+}
+
+// v6：异常事件表（原先由 AnomalyEventStore 构造时建表）
+bool migrateAnomalyEvents(SqliteConnection& conn) {
+    return execAll(conn, {
+        "CREATE TABLE IF NOT EXISTS anomaly_events ("
+        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        " ts_ms INTEGER NOT NULL,"
+        " zone INTEGER NOT NULL DEFAULT 0,"
+        " channel INTEGER NOT NULL,"
+        " kind INTEGER NOT NULL,"
+        " value REAL NOT NULL,"
+        " score REAL NOT NULL DEFAULT 0)",
+        "CREATE INDEX IF NOT EXISTS idx_anomaly_events_ts ON anomaly_events(ts_ms)"
+    });
+}
+
+struct Migration {
+    int version;
+    const char* description;
+    bool (*apply)(SqliteConnection& conn);
+};
+
+const Migration kMigrations[] = {
+    {1, "green_data 表与 record_time 索引", migrateGreenData},
+    {2, "Persons / actuator_states 表", migrateUserAndActuatorTables},
+    {3, "green_data 增加 ts_ms / device_id", migrateSampleKeys},
+    {4, "actuator_daily_rollup 表", migrateActuatorRollup},
+    {5, "actuator_states_rtree 索引", migrateActuatorRtree},
+    {6, "anomaly_events 表", migrateAnomalyEvents},
+};
+
+static_assert(sizeof(kMigrations) / sizeof(kMigrations[0]) == SchemaMigrations::LATEST_VERSION,
+              "每个版本对应一个迁移");
+
+int readUserVersion(SqliteConnection& conn) {
+    SqliteStatement* stmt = conn.prepare("PRAGMA user_version");
+    if (!stmt) return -1;
+    SqliteStatementScope scope(*stmt);
+    return stmt->step() == SQLITE_ROW ? stmt->columnInt(0) : -1;
+}
+
+bool writeUserVersion(SqliteConnection& conn, int version) {
+    // PRAGMA 不支持参数绑定
+    const std::string sql = "PRAGMA user_version = " + std::to_string(version);
+    return conn.exec(sql.c_str());
+}
+
+// ========================================
+// 回填任务
+// ========================================
+
+struct BackfillJob {
+    const char* name;
+    const char* stepSql;    // ?1 = 起始 id（含），?2 = 结束 id（不含）
+};
+
+// record_time 是本地时间，'utc' 修饰符把它换算为 UTC 后再取 epoch 秒
+const BackfillJob kBackfillJobs[] = {
+    {"green_data.ts_ms",
+     "UPDATE green_data SET ts_ms = CAST(strftime('%s', record_time, 'utc') AS INTEGER) * 1000"
+     " WHERE id >= ?1 AND id < ?2 AND ts_ms IS NULL"},
+    // StartTime / EndTime 同为本地时间；EndTime 为空或早于开始时按开始时间，区间上界不超过 int32
+    {"actuator_states_rtree",
+     "INSERT OR REPLACE INTO actuator_states_rtree(id, start_epoch, end_epoch)"
+     " SELECT id, MIN(MAX(s, 0), 2147483647), MIN(MAX(IFNULL(e, s), s, 0), 2147483647) FROM ("
+     "  SELECT id, CAST(strftime('%s', StartTime, 'utc') AS INTEGER) AS s,"
+     "   CAST(strftime('%s', NULLIF(EndTime, ''), 'utc') AS INTEGER) AS e"
+     "  FROM actuator_states WHERE id >= ?1 AND id < ?2"
+     "   AND id NOT IN (SELECT id FROM actuator_states_rtree))"
+     " WHERE s IS NOT NULL"},
+};
+
+const BackfillJob* findBackfillJob(const std::string& name) {
+    for (const BackfillJob& job : kBackfillJobs) {
+        if (name == job.name) return &job;
+    }
+    return nullptr;
+}
+
+Gauge& backfillRemaining() {
+    static Gauge& g = Metrics::gauge("gh_schema_backfill_remaining", "Rows left to backfill after schema migrations");
+    return g;
+}
+
+void runBackfillStep(const BackfillJob* job, int attempt = 0);
+
+/**
+ * @brief 回填失败后延迟重试
+ *
+ * 写线程上不能等待，由单独的线程计时，到期后把回填重新排入写队列；间隔按失败次数加倍，
+ * 上限 BACKFILL_RETRY_MAX_MS。首次失败时才创建，晚于 ConnectionManager 构造，
+ * 因此先于它析构（析构时停止并 join 计时线程）。
+ */
+class BackfillRetry
+{
+public:
+    static BackfillRetry& instance() {
+        static BackfillRetry retry;
+        return retry;
+    }
+
+    void schedule(const BackfillJob* job, int attempt) {
+        const int64_t delayMs = std::min<int64_t>(BACKFILL_RETRY_BASE_MS << std::min(attempt - 1, 16),
+                                                  BACKFILL_RETRY_MAX_MS);
+        LOG_WARN("回填 {} 将在 {} ms 后重试（第 {} 次）", job->name, delayMs, attempt);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_stopping) return;
+            m_pending.push_back(Pending{job, attempt, Clock::now() + std::chrono::milliseconds(delayMs)});
+            if (!m_thread.joinable()) m_thread = std::thread(&BackfillRetry::run, this);
+        }
+        m_cv.notify_one();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending {
+        const BackfillJob* job;
+        int attempt;
+        Clock::time_point due;
+    };
+
+    static constexpr int64_t BACKFILL_RETRY_BASE_MS = 1000;
+    static constexpr int64_t BACKFILL_RETRY_MAX_MS = 60000;
+
+    ~BackfillRetry() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_cv.notify_all();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stopping) {
+            if (m_pending.empty()) {
+                m_cv.wait(lock);
+                continue;
+            }
+            auto next = std::min_element(m_pending.begin(), m_pending.end(), [](const Pending& a, const Pending& b) {
+                return a.due < b.due;
+            });
+            if (Clock::now() < next->due) {
+                m_cv.wait_until(lock, next->due);
+                continue;
+            }
+            const Pending due = *next;
+            m_pending.erase(next);
+            lock.unlock();
+            runBackfillStep(due.job, due.attempt);
+            lock.lock();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<Pending> m_pending;
+    std::thread m_thread;
+    bool m_stopping = false;
+};
+
+/**
+ * @brief 执行一段回填（写线程上），事务提交后再把下一段排入写队列
+ *
+ * 段的处理与断点更新在同一个事务中提交，程序在任意时刻退出都不会漏掉或重复处理。
+ * 语句执行失败或事务提交失败时，由 BackfillRetry 延迟后从断点重试。
+ */
+void runBackfillStep(const BackfillJob* job, int attempt) {
+    enum class StepResult { NotRun, Continue, Finished, Failed };
+    auto result = std::make_shared<StepResult>(StepResult::NotRun);
+
+    ConnectionManager::instance().post([job, result](SqliteConnection& conn) {
+        *result = StepResult::Failed;
+        int64_t nextId = 0;
+        int64_t endId = 0;
+        {
+            SqliteStatement* cursor = conn.prepare("SELECT next_id, end_id FROM schema_backfill WHERE name = ?1");
+            if (!cursor) return;
+            SqliteStatementScope scope(*cursor);
+            cursor->bind(1, job->name, -1);
+            if (cursor->step() != SQLITE_ROW) {   // 已完成
+                *result = StepResult::Finished;
+                return;
+            }
+            nextId = cursor->columnInt64(0);
+            endId = cursor->columnInt64(1);
+        }
+
+        const int64_t upper = std::min(nextId + SchemaMigrations::BACKFILL_BATCH_ROWS, endId + 1);
+        SqliteStatement* step = conn.prepare(job->stepSql);
+        if (!step) return;
+        {
+            SqliteStatementScope scope(*step);
+            step->bind(1, nextId);
+            step->bind(2, upper);
+            if (step->step() != SQLITE_DONE) {
+                LOG_ERROR("回填 {} 失败（id {}）：{}", job->name, nextId, conn.lastError());
+                return;
+            }
+        }
+
+        const bool finished = upper > endId;
+        SqliteStatement* save = conn.prepare(finished
+            ? "DELETE FROM schema_backfill WHERE name = ?1"
+            : "UPDATE schema_backfill SET next_id = ?2 WHERE name = ?1");
+        if (!save) return;
+        {
+            SqliteStatementScope scope(*save);
+            save->bind(1, job->name, -1);
+            if (!finished) save->bind(2, upper);
+            if (save->step() != SQLITE_DONE) return;
+        }
+
+        backfillRemaining().set(finished ? 0 : endId - upper + 1);
+        *result = finished ? StepResult::Finished : StepResult::Continue;
+    }, [job, attempt, result](bool committed) {
+        // 任务未执行：数据库已关闭，下次启动从断点继续
+        if (*result == StepResult::NotRun) return;
+        if (!committed || *result == StepResult::Failed) {
+            BackfillRetry::instance().schedule(job, attempt + 1);
+        } else if (*result == StepResult::Continue) {
+            runBackfillStep(job);
+        } else {
+            LOG_INFO("回填 {} 完成", job->name);
+        }
+    });
+}
+
+struct MigrationOutcome {
+    int version = -1;
+    std::vector<std::string> pendingBackfills;
+};
+
+// 写线程上执行：依次应用尚未执行的迁移，每个迁移包在一个保存点中
+MigrationOutcome migrate(SqliteConnection& conn) {
+    MigrationOutcome outcome;
+    outcome.version = readUserVersion(conn);
+    if (outcome.version < 0) return outcome;
+
+    for (const Migration& m : kMigrations) {
+        if (m.version <= outcome.version) continue;
+
+        conn.exec("SAVEPOINT schema_migration");
+        if (!m.apply(conn) || !writeUserVersion(conn, m.version)) {
+            conn.exec("ROLLBACK TO schema_migration");
+            conn.exec("RELEASE schema_migration");
+            LOG_ERROR("数据库迁移到版本 {}（{}）失败：{}", m.version, m.description, conn.lastError());
+            break;
+        }
+        conn.exec("RELEASE schema_migration");
+        outcome.version = m.version;
+        LOG_INFO("数据库已迁移到版本 {}：{}", m.version, m.description);
+    }
+
+    if (outcome.version >= 3) {
+        SqliteStatement* stmt = conn.prepare("SELECT name FROM schema_backfill");
+        if (stmt) {
+            SqliteStatementScope scope(*stmt);
+            while (stmt->step() == SQLITE_ROW) {
+                outcome.pendingBackfills.push_back(stmt->columnText(0));
+            }
+        }
+    }
+    return outcome;
+}
+
+} // namespace
+
+int SchemaMigrations::ensureLatest() {
+    static std::once_flag once;
+    static int version = -1;
+    std::call_once(once, []() {
+        MigrationOutcome outcome;
+        try {
+            outcome = ConnectionManager::instance().submit([](SqliteConnection& conn) {
+                return migrate(conn);
+            }).get();
+        } catch (const std::exception& e) {
+            LOG_ERROR("数据库迁移事务提交失败：{}", e.what());
+            return;
+        }
+        version = outcome.version;
+
+        for (const std::string& name : outcome.pendingBackfills) {
+            const BackfillJob* job = findBackfillJob(name);
+            if (!job) {
+                LOG_WARN("未知的回填任务：{}", name);
+                continue;
+            }
+            LOG_INFO("开始回填 {}", name);
+            runBackfillStep(job);
+        }
+    });
+    return version;
+}
@@ -0,0 +1,38 @@
+#ifndef SCHEMAMIGRATIONS_H
+#define SCHEMAMIGRATIONS_H
+
+#include <cstdint>
+
+/**
+ * @brief green-house.db 的版本化表结构迁移
+ *
+ * 版本号记录在 PRAGMA user_version。打开数据库时只读取版本号：已是最新版本时不做任何表结构检查；
+ * 否则按顺序执行尚未执行的迁移，每个迁移和新版本号在同一个写事务中提交（失败时回滚到迁移前）。
+ *
+ * 迁移只包含与表大小无关的步骤（建表、ADD COLUMN、登记回填任务）。需要逐行处理的工作
+ * （如为旧数据补算新增的列）登记为回填任务，在写线程上按 id 分段执行：每段一个写任务，
+ * 与采集写入交替提交，不会长时间占用写连接；进度保存在 schema_backfill 表中，
+ * 程序中途退出后下次启动从断点继续。
+ *
+ * 取代 Database / ActuatorState / Person 各自在构造时调用 sqlite_orm 的 sync_schema
+ * （列定义与代码不一致时会整表复制重建，大表上耗时很长），以及其他模块构造时的建表语句；
+ * 新增表结构一律追加新的版本。
+ */
+class SchemaMigrations
+{
+public:
+    static constexpr int LATEST_VERSION = 6;
+
+    /// 每个回填写任务处理的 id 段长度
+    static constexpr int64_t BACKFILL_BATCH_ROWS = 5000;
+
+    /**
+     * @brief 把数据库升级到最新版本，并恢复未完成的回填任务
+     *
+     * 进程内只执行一次，可在任意线程调用；阻塞到迁移事务提交（回填在后台继续）。
+     * @return 迁移后的版本号（某个迁移失败时小于 LATEST_VERSION）
+     */
+    static int ensureLatest();
+};
+
+#endif // SCHEMAMIGRATIONS_H
@@ -0,0 +1,95 @@
+#include "SqliteConnection.h"
+
+#include <cstring>
+#include <iostream>
+
+// ========================================
+// SqliteStatement
+// ========================================
+
+SqliteStatement::SqliteStatement(sqlite3* db, const std::string& sql)
+    : m_sql(sql) {
+    // SQLITE_PREPARE_PERSISTENT：提示 sqlite 该语句会长期复用
+    if (sqlite3_prepare_v3(db, sql.c_str(), static_cast<int>(sql.size()),
+                           SQLITE_PREPARE_PERSISTENT, &m_stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "SQL 编译失败: " << sqlite3_errmsg(db) << " [" << sql << "]" << std::endl;
+        sqlite3_finalize(m_stmt);
+        m_stmt = nullptr;
+    }
+}
+
+SqliteStatement::~SqliteStatement() {
+    sqlite3_finalize(m_stmt);
+}
+
+// ========================================
+// SqliteConnection
+// ========================================
+
+SqliteConnection::~SqliteConnection() {
+    close();
+}
+
+bool SqliteConnection::open(const std::string& path, int flags) {
+    close();
+    if (sqlite3_open_v2(path.c_str(), &m_db, flags, nullptr) != SQLITE_OK) {
+        std::cerr << "打开数据库失败: " << path << " " << sqlite3_errmsg(m_db) << std::endl;
+        sqlite3_close(m_db);
+        m_db = nullptr;
+        return false;
+    }
+    // 与 sqlite_orm 的连接并存时，遇到锁等待一段时间而不是立即失败
+    sqlite3_busy_timeout(m_db, 5000);
+    return true;
+}
+
+void SqliteConnection::close() {
+    // 语句必须先于连接释放
+    m_byAddress.clear();
+    m_statements.clear();
+    if (m_db) {
+        sqlite3_close(m_db);
+        m_db = nullptr;
+    }
+}
+
+bool SqliteConnection::exec(const char* sql) {
+    if (!m_db) return false;
+    char* errmsg = nullptr;
+    if (sqlite3_exec(m_db, sql, nullptr, nullptr, &errmsg) != SQLITE_OK) {
+        std::cerr << "SQL 执行失败: " << (errmsg ? errmsg : "") << " [" << sql << "]" << std::endl;
+        sqlite3_free(errmsg);
+        return false;
+    }
+    return true;
+}
+
+SqliteStatement* SqliteConnection::prepare(const std::string& sql) {
+    if (!m_db) return nullptr;
+
+    auto it = m_statements.find(sql);
+    if (it != m_statements.end()) return it->second.get();
+
+    std::unique_ptr<SqliteStatement> stmt(new SqliteStatement(m_db, sql));
+    if (!stmt->isValid()) return nullptr;
+
+    SqliteStatement* raw = stmt.get();
+    m_statements.emplace(sql, std::move(stmt));
+    return raw;
+}
+
+SqliteStatement* SqliteConnection::prepare(const char* sql) {
+    if (!m_db || !sql) return nullptr;
+
+    // 热路径传入的都是同一个常量地址；再比较一次内容，防止缓冲区地址被其他 SQL 复用
+    auto it = m_byAddress.find(sql);
+    if (it != m_byAddress.end() && std::strcmp(it->second->sql().c_str(), sql) == 0) return it->second;
+
+    SqliteStatement* stmt = prepare(std::string(sql));
+    if (stmt) m_byAddress[sql] = stmt;
+    return stmt;
+}
+
+std::string SqliteConnection::lastError() const {
+    return m_db ? sqlite3_errmsg(m_db) : "database not open";
+}
@@ -0,0 +1,148 @@
+#ifndef SQLITECONNECTION_H
+#define SQLITECONNECTION_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "sqlite3.h"
+
+/**
+ * @brief 预编译语句（sqlite3_stmt 的 RAII 封装）
+ *
+ * 由 SqliteConnection::prepare 创建并缓存，调用方不负责释放。
+ * 参数下标、列下标与 sqlite3 一致：bind 从 1 开始，column 从 0 开始。
+ */
+class SqliteStatement
+{
+public:
+    SqliteStatement(sqlite3* db, const std::string& sql);
+    ~SqliteStatement();
+
+    SqliteStatement(const SqliteStatement&) = delete;
+    SqliteStatement& operator=(const SqliteStatement&) = delete;
+
+    bool isValid() const { return m_stmt != nullptr; }
+    const std::string& sql() const { return m_sql; }
+
+    // ---------- 绑定参数 ----------
+    bool bind(int index, int value) { return sqlite3_bind_int(m_stmt, index, value) == SQLITE_OK; }
+    bool bind(int index, int64_t value) { return sqlite3_bind_int64(m_stmt, index, value) == SQLITE_OK; }
+    bool bind(int index, double value) { return sqlite3_bind_double(m_stmt, index, value) == SQLITE_OK; }
+    /// 文本不拷贝（SQLITE_STATIC），调用方需保证在 step/reset 之前字符串有效
+    bool bind(int index, const std::string& value) {
+        return sqlite3_bind_text(m_stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC) == SQLITE_OK;
+    }
+    /// text 在 step() 之前必须保持有效
+    bool bind(int index, const char* text, int length) {
+        return sqlite3_bind_text(m_stmt, index, text, length, SQLITE_STATIC) == SQLITE_OK;
+    }
+
+    /**
+     * @brief 执行一步
+     * @return SQLITE_ROW / SQLITE_DONE / 错误码
+     */
+    int step() { return sqlite3_step(m_stmt); }
+
+    /**
+     * @brief 重置语句并清除绑定，供下次复用
+     */
+    void reset() {
+        sqlite3_reset(m_stmt);
+        sqlite3_clear_bindings(m_stmt);
+    }
+
+    // ---------- 读取列 ----------
+    int columnInt(int col) const { return sqlite3_column_int(m_stmt, col); }
+    int64_t columnInt64(int col) const { return sqlite3_column_int64(m_stmt, col); }
+    double columnDouble(int col) const { return sqlite3_column_double(m_stmt, col); }
+    std::string columnText(int col) const {
+        const unsigned char* text = sqlite3_column_text(m_stmt, col);
+        return text ? std::string(reinterpret_cast<const char*>(text),
+                                  static_cast<std::size_t>(sqlite3_column_bytes(m_stmt, col)))
+                    : std::string();
+    }
+    /// 不复制的文本列，指针在下一次 step / reset 之前有效
+    const char* columnTextView(int col, int* length) const {
+        const unsigned char* text = sqlite3_column_text(m_stmt, col);
+        *length = text ? sqlite3_column_bytes(m_stmt, col) : 0;
+        return text ? reinterpret_cast<const char*>(text) : "";
+    }
+
+    sqlite3_stmt* handle() const { return m_stmt; }
+
+private:
+    std::string m_sql;
+    sqlite3_stmt* m_stmt = nullptr;
+};
+
+/**
+ * @brief 作用域结束时自动 reset 语句（包括异常和提前 return 的路径），
+ *        避免未 reset 的读语句长期持有读事务
+ */
+class SqliteStatementScope
+{
+public:
+    explicit SqliteStatementScope(SqliteStatement& stmt) : m_stmt(stmt) {}
+    ~SqliteStatementScope() { m_stmt.reset(); }
+
+    SqliteStatementScope(const SqliteStatementScope&) = delete;
+    SqliteStatementScope& operator=(const SqliteStatementScope&) = delete;
+
+private:
+    SqliteStatement& m_stmt;
+};
+
+/**
+ * @brief 长连接 + 预编译语句缓存
+ *
+ * 与 sqlite_orm 每次操作重新打开连接、重新拼接和编译 SQL 不同，
+ * 这里连接常驻，同一条 SQL 只编译一次，之后每次只绑定参数执行。
+ * 非线程安全，同一时刻只能由一个线程使用（由 ConnectionManager 分配）。
+ */
+class SqliteConnection
+{
+public:
+    SqliteConnection() = default;
+    ~SqliteConnection();
+
+    SqliteConnection(const SqliteConnection&) = delete;
+    SqliteConnection& operator=(const SqliteConnection&) = delete;
+
+    /**
+     * @brief 打开数据库
+     * @param flags sqlite3_open_v2 的标志，默认读写 + 不存在则创建
+     */
+    bool open(const std::string& path, int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    void close();
+    bool isOpen() const { return m_db != nullptr; }
+
+    /**
+     * @brief 直接执行不带参数的 SQL（建表、PRAGMA、事务控制等）
+     */
+    bool exec(const char* sql);
+
+    /**
+     * @brief 获取缓存的预编译语句，首次调用时编译
+     * @return 编译失败返回 nullptr（错误信息见 lastError）
+     */
+    SqliteStatement* prepare(const std::string& sql);
+
+    /**
+     * @brief 同上，供 SQL 常量（const char*）使用：按地址查找，命中时不构造临时 std::string
+     */
+    SqliteStatement* prepare(const char* sql);
+
+    std::string lastError() const;
+    int64_t lastInsertRowId() const { return sqlite3_last_insert_rowid(m_db); }
+    int changes() const { return sqlite3_changes(m_db); }
+    sqlite3* handle() const { return m_db; }
+
+private:
+    sqlite3* m_db = nullptr;
+    std::unordered_map<std::string, std::unique_ptr<SqliteStatement>> m_statements;
+    std::unordered_map<const char*, SqliteStatement*> m_byAddress;   // SQL 常量地址 -> m_statements 中的语句
+};
+
+#endif // SQLITECONNECTION_H
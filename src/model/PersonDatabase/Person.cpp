@@ -2,110 +2,157 @@
 // Created by 刘慧敏 on 2025/12/4.
 //
 #include "Person.h"
+#include <future>
 #include <iostream>
 
+#include "model/Database/ConnectionManager.h"
+#include "model/Database/SchemaMigrations.h"
+
 Person::Person(const std::string &dbPath)
-    : storage(sqlite_orm::make_storage(dbPath,
-          sqlite_orm::make_table("Persons",
-              sqlite_orm::make_column("id", &Persons::id,
-                  sqlite_orm::primary_key().autoincrement()),
-              sqlite_orm::make_column("username", &Persons::username),
-              sqlite_orm::make_column("password", &Persons::password))))
 {
-    //storage.sync_schema(true);
-    try {
-        storage.sync_schema(); // 尝试同步
-    } catch (const std::system_error& e) {
-        std::string msg = e.what();
-        if (msg.find("already exists") != std::string::npos) {
-            // 安全忽略“表已存在”错误
-            return;
-        }
-        throw; // 其他错误仍要报错
-    }
+    // 表结构由 SchemaMigrations 维护，数据读写经由 ConnectionManager（与 green_data 同库）
+    (void)dbPath;
+    SchemaMigrations::ensureLatest();
 }
 
+namespace {
+
+const char* const kVerifySql =
+    "SELECT 1 FROM Persons WHERE username = ?1 AND password = ?2 LIMIT 1";
+const char* const kCountByNameSql =
+    "SELECT COUNT(*) FROM Persons WHERE username = ?1";
+const char* const kInsertSql =
+    "INSERT INTO Persons(username, password) VALUES(?1, ?2)";
+const char* const kUpdateSql =
+    "UPDATE Persons SET username = ?1, password = ?2 WHERE id = ?3";
+const char* const kSelectByIdSql =
+    "SELECT id, username, password FROM Persons WHERE id = ?1";
+const char* const kDeleteSql =
+    "DELETE FROM Persons WHERE id = ?1";
+const char* const kIdByNameSql =
+    "SELECT id FROM Persons WHERE username = ?1 ORDER BY id LIMIT 1";
+
+} // namespace
+
 bool Person::verifyUser(const std::string &username, const std::string &password){
-    try {
-        auto users = storage.get_all<Persons>(
-            sqlite_orm::where(
-                sqlite_orm::c(&Persons::username) == username &&
-                sqlite_orm::c(&Persons::password) == password
-            )
-        );
-        return !users.empty(); // 找到至少一个匹配用户即成功
-    } catch (const std::exception& e) {
-        std::cerr << "验证用户失败: " << e.what() << std::endl;
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kVerifySql) : nullptr;
+    if (!stmt) {
+        std::cerr << "验证用户失败: " << (conn ? conn->lastError() : "no reader connection") << std::endl;
         return false;
     }
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, username);
+    stmt->bind(2, password);
+    return stmt->step() == SQLITE_ROW; // 找到至少一个匹配用户即成功
 }
 
 int Person::insertPerson(const std::string& username, const std::string& password) {
-    // 仅修复：移除多余的::作用域（原有代码的::Persons会导致编译错误）
-    auto count = storage.count<Persons>(sqlite_orm::where(sqlite_orm::c(&Persons::username) == username));
-    if (count > 0) {
-        return -1;  // 用户名已存在
-    }
-
-    // 构造新用户对象
-    // 仅修复：移除多余的::作用域
-    Persons newPerson;
-    newPerson.username = username;  // 字段名与结构体一致
-    newPerson.password = password;
+    // 查重和插入放在写线程的同一个事务里，避免并发注册同名用户
+    std::future<int> result = ConnectionManager::instance().submit([username, password](SqliteConnection& conn) {
+        SqliteStatement* count = conn.prepare(kCountByNameSql);
+        if (!count) return 0;
+        {
+            SqliteStatementScope scope(*count);
+            count->bind(1, username);
+            if (count->step() == SQLITE_ROW && count->columnInt(0) > 0) {
+                return -1;  // 用户名已存在
+            }
+        }
 
+        SqliteStatement* insert = conn.prepare(kInsertSql);
+        if (!insert) return 0;
+        SqliteStatementScope scope(*insert);
+        insert->bind(1, username);
+        insert->bind(2, password);
+        if (insert->step() != SQLITE_DONE) {
+            std::cerr << "用户插入失败: " << conn.lastError() << std::endl;
+            return 0;  // 数据库错误
+        }
+        return static_cast<int>(conn.lastInsertRowId());  // 返回插入的 ID
+    });
     try {
-        // 插入数据库
-        auto id = storage.insert(newPerson);
-        return static_cast<int>(id);  // 返回插入的 ID
+        return result.get();
     } catch (const std::exception& e) {
+        // 事务提交失败或数据库已关闭
         std::cerr << "用户插入失败: " << e.what() << std::endl;
-        return 0;  // 数据库错误
+        return 0;
     }
 }
 
 bool Person::updatePerson(int id, const std::string &newUsername, const std::string &newPassword) {
+    std::future<bool> result = ConnectionManager::instance().submit([id, newUsername, newPassword](SqliteConnection& conn) {
+        SqliteStatement* stmt = conn.prepare(kUpdateSql);
+        if (!stmt) return false;
+        SqliteStatementScope scope(*stmt);
+        stmt->bind(1, newUsername);
+        stmt->bind(2, newPassword);
+        stmt->bind(3, id);
+        return stmt->step() == SQLITE_DONE;
+    });
+    bool ok = false;
     try {
-        storage.update_all(
-            sqlite_orm::set(
-                sqlite_orm::assign(&Persons::username, newUsername),
-                sqlite_orm::assign(&Persons::password, newPassword)),
-            sqlite_orm::where(sqlite_orm::c(&Persons::id) == id));
-        return true;
+        ok = result.get();
     } catch (const std::exception& e) {
-        std::cerr << "用户更新信息失败" << e.what() << std::endl;
-        return false;
+        std::cerr << "用户更新事务提交失败: " << e.what() << std::endl;
+    }
+    if (!ok) {
+        std::cerr << "用户更新信息失败" << std::endl;
     }
+    return ok;
 }
 
 Persons Person::getPersonById(int id) {
-    try {
-        return storage.get<Persons>(id); // 直接通过主键查询
-    } catch (const std::exception& e) {
-        std::cerr << "查询用户失败: " << e.what() << std::endl;
-        return {}; // 返回空对象
+    Persons person;
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kSelectByIdSql) : nullptr;
+    if (!stmt) {
+        std::cerr << "查询用户失败: " << (conn ? conn->lastError() : "no reader connection") << std::endl;
+        return person;
+    }
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, id);
+    if (stmt->step() == SQLITE_ROW) {
+        person.id = stmt->columnInt(0);
+        person.username = stmt->columnText(1);
+        person.password = stmt->columnText(2);
+    } else {
+        std::cerr << "查询用户失败: id=" << id << std::endl;
     }
+    return person; // 不存在时返回空对象
 }
 
 bool Person::deletePerson(int id) {
+    std::future<bool> result = ConnectionManager::instance().submit([id](SqliteConnection& conn) {
+        SqliteStatement* stmt = conn.prepare(kDeleteSql);
+        if (!stmt) return false;
+        SqliteStatementScope scope(*stmt);
+        stmt->bind(1, id);
+        return stmt->step() == SQLITE_DONE;
+    });
+    bool ok = false;
     try {
-        storage.remove<Persons>(id);
-        return true;
+        ok = result.get();
     } catch (const std::exception& e) {
-        std::cerr << "用户删除信息失败" << e.what() << std::endl;
-        return false;
+        std::cerr << "用户删除事务提交失败: " << e.what() << std::endl;
     }
+    if (!ok) {
+        std::cerr << "用户删除信息失败" << std::endl;
+    }
+    return ok;
 }
 
 int Person::getUserIdByUsername(const std::string &username) {
-    try {
-        auto users = storage.get_all<Persons>(
-            sqlite_orm::where(sqlite_orm::c(&Persons::username) == username)
-        );
-        if (!users.empty()) {
-            return users.front().id;
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "getUserIdByUsername error: " << e.what() << std::endl;
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kIdByNameSql) : nullptr;
+    if (!stmt) {
+        std::cerr << "getUserIdByUsername error: " << (conn ? conn->lastError() : "no reader connection") << std::endl;
+        return -1;
+    }
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, username);
+    if (stmt->step() == SQLITE_ROW) {
+        return stmt->columnInt(0);
     }
     return -1; // 未找到
-}
\ No newline at end of file
+}
@@ -6,7 +6,6 @@
 #define GREENHOUSEAPP_PERSON_H
 #include "model/SensorData.h"
 #include <string>
-#include "sqlite_orm.h"
 
 using namespace std;
 
@@ -32,16 +31,6 @@ public:
     //
     int getUserIdByUsername(const std::string& username);
 
-private:
-    using StorageType = decltype(sqlite_orm::make_storage(
-        "",
-        sqlite_orm::make_table("persons",
-            sqlite_orm::make_column("id", &Persons::id, sqlite_orm::primary_key().autoincrement()),
-            sqlite_orm::make_column("username", &Persons::username),
-            sqlite_orm::make_column("password", &Persons::password)
-        )
-    ));
-    StorageType storage;
 };
 
 #endif // GREENHOUSEAPP_PERSON_H
\ No newline at end of file
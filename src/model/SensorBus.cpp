@@ -0,0 +1,32 @@
+#include "SensorBus.h"
+
+#include <string>
+
+#include "untils/Metrics.h"
+
+SensorBus& SensorBus::instance() {
+    static SensorBus bus;
+    return bus;
+}
+
+SensorBus::BatchPool& SensorBus::batchPool() {
+    static BatchPool pool;
+    return pool;
+}
+
+void SensorBus::reportMetrics() {
+    static Gauge& published = Metrics::gauge("gh_sensor_bus_published", "Samples published on the sensor bus");
+    static Gauge& rejected = Metrics::gauge("gh_sensor_bus_rejected", "Samples rejected because a backpressure consumer was full");
+    static Gauge& batchBlocks = Metrics::gauge("gh_sensor_bus_batch_blocks", "Sample batch blocks allocated by the pool");
+    published.set(static_cast<int64_t>(this->published()));
+    rejected.set(static_cast<int64_t>(this->rejected()));
+    batchBlocks.set(static_cast<int64_t>(batchPool().allocatedBlocks()));
+
+    for (int i = 0; i < MAX_CONSUMERS; ++i) {
+        if (!isActive(i)) continue;
+        const std::string prefix = std::string("gh_sensor_bus_") + consumerName(i);
+        const ConsumerStats s = stats(i);
+        Metrics::gauge(prefix + "_lag", "Unread samples for this sensor bus consumer").set(static_cast<int64_t>(s.lag));
+        Metrics::gauge(prefix + "_dropped", "Samples overwritten before this consumer read them").set(static_cast<int64_t>(s.dropped));
+    }
+}
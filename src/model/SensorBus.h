@@ -0,0 +1,33 @@
+#ifndef SENSORBUS_H
+#define SENSORBUS_H
+
+#include "SensorData.h"
+#include "common/SampleBus.h"
+#include "common/BlockPool.h"
+
+/**
+ * @brief 全局传感器样本总线
+ *
+ * 解码后的样本只发布一次，数据库写入、图表、首页、异常检测、导出各自订阅，
+ * 按自己的节奏读取；落后 / 丢弃情况由 reportMetrics() 导出到 Metrics。
+ */
+class SensorBus : public SampleBus<SensorSample, 1024>
+{
+public:
+    /// 成批转交的样本（数据库写入、导出），块从对象池取用，用完归还
+    using BatchPool = BlockPool<SensorSample, 256>;
+    using Batch = BatchPool::Block;
+
+    static SensorBus& instance();
+    static BatchPool& batchPool();
+
+    /**
+     * @brief 把发布数、拒绝数和各消费者的积压 / 丢弃数写入 gauge
+     */
+    void reportMetrics();
+
+private:
+    SensorBus() = default;
+};
+
+#endif // SENSORBUS_H
@@ -2,6 +2,7 @@
 #define SENSORDATA_H
 
 #pragma once
+#include <cstdint>
 #include <string>
 /**
  * @brief 上位机内部使用的传感器数据结构（对应下位机 SensorData）
@@ -14,6 +15,35 @@ struct SensorRecord {
     int soil_humid = 0;           // %
     int light_intensity = 0;      // lux 或 raw 值
 };
+
+/**
+ * @brief 传感器样本（定长、平凡可复制，用于实时链路上的样本总线）
+ */
+struct SensorSample {
+    int64_t tsMs = 0;             // 接收时间（Unix 毫秒）
+    int32_t deviceId = 0;         // 区域 / 节点编号
+    int32_t airTemp = 0;          // ℃
+    int32_t airHumid = 0;         // %
+    int32_t soilHumid = 0;        // %
+    int32_t lightIntensity = 0;   // lux 或 raw 值
+    uint32_t flags = 0;           // SensorSampleFlags
+};
+
+enum SensorSampleFlags : uint32_t {
+    SAMPLE_VALID = 0x1            // 通过量程校验
+};
+
+/**
+ * @brief 传感器读数通道（按 green_data 的列顺序）
+ */
+enum SensorChannel : uint8_t {
+    CHANNEL_AIR_TEMP = 0,
+    CHANNEL_AIR_HUMID = 1,
+    CHANNEL_SOIL_HUMID = 2,
+    CHANNEL_LIGHT = 3,
+    CHANNEL_COUNT = 4
+};
+
 // struct SensorRecord {
 //     int id = 0;
 //     std::string record_time; // "2025-12-03 10:30:00"
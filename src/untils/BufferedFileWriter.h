@@ -0,0 +1,125 @@
+#ifndef BUFFEREDFILEWRITER_H
+#define BUFFEREDFILEWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+/**
+ * @brief 定长缓冲的文件写入器
+ *
+ * 内容先写入固定大小的缓冲区，满了才整块 fwrite，内存占用与写入总量无关。
+ * 整数格式化不经过 printf / 流，逐位写入缓冲区。
+ * 任何一次写失败后 ok() 为 false，之后的写入全部忽略，由调用方在结束时检查。
+ */
+class BufferedFileWriter
+{
+public:
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    explicit BufferedFileWriter(std::size_t bufferSize = DEFAULT_BUFFER_SIZE)
+        : m_buffer(new char[bufferSize]), m_capacity(bufferSize) {}
+
+    ~BufferedFileWriter() { close(); }
+
+    BufferedFileWriter(const BufferedFileWriter&) = delete;
+    BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+    /**
+     * @brief 以二进制方式创建 / 截断文件
+     */
+    bool open(const std::string& path) {
+        close();
+        m_file = std::fopen(path.c_str(), "wb");
+        m_ok = m_file != nullptr;
+        m_size = 0;
+        m_written = 0;
+        return m_ok;
+    }
+
+    /**
+     * @brief 写出剩余内容并关闭文件
+     * @return 全部内容写入成功
+     */
+    bool close() {
+        if (!m_file) return m_ok;
+        flush();
+        if (std::fclose(m_file) != 0) m_ok = false;
+        m_file = nullptr;
+        return m_ok;
+    }
+
+    void write(const char* data, std::size_t length) {
+        if (length > m_capacity - m_size) {
+            flush();
+            if (length > m_capacity) {
+                writeThrough(data, length);
+                return;
+            }
+        }
+        std::memcpy(m_buffer.get() + m_size, data, length);
+        m_size += length;
+    }
+
+    void write(const char* text) { write(text, std::strlen(text)); }
+
+    void put(char c) {
+        if (m_size == m_capacity) flush();
+        m_buffer[m_size++] = c;
+    }
+
+    /**
+     * @brief 十进制整数
+     */
+    void writeInt(int64_t value) {
+        char digits[20];
+        int n = 0;
+        // 取绝对值时先转为无符号，避免 INT64_MIN 溢出
+        uint64_t v = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+        do {
+            digits[n++] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v != 0);
+
+        if (m_capacity - m_size < static_cast<std::size_t>(n) + 1) flush();
+        char* out = m_buffer.get() + m_size;
+        if (value < 0) *out++ = '-';
+        while (n > 0) *out++ = digits[--n];
+        m_size = static_cast<std::size_t>(out - m_buffer.get());
+    }
+
+    void flush() {
+        if (m_size == 0) return;
+        writeThrough(m_buffer.get(), m_size);
+        m_size = 0;
+    }
+
+    bool isOpen() const { return m_file != nullptr; }
+    bool ok() const { return m_ok; }
+    /// 已经落到文件的字节数（不含缓冲区中尚未写出的部分）
+    uint64_t bytesWritten() const { return m_written; }
+    /// 当前写入位置（文件偏移，含缓冲区中尚未写出的部分）
+    uint64_t position() const { return m_written + m_size; }
+
+private:
+    void writeThrough(const char* data, std::size_t length) {
+        if (!m_ok || !m_file) return;
+        if (std::fwrite(data, 1, length, m_file) != length) {
+            m_ok = false;
+            return;
+        }
+        m_written += length;
+    }
+
+    std::unique_ptr<char[]> m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_size = 0;
+    std::FILE* m_file = nullptr;
+    bool m_ok = false;
+    uint64_t m_written = 0;
+};
+
+#endif // BUFFEREDFILEWRITER_H
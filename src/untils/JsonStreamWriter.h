@@ -0,0 +1,109 @@
+#ifndef JSONSTREAMWRITER_H
+#define JSONSTREAMWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "BufferedFileWriter.h"
+
+/**
+ * @brief 流式 JSON 编码器
+ *
+ * 边生成边写入 BufferedFileWriter，不构造文档树；逗号由嵌套栈自动补齐。
+ * 只支持导出用到的类型：对象、数组、字符串、整数。嵌套深度至多 MAX_DEPTH。
+ *
+ *     json.beginObject();
+ *     json.key("data"); json.beginArray();
+ *     ...
+ *     json.endArray();
+ *     json.endObject();
+ */
+class JsonStreamWriter
+{
+public:
+    static constexpr int MAX_DEPTH = 16;
+
+    explicit JsonStreamWriter(BufferedFileWriter& out) : m_out(out) {}
+
+    /// 开始写新文档前清空嵌套状态
+    void reset() {
+        m_depth = 0;
+        m_afterKey = false;
+    }
+
+    void beginObject() { beforeValue(); m_out.put('{'); push(); }
+    void endObject() { pop(); m_out.put('}'); }
+    void beginArray() { beforeValue(); m_out.put('['); push(); }
+    void endArray() { pop(); m_out.put(']'); }
+
+    void key(const char* name) {
+        beforeValue();
+        writeString(name, std::strlen(name));
+        m_out.put(':');
+        m_afterKey = true;
+    }
+
+    void value(const char* text, std::size_t length) { beforeValue(); writeString(text, length); }
+    void value(const char* text) { value(text, std::strlen(text)); }
+    void value(int64_t number) { beforeValue(); m_out.writeInt(number); }
+    void value(int number) { value(static_cast<int64_t>(number)); }
+
+    /// 当前层之后另起一行（只为可读性，不影响解析）
+    void newline() { m_out.put('\n'); }
+
+private:
+    void push() {
+        if (m_depth < MAX_DEPTH) m_hasItem[m_depth] = false;
+        ++m_depth;
+    }
+
+    void pop() { if (m_depth > 0) --m_depth; }
+
+    void beforeValue() {
+        if (m_afterKey) {
+            m_afterKey = false;
+            return;
+        }
+        if (m_depth > 0 && m_depth <= MAX_DEPTH) {
+            bool& hasItem = m_hasItem[m_depth - 1];
+            if (hasItem) m_out.put(',');
+            hasItem = true;
+        }
+    }
+
+    void writeString(const char* text, std::size_t length) {
+        static const char kHex[] = "0123456789abcdef";
+        m_out.put('"');
+        std::size_t runStart = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            const unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+            // 先写出前面不需要转义的一段
+            m_out.write(text + runStart, i - runStart);
+            runStart = i + 1;
+            switch (c) {
+            case '"':  m_out.write("\\\"", 2); break;
+            case '\\': m_out.write("\\\\", 2); break;
+            case '\n': m_out.write("\\n", 2); break;
+            case '\r': m_out.write("\\r", 2); break;
+            case '\t': m_out.write("\\t", 2); break;
+            default: {
+                const char escaped[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+                m_out.write(escaped, 6);
+                break;
+            }
+            }
+        }
+        m_out.write(text + runStart, length - runStart);
+        m_out.put('"');
+    }
+
+    BufferedFileWriter& m_out;
+    bool m_hasItem[MAX_DEPTH] = {};
+    int m_depth = 0;
+    bool m_afterKey = false;
+};
+
+#endif // JSONSTREAMWRITER_H
@@ -1,3 +1,428 @@
 #include "Log.h"
 
-Log::Log() {}
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <QDir>
+
+// ========================================
+// 无锁有界队列（Vyukov MPMC）
+// ========================================
+
+namespace {
+
+constexpr std::size_t kQueueCapacity = 4096;   // 必须是 2 的幂
+constexpr std::size_t kQueueMask = kQueueCapacity - 1;
+
+struct Cell {
+    std::atomic<uint64_t> sequence;
+    LogRecord record;
+};
+
+/**
+ * @brief 日志后端：队列 + 后台写线程 + 滚动文件
+ */
+class LogBackend {
+public:
+    LogBackend() : m_cells(new Cell[kQueueCapacity]) {
+        for (std::size_t i = 0; i < kQueueCapacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~LogBackend() { stop(); }
+
+    // ---------- 生产者 ----------
+
+    LogRecord* tryAcquire(uint64_t& ticket) {
+        uint64_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & kQueueMask];
+            const uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+            const int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    ticket = pos;
+                    return &cell.record;
+                }
+            } else if (diff < 0) {
+                // 队列已满：丢弃，绝不阻塞采集线程
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(uint64_t ticket) {
+        m_cells[ticket & kQueueMask].sequence.store(ticket + 1, std::memory_order_release);
+    }
+
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // ---------- 生命周期 ----------
+
+    void start(const LogConfig& config) {
+        std::lock_guard<std::mutex> lock(m_lifecycleMutex);
+        if (m_running.load()) return;
+
+        m_config = config;
+        if (m_config.maxFiles < 1) m_config.maxFiles = 1;
+        QDir().mkpath(QString::fromStdString(m_config.directory));
+        openFile();
+
+        m_running.store(true);
+        m_thread = std::thread(&LogBackend::run, this);
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(m_lifecycleMutex);
+        if (!m_running.load()) return;
+
+        m_running.store(false);
+        if (m_thread.joinable()) m_thread.join();
+        closeFile();
+    }
+
+private:
+    // ---------- 消费者（后台线程） ----------
+
+    void run() {
+        int idleMs = 1;
+        for (;;) {
+            const bool stopping = !m_running.load(std::memory_order_acquire);
+            const std::size_t written = drain();
+            reportDropped();
+
+            if (written > 0) {
+                idleMs = 1;
+                continue;
+            }
+            if (stopping) break;
+
+            // 空闲时刷盘并逐步退避，最长 20ms
+            if (m_file) std::fflush(m_file);
+            std::this_thread::sleep_for(std::chrono::milliseconds(idleMs));
+            if (idleMs < 20) idleMs *= 2;
+        }
+        if (m_file) std::fflush(m_file);
+    }
+
+    std::size_t drain() {
+        std::size_t count = 0;
+        bool sawError = false;
+        for (;;) {
+            Cell& cell = m_cells[m_dequeuePos & kQueueMask];
+            const uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+            if (seq != m_dequeuePos + 1) break;   // 空，或生产者尚未提交
+
+            formatRecord(cell.record);
+            sawError = sawError || cell.record.level >= LogLevel::Error;
+
+            cell.sequence.store(m_dequeuePos + kQueueCapacity, std::memory_order_release);
+            ++m_dequeuePos;
+            ++count;
+        }
+        if (sawError && m_file) std::fflush(m_file);
+        return count;
+    }
+
+    void reportDropped() {
+        const uint64_t total = dropped();
+        if (total == m_reportedDropped) return;
+
+        char buf[96];
+        std::snprintf(buf, sizeof(buf), "log queue overflow: %llu records dropped",
+                      static_cast<unsigned long long>(total - m_reportedDropped));
+        m_reportedDropped = total;
+
+        LogRecord record;
+        record.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        record.format = "{}";
+        record.file = nullptr;
+        record.line = 0;
+        record.threadId = 0;
+        record.level = LogLevel::Warn;
+        record.argCount = 0;
+        record.textUsed = 0;
+        record.push(static_cast<const char*>(buf));
+        formatRecord(record);
+    }
+
+    void formatRecord(const LogRecord& record) {
+        m_line.clear();
+        appendTimestamp(record.timestampUs);
+
+        static const char kLevelNames[] = {'D', 'I', 'W', 'E', '-'};
+        m_line += ' ';
+        m_line += kLevelNames[static_cast<int>(record.level) < 5 ? static_cast<int>(record.level) : 4];
+
+        char head[64];
+        std::snprintf(head, sizeof(head), " [%u] ", record.threadId);
+        m_line += head;
+
+        if (record.file) {
+            const char* base = record.file;
+            for (const char* p = record.file; *p; ++p) {
+                if (*p == '/' || *p == '\\') base = p + 1;
+            }
+            m_line += base;
+            std::snprintf(head, sizeof(head), ":%d ", record.line);
+            m_line += head;
+        }
+
+        appendMessage(record);
+        m_line += '\n';
+
+        writeLine();
+    }
+
+    void appendTimestamp(int64_t timestampUs) {
+        const int64_t secs = timestampUs / 1000000;
+        // 同一秒内的记录复用已格式化的日期时间
+        if (secs != m_cachedSecond) {
+            const std::time_t t = static_cast<std::time_t>(secs);
+            std::tm tmValue;
+#ifdef _WIN32
+            tmValue = *std::localtime(&t);
+#else
+            localtime_r(&t, &tmValue);
+#endif
+            std::strftime(m_cachedStamp, sizeof(m_cachedStamp), "%Y-%m-%d %H:%M:%S", &tmValue);
+            m_cachedSecond = secs;
+        }
+        char frac[16];
+        std::snprintf(frac, sizeof(frac), ".%06d", static_cast<int>(timestampUs % 1000000));
+        m_line += m_cachedStamp;
+        m_line += frac;
+    }
+
+    void appendArg(const LogRecord& record, const LogRecord::Arg& arg) {
+        char buf[32];
+        switch (arg.type) {
+        case LogRecord::ARG_INT:
+            std::snprintf(buf, sizeof(buf), "%lld", static_cast<long long>(arg.i));
+            m_line += buf;
+            break;
+        case LogRecord::ARG_UINT:
+            std::snprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(arg.u));
+            m_line += buf;
+            break;
+        case LogRecord::ARG_DOUBLE:
+            std::snprintf(buf, sizeof(buf), "%.6g", arg.d);
+            m_line += buf;
+            break;
+        case LogRecord::ARG_BOOL:
+            m_line += arg.u ? "true" : "false";
+            break;
+        case LogRecord::ARG_CHAR:
+            m_line += static_cast<char>(arg.u);
+            break;
+        case LogRecord::ARG_TEXT:
+            m_line.append(record.text + arg.offset, arg.length);
+            break;
+        }
+    }
+
+    void appendMessage(const LogRecord& record) {
+        int argIndex = 0;
+        const char* p = record.format ? record.format : "";
+        while (*p) {
+            if (p[0] == '{' && p[1] == '}') {
+                if (argIndex < record.argCount) {
+                    appendArg(record, record.args[argIndex++]);
+                } else {
+                    m_line += "{}";
+                }
+                p += 2;
+            } else {
+                m_line += *p++;
+            }
+        }
+        // 占位符少于参数时，多余参数依次追加在末尾
+        for (; argIndex < record.argCount; ++argIndex) {
+            m_line += ' ';
+            appendArg(record, record.args[argIndex]);
+        }
+    }
+
+    // ---------- 文件输出 ----------
+
+    std::string filePath(int index) const {
+        std::string path = m_config.directory + "/" + m_config.baseName;
+        if (index > 0) path += "." + std::to_string(index);
+        return path + ".log";
+    }
+
+    void openFile() {
+        m_file = std::fopen(filePath(0).c_str(), "ab");
+        m_fileBytes = 0;
+        if (m_file) {
+            std::fseek(m_file, 0, SEEK_END);
+            const long size = std::ftell(m_file);
+            m_fileBytes = size > 0 ? static_cast<std::size_t>(size) : 0;
+        } else {
+            std::fprintf(stderr, "Log: cannot open %s\n", filePath(0).c_str());
+        }
+    }
+
+    void closeFile() {
+        if (m_file) {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+    void rotate() {
+        closeFile();
+        std::remove(filePath(m_config.maxFiles - 1).c_str());
+        for (int i = m_config.maxFiles - 2; i >= 0; --i) {
+            std::rename(filePath(i).c_str(), filePath(i + 1).c_str());
+        }
+        openFile();
+    }
+
+    void writeLine() {
+        if (m_config.echoToStderr) {
+            std::fwrite(m_line.data(), 1, m_line.size(), stderr);
+        }
+        if (!m_file) return;
+
+        if (m_fileBytes + m_line.size() > m_config.maxFileBytes && m_fileBytes > 0) {
+            rotate();
+            if (!m_file) return;
+        }
+        std::fwrite(m_line.data(), 1, m_line.size(), m_file);
+        m_fileBytes += m_line.size();
+    }
+
+    std::unique_ptr<Cell[]> m_cells;
+    std::atomic<uint64_t> m_enqueuePos{0};
+    std::atomic<uint64_t> m_dropped{0};
+
+    // 以下成员只在后台线程（或其未运行时）访问
+    uint64_t m_dequeuePos = 0;
+    uint64_t m_reportedDropped = 0;
+    LogConfig m_config;
+    std::FILE* m_file = nullptr;
+    std::size_t m_fileBytes = 0;
+    std::string m_line;
+    int64_t m_cachedSecond = -1;
+    char m_cachedStamp[32] = {0};
+
+    std::mutex m_lifecycleMutex;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+LogBackend& backend() {
+    static LogBackend instance;
+    return instance;
+}
+
+uint32_t currentThreadId() {
+    static std::atomic<uint32_t> nextId{1};
+    thread_local uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+QtMessageHandler g_previousHandler = nullptr;
+
+// 转接 qDebug / qWarning：文本已由 Qt 格式化，这里只做一次拷贝
+void qtMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& msg) {
+    LogLevel level = LogLevel::Debug;
+    switch (type) {
+    case QtDebugMsg:    level = LogLevel::Debug; break;
+    case QtInfoMsg:     level = LogLevel::Info; break;
+    case QtWarningMsg:  level = LogLevel::Warn; break;
+    case QtCriticalMsg:
+    case QtFatalMsg:    level = LogLevel::Error; break;
+    }
+
+    if (type == QtFatalMsg) {
+        std::fprintf(stderr, "%s\n", msg.toLocal8Bit().constData());
+        Log::shutdown();
+        std::abort();
+    }
+    if (!Log::isEnabled(level)) return;
+
+    const QByteArray text = msg.toUtf8();
+    Log::writeText(level, context.file, context.line, text.constData(), static_cast<std::size_t>(text.size()));
+}
+
+} // namespace
+
+// ========================================
+// LogRecord
+// ========================================
+
+void LogRecord::pushText(const char* s, std::size_t len) {
+    Arg* a = next(ARG_TEXT);
+    if (!a) return;
+    const std::size_t room = static_cast<std::size_t>(kTextCapacity) - textUsed;
+    if (len > room) len = room;
+    if (len > 0) std::memcpy(text + textUsed, s, len);
+    a->offset = textUsed;
+    a->length = static_cast<uint16_t>(len);
+    textUsed = static_cast<uint16_t>(textUsed + len);
+}
+
+// ========================================
+// Log
+// ========================================
+
+std::atomic<uint8_t> Log::s_level{static_cast<uint8_t>(GH_LOG_MIN_LEVEL)};
+
+void Log::init(const LogConfig& config) {
+    setLevel(config.level);
+    backend().start(config);
+    if (config.captureQtMessages && !g_previousHandler) {
+        g_previousHandler = qInstallMessageHandler(qtMessageHandler);
+    }
+}
+
+void Log::shutdown() {
+    if (g_previousHandler) {
+        qInstallMessageHandler(g_previousHandler);
+        g_previousHandler = nullptr;
+    }
+    backend().stop();
+}
+
+uint64_t Log::droppedCount() {
+    return backend().dropped();
+}
+
+LogRecord* Log::beginRecord(uint64_t& ticket) {
+    LogRecord* record = backend().tryAcquire(ticket);
+    if (!record) return nullptr;
+    record->timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record->threadId = currentThreadId();
+    record->argCount = 0;
+    record->textUsed = 0;
+    return record;
+}
+
+void Log::commitRecord(uint64_t ticket) {
+    backend().publish(ticket);
+}
+
+void Log::writeText(LogLevel level, const char* file, int line, const char* text, std::size_t len) {
+    uint64_t ticket;
+    LogRecord* record = beginRecord(ticket);
+    if (!record) return;
+    record->level = level;
+    record->file = file;
+    record->line = line;
+    record->format = "{}";
+    record->pushText(text, len);
+    commitRecord(ticket);
+}
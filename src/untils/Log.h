@@ -1,10 +1,217 @@
 #ifndef LOG_H
 #define LOG_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include <QByteArray>
+#include <QString>
+
+/**
+ * @brief 日志级别
+ */
+enum class LogLevel : uint8_t {
+    Debug = 0,
+    Info  = 1,
+    Warn  = 2,
+    Error = 3,
+    Off   = 4
+};
+
+/**
+ * @brief 编译期最低日志级别（低于该级别的 LOG_xxx 调用整段被编译器消除）
+ *
+ * 默认 Debug 构建保留全部级别，Release 构建只保留 Info 及以上。
+ * 可在 CMake 中通过 -DGH_LOG_MIN_LEVEL=2 之类的定义覆盖。
+ */
+#ifndef GH_LOG_MIN_LEVEL
+#  ifdef NDEBUG
+#    define GH_LOG_MIN_LEVEL 1
+#  else
+#    define GH_LOG_MIN_LEVEL 0
+#  endif
+#endif
+
+/**
+ * @brief 日志配置
+ */
+struct LogConfig {
+    std::string directory = "logs";          // 日志目录（不存在时自动创建）
+    std::string baseName = "greenhouse";     // 文件名：greenhouse.log、greenhouse.1.log ...
+    std::size_t maxFileBytes = 5 * 1024 * 1024;  // 单个文件上限，超过后滚动
+    int maxFiles = 5;                        // 保留的文件个数（含当前文件）
+    LogLevel level = LogLevel::Info;         // 运行期最低级别
+    bool echoToStderr = false;               // 同时输出到 stderr（调试时使用）
+    bool captureQtMessages = true;           // 把 qDebug / qWarning 也转入日志队列
+};
+
+/**
+ * @brief 一条待格式化的日志记录
+ *
+ * 调用方只拷贝格式串指针和原始参数，格式化、时间转换、写文件都在后台线程完成。
+ * 字符串参数拷贝到记录内部的 text 区，超出部分截断。
+ */
+struct LogRecord {
+    static constexpr int kMaxArgs = 8;
+    static constexpr int kTextCapacity = 384;
+
+    enum ArgType : uint8_t {
+        ARG_INT,
+        ARG_UINT,
+        ARG_DOUBLE,
+        ARG_BOOL,
+        ARG_CHAR,
+        ARG_TEXT
+    };
+
+    struct Arg {
+        ArgType type;
+        uint16_t offset;    // ARG_TEXT：text 区内偏移
+        uint16_t length;    // ARG_TEXT：字节数
+        union {
+            int64_t i;
+            uint64_t u;
+            double d;
+        };
+    };
+
+    int64_t timestampUs;    // 系统时钟微秒
+    const char* format;     // 静态格式串，"{}" 为参数占位符
+    const char* file;
+    int line;
+    uint32_t threadId;
+    LogLevel level;
+    uint8_t argCount;
+    uint16_t textUsed;
+    Arg args[kMaxArgs];
+    char text[kTextCapacity];
+
+    // ---------- 参数编码 ----------
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value
+                            && !std::is_same<T, char>::value>::type
+    push(T v) { Arg* a = next(ARG_INT); if (a) a->i = static_cast<int64_t>(v); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value
+                            && !std::is_same<T, bool>::value && !std::is_same<T, char>::value>::type
+    push(T v) { Arg* a = next(ARG_UINT); if (a) a->u = static_cast<uint64_t>(v); }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type
+    push(T v) { Arg* a = next(ARG_DOUBLE); if (a) a->d = static_cast<double>(v); }
+
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type
+    push(T v) { push(static_cast<typename std::underlying_type<T>::type>(v)); }
+
+    void push(bool v) { Arg* a = next(ARG_BOOL); if (a) a->u = v ? 1 : 0; }
+    void push(char v) { Arg* a = next(ARG_CHAR); if (a) a->u = static_cast<unsigned char>(v); }
+    void push(const char* s) { pushText(s, s ? std::strlen(s) : 0); }
+    void push(const std::string& s) { pushText(s.data(), s.size()); }
+    void push(const QByteArray& s) { pushText(s.constData(), static_cast<std::size_t>(s.size())); }
+    // QString 需要先转 UTF-8，仅用于非热点路径
+    void push(const QString& s) { push(s.toUtf8()); }
+
+    void pushText(const char* s, std::size_t len);
+
+private:
+    Arg* next(ArgType type) {
+        if (argCount >= kMaxArgs) return nullptr;
+        Arg* a = &args[argCount++];
+        a->type = type;
+        return a;
+    }
+};
+
+/**
+ * @brief 异步分级日志
+ *
+ * - 通过 LOG_DEBUG / LOG_INFO / LOG_WARN / LOG_ERROR 宏调用；
+ *   编译期被关闭的级别整条语句（包括参数求值）都会被消除，运行期关闭的级别只有一次原子读
+ * - 生产者把记录写进无锁有界队列（Vyukov MPMC 环形队列），队列满时丢弃并计数，从不阻塞调用线程
+ * - 后台线程负责格式化并写入按大小滚动的日志文件
+ */
 class Log
 {
 public:
-    Log();
+    /**
+     * @brief 启动后台写线程（重复调用无效）
+     */
+    static void init(const LogConfig& config);
+
+    /**
+     * @brief 写完队列中剩余记录并停止后台线程
+     */
+    static void shutdown();
+
+    static void setLevel(LogLevel level) { s_level.store(static_cast<uint8_t>(level), std::memory_order_relaxed); }
+    static LogLevel level() { return static_cast<LogLevel>(s_level.load(std::memory_order_relaxed)); }
+
+    static bool isEnabled(LogLevel level) {
+        return static_cast<uint8_t>(level) >= s_level.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 因队列已满而丢弃的记录数
+     */
+    static uint64_t droppedCount();
+
+    template <typename... Args>
+    static void write(LogLevel level, const char* file, int line, const char* format, const Args&... args) {
+        uint64_t ticket;
+        LogRecord* record = beginRecord(ticket);
+        if (!record) return;
+        record->level = level;
+        record->file = file;
+        record->line = line;
+        record->format = format;
+        pushArgs(*record, args...);
+        commitRecord(ticket);
+    }
+
+    /**
+     * @brief 写入一条已经格式化好的文本（用于转接 Qt 消息）
+     */
+    static void writeText(LogLevel level, const char* file, int line, const char* text, std::size_t len);
+
+private:
+    static LogRecord* beginRecord(uint64_t& ticket);
+    static void commitRecord(uint64_t ticket);
+
+    static void pushArgs(LogRecord&) {}
+    template <typename T, typename... Rest>
+    static void pushArgs(LogRecord& record, const T& first, const Rest&... rest) {
+        record.push(first);
+        pushArgs(record, rest...);
+    }
+
+    static std::atomic<uint8_t> s_level;
 };
 
+// ========================================
+// 日志宏
+// ========================================
+
+constexpr bool logLevelCompiled(LogLevel level) {
+    return static_cast<int>(level) + 1 > GH_LOG_MIN_LEVEL;
+}
+
+// 格式串必须是字符串字面量（记录里只保存指针）
+#define GH_LOG(lvl, fmt, ...)                                                     \
+    do {                                                                          \
+        if (logLevelCompiled(lvl) && Log::isEnabled(lvl))                         \
+            Log::write(lvl, __FILE__, __LINE__, "" fmt, ##__VA_ARGS__);           \
+    } while (0)
+
+#define LOG_DEBUG(fmt, ...) GH_LOG(LogLevel::Debug, fmt, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...)  GH_LOG(LogLevel::Info, fmt, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...)  GH_LOG(LogLevel::Warn, fmt, ##__VA_ARGS__)
+#define LOG_ERROR(fmt, ...) GH_LOG(LogLevel::Error, fmt, ##__VA_ARGS__)
+
 #endif // LOG_H
@@ -0,0 +1,307 @@
+#include "Metrics.h"
+
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+
+// ========================================
+// HistogramSnapshot / Histogram
+// ========================================
+
+uint64_t HistogramSnapshot::percentile(double p) const {
+    if (count == 0) return 0;
+    if (p < 0) p = 0;
+    if (p > 100) p = 100;
+
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * count + 0.5);
+    if (rank < 1) rank = 1;
+
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            const uint64_t upper = Histogram::bucketUpperBound(static_cast<int>(i));
+            return upper < max ? upper : max;
+        }
+    }
+    return max;
+}
+
+int Histogram::bucketIndex(uint64_t value) {
+    if (value < 2 * kSubBuckets) return static_cast<int>(value);
+
+    int msb = 63;
+    while (!(value >> msb)) --msb;   // value >= 32，循环最多 58 次；编译器会优化为 clz
+    const int shift = msb - kSubBucketBits;
+    return (msb - kSubBucketBits + 1) * kSubBuckets
+           + static_cast<int>((value >> shift) & (kSubBuckets - 1));
+}
+
+uint64_t Histogram::bucketUpperBound(int index) {
+    if (index < 2 * kSubBuckets) return static_cast<uint64_t>(index);
+
+    const int msb = index / kSubBuckets + kSubBucketBits - 1;
+    const int sub = index % kSubBuckets;
+    const int shift = msb - kSubBucketBits;
+    const uint64_t lower = static_cast<uint64_t>(kSubBuckets + sub) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+void Histogram::record(uint64_t value) {
+    m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t prev = m_max.load(std::memory_order_relaxed);
+    while (value > prev && !m_max.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot snap;
+    snap.buckets.resize(kBucketCount);
+    uint64_t total = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        snap.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += snap.buckets[i];
+    }
+    // 以桶计数之和为准，避免与 m_count 之间的竞争导致百分位越界
+    snap.count = total;
+    snap.sum = m_sum.load(std::memory_order_relaxed);
+    snap.max = m_max.load(std::memory_order_relaxed);
+    return snap;
+}
+
+// ========================================
+// 注册表
+// ========================================
+
+namespace {
+
+struct Entry {
+    std::string name;
+    std::string help;
+    std::string unit;
+    MetricSnapshot::Type type;
+    std::unique_ptr<Counter> counter;
+    std::unique_ptr<Gauge> gauge;
+    std::unique_ptr<Histogram> histogram;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Entry>> entries;          // 注册顺序
+    std::unordered_map<std::string, Entry*> byName;
+
+    Entry& findOrCreate(const std::string& name, const std::string& help,
+                        const std::string& unit, MetricSnapshot::Type type) {
+        auto it = byName.find(name);
+        if (it != byName.end()) return *it->second;
+
+        std::unique_ptr<Entry> entry(new Entry);
+        entry->name = name;
+        entry->help = help;
+        entry->unit = unit;
+        entry->type = type;
+        switch (type) {
+        case MetricSnapshot::COUNTER:   entry->counter.reset(new Counter); break;
+        case MetricSnapshot::GAUGE:     entry->gauge.reset(new Gauge); break;
+        case MetricSnapshot::HISTOGRAM: entry->histogram.reset(new Histogram); break;
+        }
+        Entry* raw = entry.get();
+        entries.push_back(std::move(entry));
+        byName.emplace(name, raw);
+        return *raw;
+    }
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+void appendEscapedJson(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        default:   out += c; break;
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+Counter& Metrics::counter(const std::string& name, const std::string& help) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Entry& e = r.findOrCreate(name, help, "", MetricSnapshot::COUNTER);
+    if (!e.counter) e.counter.reset(new Counter);   // 同名但类型不同时避免空引用
+    return *e.counter;
+}
+
+Gauge& Metrics::gauge(const std::string& name, const std::string& help) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Entry& e = r.findOrCreate(name, help, "", MetricSnapshot::GAUGE);
+    if (!e.gauge) e.gauge.reset(new Gauge);
+    return *e.gauge;
+}
+
+Histogram& Metrics::histogram(const std::string& name, const std::string& help, const std::string& unit) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Entry& e = r.findOrCreate(name, help, unit, MetricSnapshot::HISTOGRAM);
+    if (!e.histogram) e.histogram.reset(new Histogram);
+    return *e.histogram;
+}
+
+std::vector<MetricSnapshot> Metrics::snapshotAll() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    std::vector<MetricSnapshot> result;
+    result.reserve(r.entries.size());
+    for (const auto& e : r.entries) {
+        MetricSnapshot snap;
+        snap.name = e->name;
+        snap.help = e->help;
+        snap.unit = e->unit;
+        snap.type = e->type;
+        switch (e->type) {
+        case MetricSnapshot::COUNTER:
+            snap.value = static_cast<int64_t>(e->counter->value());
+            break;
+        case MetricSnapshot::GAUGE:
+            snap.value = e->gauge->value();
+            break;
+        case MetricSnapshot::HISTOGRAM:
+            snap.histogram = e->histogram->snapshot();
+            snap.value = static_cast<int64_t>(snap.histogram.count);
+            break;
+        }
+        result.push_back(std::move(snap));
+    }
+    return result;
+}
+
+std::string Metrics::renderPrometheus() {
+    static const double kQuantiles[] = {50, 90, 99, 99.9};
+
+    std::string out;
+    char buf[160];
+    for (const MetricSnapshot& m : snapshotAll()) {
+        const char* type = m.type == MetricSnapshot::COUNTER ? "counter"
+                         : m.type == MetricSnapshot::GAUGE ? "gauge" : "summary";
+        out += "# HELP " + m.name + " " + m.help;
+        if (!m.unit.empty()) out += " (" + m.unit + ")";
+        out += "\n# TYPE " + m.name + " " + type + "\n";
+
+        if (m.type != MetricSnapshot::HISTOGRAM) {
+            std::snprintf(buf, sizeof(buf), "%s %lld\n", m.name.c_str(), static_cast<long long>(m.value));
+            out += buf;
+            continue;
+        }
+        for (double q : kQuantiles) {
+            std::snprintf(buf, sizeof(buf), "%s{quantile=\"%g\"} %llu\n", m.name.c_str(), q / 100.0,
+                          static_cast<unsigned long long>(m.histogram.percentile(q)));
+            out += buf;
+        }
+        std::snprintf(buf, sizeof(buf), "%s_sum %llu\n%s_count %llu\n",
+                      m.name.c_str(), static_cast<unsigned long long>(m.histogram.sum),
+                      m.name.c_str(), static_cast<unsigned long long>(m.histogram.count));
+        out += buf;
+    }
+    return out;
+}
+
+std::string Metrics::renderJson() {
+    std::string out = "{\n  \"metrics\": [";
+    char buf[256];
+    bool first = true;
+    for (const MetricSnapshot& m : snapshotAll()) {
+        out += first ? "\n    {" : ",\n    {";
+        first = false;
+
+        out += "\"name\": ";
+        appendEscapedJson(out, m.name);
+        out += ", \"help\": ";
+        appendEscapedJson(out, m.help);
+
+        if (m.type != MetricSnapshot::HISTOGRAM) {
+            std::snprintf(buf, sizeof(buf), ", \"type\": \"%s\", \"value\": %lld}",
+                          m.type == MetricSnapshot::COUNTER ? "counter" : "gauge",
+                          static_cast<long long>(m.value));
+        } else {
+            const HistogramSnapshot& h = m.histogram;
+            std::snprintf(buf, sizeof(buf),
+                          ", \"type\": \"histogram\", \"unit\": \"%s\", \"count\": %llu, \"mean\": %.1f, "
+                          "\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}",
+                          m.unit.c_str(), static_cast<unsigned long long>(h.count), h.mean(),
+                          static_cast<unsigned long long>(h.percentile(50)),
+                          static_cast<unsigned long long>(h.percentile(90)),
+                          static_cast<unsigned long long>(h.percentile(99)),
+                          static_cast<unsigned long long>(h.percentile(99.9)),
+                          static_cast<unsigned long long>(h.max));
+        }
+        out += buf;
+    }
+    out += "\n  ]\n}\n";
+    return out;
+}
+
+// ========================================
+// 采集链路的固定指标
+// ========================================
+
+namespace PipelineMetrics {
+
+Counter& framesDecoded() {
+    static Counter& c = Metrics::counter("gh_frames_decoded_total", "Frames that passed CRC check");
+    return c;
+}
+
+Counter& crcFailures() {
+    static Counter& c = Metrics::counter("gh_crc_failures_total", "Frames dropped due to CRC mismatch");
+    return c;
+}
+
+Counter& samplesStored() {
+    static Counter& c = Metrics::counter("gh_db_samples_stored_total", "Sensor samples written to the database");
+    return c;
+}
+
+Counter& dbWriteFailures() {
+    static Counter& c = Metrics::counter("gh_db_write_failures_total", "Failed database writes");
+    return c;
+}
+
+Gauge& dbQueueDepth() {
+    static Gauge& g = Metrics::gauge("gh_db_queue_depth", "Samples waiting to be written to the database");
+    return g;
+}
+
+Histogram& dbCommitUs() {
+    static Histogram& h = Metrics::histogram("gh_db_commit_us", "Database write/commit latency");
+    return h;
+}
+
+Histogram& chartUpdateUs() {
+    static Histogram& h = Metrics::histogram("gh_chart_update_us", "Realtime chart series update time");
+    return h;
+}
+
+Histogram& sampleToPixelUs() {
+    static Histogram& h = Metrics::histogram("gh_sample_to_pixel_us", "Latency from frame decode to chart paint");
+    return h;
+}
+
+LatencyMark& sampleMark() {
+    static LatencyMark mark;
+    return mark;
+}
+
+} // namespace PipelineMetrics
@@ -0,0 +1,193 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 进程内指标：计数器 / 仪表 / 延迟直方图
+ *
+ * 所有更新操作都是无锁的原子操作，可以在采集热点路径上直接调用；
+ * 只有注册（首次按名字获取）时加锁，调用方应缓存返回的引用。
+ */
+
+// ========================================
+// 计数器（单调递增）
+// ========================================
+class Counter
+{
+public:
+    void inc(uint64_t n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_value{0};
+};
+
+// ========================================
+// 仪表（可增可减的瞬时值）
+// ========================================
+class Gauge
+{
+public:
+    void set(int64_t v) { m_value.store(v, std::memory_order_relaxed); }
+    void add(int64_t d) { m_value.fetch_add(d, std::memory_order_relaxed); }
+    int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> m_value{0};
+};
+
+/**
+ * @brief 直方图快照（读取时复制一份，统计在快照上进行）
+ */
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+    std::vector<uint64_t> buckets;
+
+    double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+
+    /**
+     * @brief 百分位数（返回所在桶的上界，相对误差不超过 1/16）
+     * @param p 0~100
+     */
+    uint64_t percentile(double p) const;
+};
+
+/**
+ * @brief HDR 风格的对数-线性直方图
+ *
+ * 小于 32 的值逐个计数，之后每个 2 的幂区间再均分为 16 个子桶，
+ * 覆盖完整的 uint64 范围，固定内存，记录一次只有几次原子加。
+ * 延迟类指标统一以微秒为单位记录。
+ */
+class Histogram
+{
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    void record(uint64_t value);
+    HistogramSnapshot snapshot() const;
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int index);
+
+private:
+    std::atomic<uint64_t> m_buckets[kBucketCount] = {};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+};
+
+/**
+ * @brief 采样 -> 上屏 延迟标记
+ *
+ * 解码到传感器帧时 mark()，图表绘制时 take()；
+ * 两次绘制之间有多个采样时保留最早的那个，得到的是本次绘制的最坏延迟。
+ */
+class LatencyMark
+{
+public:
+    void mark(int64_t nowNs) {
+        int64_t expected = 0;
+        m_pendingNs.compare_exchange_strong(expected, nowNs, std::memory_order_relaxed);
+    }
+    int64_t take() { return m_pendingNs.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> m_pendingNs{0};
+};
+
+/**
+ * @brief 指标快照（供诊断页面 / HTTP 导出使用）
+ */
+struct MetricSnapshot {
+    enum Type { COUNTER, GAUGE, HISTOGRAM };
+
+    std::string name;
+    std::string help;
+    std::string unit;
+    Type type = COUNTER;
+    int64_t value = 0;              // COUNTER / GAUGE
+    HistogramSnapshot histogram;    // HISTOGRAM
+};
+
+/**
+ * @brief 指标注册表
+ */
+class Metrics
+{
+public:
+    static Counter& counter(const std::string& name, const std::string& help);
+    static Gauge& gauge(const std::string& name, const std::string& help);
+    static Histogram& histogram(const std::string& name, const std::string& help,
+                                const std::string& unit = "us");
+
+    /**
+     * @brief 按注册顺序返回所有指标的快照
+     */
+    static std::vector<MetricSnapshot> snapshotAll();
+
+    /**
+     * @brief Prometheus 文本格式（直方图按 summary 导出 p50/p90/p99/p999）
+     */
+    static std::string renderPrometheus();
+
+    /**
+     * @brief JSON 格式
+     */
+    static std::string renderJson();
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+/**
+ * @brief 作用域计时，析构时把耗时（微秒）记入直方图
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : m_histogram(histogram), m_startNs(Metrics::nowNs()) {}
+    ~ScopedTimer() {
+        m_histogram.record(static_cast<uint64_t>((Metrics::nowNs() - m_startNs) / 1000));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Histogram& m_histogram;
+    int64_t m_startNs;
+};
+
+// ========================================
+// 采集链路的固定指标
+// ========================================
+namespace PipelineMetrics {
+
+Counter& framesDecoded();       // CRC 校验通过的帧数
+Counter& crcFailures();         // CRC 校验失败的帧数
+Counter& samplesStored();       // 写入数据库的采样数
+Counter& dbWriteFailures();     // 写库失败次数
+Gauge& dbQueueDepth();          // 等待写库的采样数
+Histogram& dbCommitUs();        // 单次写库（提交）耗时
+Histogram& chartUpdateUs();     // 实时曲线刷新耗时
+Histogram& sampleToPixelUs();   // 解码到上屏的端到端延迟
+LatencyMark& sampleMark();
+
+} // namespace PipelineMetrics
+
+#endif // METRICS_H
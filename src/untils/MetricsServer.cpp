@@ -0,0 +1,103 @@
+#include "MetricsServer.h"
+
+#include <QHostAddress>
+#include <QTcpSocket>
+#include <QDebug>
+
+#include "Metrics.h"
+
+MetricsServer::MetricsServer(QObject* parent)
+    : QObject(parent)
+    , m_server(new QTcpServer(this)) {
+    connect(m_server, &QTcpServer::newConnection, this, &MetricsServer::onNewConnection);
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(quint16 port) {
+    if (port == 0) return false;
+    if (m_server->isListening()) return true;
+
+    if (!m_server->listen(QHostAddress::LocalHost, port)) {
+        qWarning() << "❌ 指标端口监听失败:" << port << m_server->errorString();
+        return false;
+    }
+    qDebug() << "📈 指标服务已启动: http://127.0.0.1:" << port << "/metrics";
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (m_server->isListening()) {
+        m_server->close();
+    }
+    for (QTcpSocket* socket : m_pending.keys()) {
+        socket->abort();
+        socket->deleteLater();
+    }
+    m_pending.clear();
+}
+
+void MetricsServer::onNewConnection() {
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        m_pending.insert(socket, QByteArray());
+        connect(socket, &QTcpSocket::readyRead, this, &MetricsServer::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_pending.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MetricsServer::onReadyRead() {
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket || !m_pending.contains(socket)) return;
+
+    QByteArray& buffer = m_pending[socket];
+    buffer += socket->readAll();
+
+    if (buffer.size() > MAX_REQUEST_BYTES) {
+        respond(socket, 431, "Request Header Fields Too Large", "text/plain", "request too large\n");
+        return;
+    }
+    if (!buffer.contains("\r\n\r\n")) return;   // 请求头未收完
+
+    // 请求行：METHOD PATH HTTP/1.x
+    const QList<QByteArray> requestLine = buffer.left(buffer.indexOf("\r\n")).split(' ');
+    if (requestLine.size() < 2 || requestLine[0] != "GET") {
+        respond(socket, 405, "Method Not Allowed", "text/plain", "only GET is supported\n");
+        return;
+    }
+
+    QByteArray path = requestLine[1];
+    const int query = path.indexOf('?');
+    if (query >= 0) path.truncate(query);
+
+    if (path == "/metrics") {
+        const std::string text = Metrics::renderPrometheus();
+        respond(socket, 200, "OK", "text/plain; version=0.0.4; charset=utf-8",
+                QByteArray(text.data(), static_cast<int>(text.size())));
+    } else if (path == "/metrics.json") {
+        const std::string json = Metrics::renderJson();
+        respond(socket, 200, "OK", "application/json",
+                QByteArray(json.data(), static_cast<int>(json.size())));
+    } else {
+        respond(socket, 404, "Not Found", "text/plain", "try /metrics or /metrics.json\n");
+    }
+}
+
+void MetricsServer::respond(QTcpSocket* socket, int status, const char* reason,
+                            const QByteArray& contentType, const QByteArray& body) {
+    QByteArray response;
+    response.reserve(body.size() + 160);
+    response += "HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n";
+    response += "Content-Type: " + contentType + "\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+
+    m_pending.remove(socket);
+    socket->write(response);
+    socket->disconnectFromHost();
+}
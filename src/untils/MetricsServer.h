@@ -0,0 +1,51 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <QHash>
+#include <QObject>
+#include <QTcpServer>
+
+class QTcpSocket;
+
+/**
+ * @brief 本地指标 HTTP 端点
+ *
+ * 只监听 127.0.0.1，支持：
+ * - GET /metrics       Prometheus 文本格式
+ * - GET /metrics.json  JSON 格式
+ * 每个连接处理一个请求后关闭。
+ */
+class MetricsServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsServer(QObject* parent = nullptr);
+    ~MetricsServer();
+
+    /**
+     * @brief 开始监听
+     * @param port 端口号（0 表示不启用）
+     * @return 是否成功
+     */
+    bool start(quint16 port);
+    void stop();
+
+    bool isListening() const { return m_server->isListening(); }
+    quint16 port() const { return m_server->serverPort(); }
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+private:
+    void respond(QTcpSocket* socket, int status, const char* reason,
+                 const QByteArray& contentType, const QByteArray& body);
+
+    QTcpServer* m_server;
+    QHash<QTcpSocket*, QByteArray> m_pending;   // 尚未收完请求头的连接
+
+    static constexpr int MAX_REQUEST_BYTES = 8192;
+};
+
+#endif // METRICSSERVER_H
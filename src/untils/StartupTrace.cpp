@@ -0,0 +1,103 @@
+#include "StartupTrace.h"
+
+#include <mutex>
+#include <vector>
+
+#include "Log.h"
+#include "Metrics.h"
+
+namespace {
+
+struct Phase {
+    const char* name;
+    int64_t startNs;
+    int64_t endNs;
+};
+
+struct TraceState {
+    std::mutex mutex;
+    int64_t originNs = 0;
+    int64_t lastMarkNs = 0;
+    bool finished = false;
+    std::vector<Phase> phases;
+};
+
+TraceState& state() {
+    static TraceState s;
+    return s;
+}
+
+Gauge& firstFrameMs() {
+    static Gauge& g = Metrics::gauge("gh_startup_first_frame_ms", "Time from process start to the first shown frame");
+    return g;
+}
+
+} // namespace
+
+void StartupTrace::begin() {
+    TraceState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.originNs = Metrics::nowNs();
+    s.lastMarkNs = s.originNs;
+    s.finished = false;
+    s.phases.clear();
+    s.phases.reserve(32);
+}
+
+void StartupTrace::mark(const char* phase) {
+    const int64_t nowNs = Metrics::nowNs();
+    int64_t startNs;
+    {
+        TraceState& s = state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        startNs = s.lastMarkNs;
+        s.lastMarkNs = nowNs;
+    }
+    record(phase, startNs, nowNs);
+}
+
+void StartupTrace::record(const char* phase, int64_t startNs, int64_t endNs) {
+    TraceState& s = state();
+    bool finished;
+    int64_t originNs;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        finished = s.finished;
+        originNs = s.originNs;
+        if (!finished) s.phases.push_back(Phase{phase, startNs, endNs});
+    }
+    if (finished) {
+        LOG_INFO("启动后阶段 {}：{} ms（启动后 {} ms 开始）", phase, (endNs - startNs) / 1000000,
+                 (startNs - originNs) / 1000000);
+    }
+}
+
+void StartupTrace::finish() {
+    const int64_t nowNs = Metrics::nowNs();
+    TraceState& s = state();
+    std::vector<Phase> phases;
+    int64_t originNs;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.finished) return;
+        s.finished = true;
+        s.phases.push_back(Phase{"等待首帧", s.lastMarkNs, nowNs});
+        phases = s.phases;
+        originNs = s.originNs;
+    }
+
+    const int64_t totalMs = (nowNs - originNs) / 1000000;
+    firstFrameMs().set(totalMs);
+    LOG_INFO("启动完成：首帧 {} ms，共 {} 个阶段", totalMs, static_cast<int64_t>(phases.size()));
+    for (const Phase& p : phases) {
+        LOG_INFO("  启动阶段 {}：{} ms（+{} ms）", p.name, (p.endNs - p.startNs) / 1000000,
+                 (p.startNs - originNs) / 1000000);
+    }
+}
+
+StartupTrace::Scope::Scope(const char* phase)
+    : m_phase(phase), m_startNs(Metrics::nowNs()) {}
+
+StartupTrace::Scope::~Scope() {
+    StartupTrace::record(m_phase, m_startNs, Metrics::nowNs());
+}
@@ -0,0 +1,52 @@
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <cstdint>
+
+/**
+ * @brief 启动耗时追踪
+ *
+ * main 的第一行调用 begin() 作为零点；main 中顺序执行的阶段用 mark() 划分
+ * （每次记录上一次 mark 到现在的耗时），其他位置的阶段用 Scope 记录起止时间。
+ * 首帧显示后调用 finish() 把各阶段耗时汇总写入日志，并更新 gh_startup_first_frame_ms 指标。
+ * finish() 之后的阶段（按需构建的页面、后台预加载等）逐条写入日志。
+ *
+ * 阶段名必须是字符串字面量（只保存指针）。可在任意线程调用。
+ */
+class StartupTrace
+{
+public:
+    static void begin();
+
+    /**
+     * @brief 结束一个顺序阶段：上一次 mark()（或 begin()）到现在
+     */
+    static void mark(const char* phase);
+
+    /**
+     * @brief 首帧已显示：输出启动汇总
+     */
+    static void finish();
+
+    /**
+     * @brief 作用域阶段，析构时记录
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(const char* phase);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_phase;
+        int64_t m_startNs;
+    };
+
+private:
+    static void record(const char* phase, int64_t startNs, int64_t endNs);
+};
+
+#endif // STARTUPTRACE_H
@@ -1,4 +1,64 @@
 #ifndef TIMERUTIL_H
 #define TIMERUTIL_H
 
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+namespace TimerUtil {
+
+/// "yyyy-MM-dd hh:mm:ss" 加结尾 '\0'
+constexpr std::size_t RECORD_TIME_SIZE = 20;
+
+/**
+ * @brief 把 Unix 毫秒格式化为本地时间 "yyyy-MM-dd hh:mm:ss"（与 SensorRecord::record_time 一致）
+ *
+ * 写入调用方提供的缓冲区，不分配内存；只在入库 / 导出等需要字符串的边界调用。
+ * @param out 至少 RECORD_TIME_SIZE 字节
+ * @return 写入的字符数（不含 '\0'），失败返回 0
+ */
+inline std::size_t formatRecordTime(int64_t tsMs, char* out) {
+    const std::time_t secs = static_cast<std::time_t>(tsMs / 1000);
+    std::tm local;
+#ifdef _WIN32
+    if (localtime_s(&local, &secs) != 0) { out[0] = '\0'; return 0; }
+#else
+    if (!localtime_r(&secs, &local)) { out[0] = '\0'; return 0; }
+#endif
+    return std::strftime(out, RECORD_TIME_SIZE, "%Y-%m-%d %H:%M:%S", &local);
+}
+
+/**
+ * @brief 把本地时间 "yyyy-MM-dd hh:mm:ss" 解析为 Unix 秒（formatRecordTime 的逆运算）
+ * @return 长度或格式不符时返回 false
+ */
+inline bool parseRecordTime(const char* text, std::size_t length, int64_t& secs) {
+    if (length != RECORD_TIME_SIZE - 1) return false;
+    static const char kLayout[] = "0000-00-00 00:00:00";
+    for (std::size_t i = 0; i < length; ++i) {
+        const bool digit = text[i] >= '0' && text[i] <= '9';
+        if (kLayout[i] == '0' ? !digit : text[i] != kLayout[i]) return false;
+    }
+    auto field = [text](int pos, int width) {
+        int value = 0;
+        for (int i = 0; i < width; ++i) value = value * 10 + (text[pos + i] - '0');
+        return value;
+    };
+
+    std::tm local = {};
+    local.tm_year = field(0, 4) - 1900;
+    local.tm_mon = field(5, 2) - 1;
+    local.tm_mday = field(8, 2);
+    local.tm_hour = field(11, 2);
+    local.tm_min = field(14, 2);
+    local.tm_sec = field(17, 2);
+    local.tm_isdst = -1;
+    const std::time_t t = std::mktime(&local);
+    if (t == static_cast<std::time_t>(-1)) return false;
+    secs = static_cast<int64_t>(t);
+    return true;
+}
+
+} // namespace TimerUtil
+
 #endif // TIMERUTIL_H
@@ -0,0 +1,262 @@
+#include "ActuatorAnalyticsViewModel.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QTimer>
+#include <string>
+
+#include "../model/Database/ConnectionManager.h"
+#include "../model/Database/SchemaMigrations.h"
+
+// ========================================
+// actuator_daily_rollup
+// ========================================
+
+namespace {
+
+// 写入的是当天的累计值（幂等），重复写同一天只覆盖
+const char* const kUpsertRollupSql =
+    "INSERT INTO actuator_daily_rollup(day, zone, covered_secs, fan_on_secs, pump_on_secs, lamp_on_secs,"
+    " fan_switches, pump_switches, lamp_switches, fan_wh, pump_wh, lamp_wh)"
+    " VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12)"
+    " ON CONFLICT(day, zone) DO UPDATE SET"
+    " covered_secs = excluded.covered_secs, fan_on_secs = excluded.fan_on_secs,"
+    " pump_on_secs = excluded.pump_on_secs, lamp_on_secs = excluded.lamp_on_secs,"
+    " fan_switches = excluded.fan_switches, pump_switches = excluded.pump_switches,"
+    " lamp_switches = excluded.lamp_switches, fan_wh = excluded.fan_wh,"
+    " pump_wh = excluded.pump_wh, lamp_wh = excluded.lamp_wh";
+
+const char* const kSelectRollupColumns =
+    "SELECT day, zone, covered_secs, fan_on_secs, pump_on_secs, lamp_on_secs,"
+    " fan_switches, pump_switches, lamp_switches, fan_wh, pump_wh, lamp_wh FROM actuator_daily_rollup ";
+
+const std::string kSelectDaySql = std::string(kSelectRollupColumns) + "WHERE day = ?1 AND zone = ?2";
+
+const std::string kSelectRangeSql = std::string(kSelectRollupColumns)
+    + "WHERE day BETWEEN ?1 AND ?2 AND (?3 < 0 OR zone = ?3) ORDER BY day, zone";
+
+ActuatorDailyRollup readRollup(const SqliteStatement& stmt) {
+    ActuatorDailyRollup rollup;
+    rollup.day = QString::fromStdString(stmt.columnText(0));
+    rollup.zone = stmt.columnInt(1);
+    rollup.coveredSecs = stmt.columnInt64(2);
+    rollup.fanOnSecs = stmt.columnInt64(3);
+    rollup.pumpOnSecs = stmt.columnInt64(4);
+    rollup.lampOnSecs = stmt.columnInt64(5);
+    rollup.fanSwitches = stmt.columnInt(6);
+    rollup.pumpSwitches = stmt.columnInt(7);
+    rollup.lampSwitches = stmt.columnInt(8);
+    rollup.fanWh = stmt.columnDouble(9);
+    rollup.pumpWh = stmt.columnDouble(10);
+    rollup.lampWh = stmt.columnDouble(11);
+    return rollup;
+}
+
+} // namespace
+
+ActuatorAnalyticsViewModel::ActuatorAnalyticsViewModel(QObject* parent)
+    : QObject(parent)
+    , m_flushTimer(new QTimer(this))
+    , m_fanPowerW(0)
+    , m_pumpPowerW(0)
+    , m_lampPowerW(0) {
+    // actuator_daily_rollup 表由 SchemaMigrations 维护
+    SchemaMigrations::ensureLatest();
+
+    // 统计每帧都在内存中更新，数据库只按周期写入
+    m_flushTimer->setInterval(FLUSH_INTERVAL_MS);
+    connect(m_flushTimer, &QTimer::timeout, this, &ActuatorAnalyticsViewModel::flush);
+    m_flushTimer->start();
+
+    // 本对象随主窗口在 ConnectionManager::shutdown() 之后才析构，最后一个周期在退出事件循环时写出
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &ActuatorAnalyticsViewModel::flush);
+
+    qDebug() << "📊 ActuatorAnalyticsViewModel 初始化完成";
+}
+
+ActuatorAnalyticsViewModel::~ActuatorAnalyticsViewModel() {
+    flush();
+}
+
+// ========================================
+// 配置
+// ========================================
+
+void ActuatorAnalyticsViewModel::setDevicePower(double fanW, double pumpW, double lampW) {
+    m_fanPowerW = fanW;
+    m_pumpPowerW = pumpW;
+    m_lampPowerW = lampW;
+}
+
+// ========================================
+// 增量统计
+// ========================================
+
+void ActuatorAnalyticsViewModel::onStateReceived(const ActuatorStateData& state, qint64 nowSecs, int zone) {
+    ZoneAccumulator& acc = m_zones[zone];
+    if (acc.dayEndSecs == 0) {
+        startDay(acc, zone, nowSecs);
+    }
+
+    // 上一帧到这一帧之间，设备保持上一帧的状态
+    if (acc.hasLast) {
+        const qint64 gap = nowSecs - acc.lastSecs;
+        if (gap > 0 && gap <= STALE_SECS) {
+            qint64 from = acc.lastSecs;
+            while (from < nowSecs) {
+                if (from >= acc.dayEndSecs) {
+                    // 跨零点：前一天的统计落盘，从新的一天继续
+                    persist(acc.today);
+                    startDay(acc, zone, from);
+                }
+                const qint64 until = qMin(nowSecs, acc.dayEndSecs);
+                accumulate(acc, acc.last, until - from);
+                from = until;
+            }
+        }
+    }
+    if (nowSecs >= acc.dayEndSecs) {
+        if (acc.dirty) persist(acc.today);
+        startDay(acc, zone, nowSecs);
+    }
+
+    if (acc.hasLast) {
+        if (!acc.last.fanStatus && state.fanStatus) ++acc.today.fanSwitches;
+        if (!acc.last.pumpStatus && state.pumpStatus) ++acc.today.pumpSwitches;
+        if (!acc.last.lampStatus && state.lampStatus) ++acc.today.lampSwitches;
+    }
+
+    acc.last = state;
+    acc.lastSecs = nowSecs;
+    acc.hasLast = true;
+    acc.dirty = true;
+}
+
+void ActuatorAnalyticsViewModel::startDay(ZoneAccumulator& acc, int zone, qint64 secs) {
+    const QDate date = QDateTime::fromSecsSinceEpoch(secs).date();
+    acc.dayEndSecs = QDateTime(date.addDays(1), QTime(0, 0)).toSecsSinceEpoch();
+    acc.today = ActuatorDailyRollup();
+    acc.today.day = date.toString("yyyy-MM-dd");
+    acc.today.zone = zone;
+    acc.dirty = false;
+
+    // 程序重启后接着当天已落盘的统计继续累加
+    const std::string day = acc.today.day.toStdString();
+    ReaderLease conn = ConnectionManager::instance().reader();
+    SqliteStatement* stmt = conn ? conn->prepare(kSelectDaySql) : nullptr;
+    if (!stmt) return;
+    SqliteStatementScope scope(*stmt);
+    stmt->bind(1, day);
+    stmt->bind(2, zone);
+    if (stmt->step() == SQLITE_ROW) {
+        acc.today = readRollup(*stmt);
+    }
+}
+
+void ActuatorAnalyticsViewModel::accumulate(ZoneAccumulator& acc, const ActuatorStateData& state, qint64 seconds) {
+    ActuatorDailyRollup& today = acc.today;
+    today.coveredSecs += seconds;
+    const double hours = seconds / 3600.0;
+
+    if (state.fanStatus) {
+        today.fanOnSecs += seconds;
+        // 下位机未上报转速时按全速计
+        const double speedRatio = state.fanSpeed > 0 ? qMin(state.fanSpeed, uint8_t(100)) / 100.0 : 1.0;
+        today.fanWh += m_fanPowerW * speedRatio * hours;
+    }
+    if (state.pumpStatus) {
+        today.pumpOnSecs += seconds;
+        today.pumpWh += m_pumpPowerW * hours;
+    }
+    if (state.lampStatus) {
+        today.lampOnSecs += seconds;
+        today.lampWh += m_lampPowerW * hours;
+    }
+}
+
+// ========================================
+// 持久化
+// ========================================
+
+void ActuatorAnalyticsViewModel::persist(const ActuatorDailyRollup& rollup) {
+    ConnectionManager::instance().post([rollup](SqliteConnection& conn) {
+        SqliteStatement* stmt = conn.prepare(kUpsertRollupSql);
+        if (!stmt) return;
+        const std::string day = rollup.day.toStdString();
+        SqliteStatementScope scope(*stmt);
+        stmt->bind(1, day);
+        stmt->bind(2, rollup.zone);
+        stmt->bind(3, static_cast<int64_t>(rollup.coveredSecs));
+        stmt->bind(4, static_cast<int64_t>(rollup.fanOnSecs));
+        stmt->bind(5, static_cast<int64_t>(rollup.pumpOnSecs));
+        stmt->bind(6, static_cast<int64_t>(rollup.lampOnSecs));
+        stmt->bind(7, rollup.fanSwitches);
+        stmt->bind(8, rollup.pumpSwitches);
+        stmt->bind(9, rollup.lampSwitches);
+        stmt->bind(10, rollup.fanWh);
+        stmt->bind(11, rollup.pumpWh);
+        stmt->bind(12, rollup.lampWh);
+        if (stmt->step() != SQLITE_DONE) {
+            qWarning() << "⚠️ 执行器统计写入失败:" << conn.lastError().c_str();
+        }
+    });
+}
+
+void ActuatorAnalyticsViewModel::flush() {
+    for (auto it = m_zones.begin(); it != m_zones.end(); ++it) {
+        if (!it->dirty) continue;
+        persist(it->today);
+        it->dirty = false;
+        emit rollupUpdated(it.key());
+    }
+}
+
+// ========================================
+// 查询
+// ========================================
+
+ActuatorDailyRollup ActuatorAnalyticsViewModel::today(int zone) const {
+    auto it = m_zones.constFind(zone);
+    return it != m_zones.constEnd() ? it->today : ActuatorDailyRollup();
+}
+
+QVector<ActuatorDailyRollup> ActuatorAnalyticsViewModel::queryDaily(const QDate& from, const QDate& to, int zone) {
+    QVector<ActuatorDailyRollup> result;
+    const std::string fromDay = from.toString("yyyy-MM-dd").toStdString();
+    const std::string toDay = to.toString("yyyy-MM-dd").toStdString();
+
+    {
+        ReaderLease conn = ConnectionManager::instance().reader();
+        SqliteStatement* stmt = conn ? conn->prepare(kSelectRangeSql) : nullptr;
+        if (!stmt) {
+            qWarning() << "⚠️ 执行器统计查询失败";
+            return result;
+        }
+        SqliteStatementScope scope(*stmt);
+        stmt->bind(1, fromDay);
+        stmt->bind(2, toDay);
+        stmt->bind(3, zone);
+        while (stmt->step() == SQLITE_ROW) {
+            result.append(readRollup(*stmt));
+        }
+    }
+
+    // 当天的统计以内存中的为准（数据库最多落后一个落盘周期）
+    for (auto it = m_zones.constBegin(); it != m_zones.constEnd(); ++it) {
+        const ActuatorDailyRollup& live = it->today;
+        if (live.day.isEmpty() || (zone >= 0 && live.zone != zone)) continue;
+        const std::string day = live.day.toStdString();
+        if (day < fromDay || day > toDay) continue;
+
+        bool replaced = false;
+        for (ActuatorDailyRollup& row : result) {
+            if (row.day == live.day && row.zone == live.zone) {
+                row = live;
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced) result.append(live);
+    }
+    return result;
+}
@@ -0,0 +1,127 @@
+#ifndef ACTUATORANALYTICSVIEWMODEL_H
+#define ACTUATORANALYTICSVIEWMODEL_H
+
+#pragma once
+#include <QObject>
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <QDate>
+#include "../model/ActuatorStateData.h"
+
+class QTimer;
+
+/**
+ * @brief 单个区域一天的执行器统计（对应 actuator_daily_rollup 表的一行）
+ */
+struct ActuatorDailyRollup {
+    QString day;              // "yyyy-MM-dd"（本地日期）
+    int zone = 0;             // 区域/节点编号，单节点时为 0
+
+    qint64 coveredSecs = 0;   // 有状态数据覆盖的秒数（占空比的分母）
+    qint64 fanOnSecs = 0;
+    qint64 pumpOnSecs = 0;
+    qint64 lampOnSecs = 0;
+
+    int fanSwitches = 0;      // 关→开 次数
+    int pumpSwitches = 0;
+    int lampSwitches = 0;
+
+    double fanWh = 0;         // 估算能耗（瓦时）
+    double pumpWh = 0;
+    double lampWh = 0;
+
+    double fanDutyCycle() const { return coveredSecs > 0 ? double(fanOnSecs) / coveredSecs : 0.0; }
+    double pumpDutyCycle() const { return coveredSecs > 0 ? double(pumpOnSecs) / coveredSecs : 0.0; }
+    double lampDutyCycle() const { return coveredSecs > 0 ? double(lampOnSecs) / coveredSecs : 0.0; }
+    double totalWh() const { return fanWh + pumpWh + lampWh; }
+};
+
+/**
+ * @brief 执行器统计 ViewModel（占空比 / 开启时长 / 开关次数 / 估算能耗）
+ *
+ * 职责：
+ * - 每收到一帧 ActuatorStateData，把上一帧到这一帧的时间累加到当天的统计中（增量计算）
+ * - 跨零点时按日期拆分时间段
+ * - 统计结果定期写入 actuator_daily_rollup，报表直接读汇总表，不再扫描原始历史
+ *
+ * 能耗按配置的设备额定功率估算；风扇功率按 fanSpeed 线性折算。
+ */
+class ActuatorAnalyticsViewModel : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ActuatorAnalyticsViewModel(QObject* parent = nullptr);
+    ~ActuatorAnalyticsViewModel();
+
+    // ========== 配置 ==========
+
+    /**
+     * @brief 设置设备额定功率
+     * @param fanW 风扇全速功率（W）
+     * @param pumpW 水泵功率（W）
+     * @param lampW 灯光功率（W）
+     */
+    void setDevicePower(double fanW, double pumpW, double lampW);
+
+    // ========== 数据输入 ==========
+
+    /**
+     * @brief 处理一帧执行器状态
+     * @param state 执行器状态
+     * @param nowSecs 收到该帧的时间（epoch 秒）
+     * @param zone 区域编号
+     */
+    void onStateReceived(const ActuatorStateData& state, qint64 nowSecs, int zone = 0);
+
+    // ========== 查询 ==========
+
+    /**
+     * @brief 获取某区域当天（内存中的最新值）统计
+     */
+    ActuatorDailyRollup today(int zone = 0) const;
+
+    /**
+     * @brief 查询日期范围内的每日统计（含当天未落盘的最新值）
+     * @param zone 区域编号，-1 表示全部区域
+     */
+    QVector<ActuatorDailyRollup> queryDaily(const QDate& from, const QDate& to, int zone = -1);
+
+    /**
+     * @brief 立即把未落盘的统计写入数据库
+     */
+    void flush();
+
+signals:
+    /**
+     * @brief 统计已写入数据库
+     * @param zone 区域编号
+     */
+    void rollupUpdated(int zone);
+
+private:
+    struct ZoneAccumulator {
+        bool hasLast = false;
+        ActuatorStateData last;
+        qint64 lastSecs = 0;
+        qint64 dayEndSecs = 0;          // 当天结束（次日 0 点）的 epoch 秒
+        ActuatorDailyRollup today;
+        bool dirty = false;
+    };
+
+    void startDay(ZoneAccumulator& acc, int zone, qint64 secs);
+    void accumulate(ZoneAccumulator& acc, const ActuatorStateData& state, qint64 seconds);
+    void persist(const ActuatorDailyRollup& rollup);
+
+    QMap<int, ZoneAccumulator> m_zones;
+    QTimer* m_flushTimer;
+
+    double m_fanPowerW;
+    double m_pumpPowerW;
+    double m_lampPowerW;
+
+    static constexpr int STALE_SECS = 120;          // 帧间隔超过该值时不计入统计（断线）
+    static constexpr int FLUSH_INTERVAL_MS = 60000; // 落盘周期
+};
+
+#endif // ACTUATORANALYTICSVIEWMODEL_H
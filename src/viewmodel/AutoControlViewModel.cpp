@@ -0,0 +1,202 @@
+#include "AutoControlViewModel.h"
+#include <QDebug>
+#include <cstdlib>
+
+#include "SensorViewModel.h"
+#include "../untils/Log.h"
+#include "../untils/Metrics.h"
+
+namespace {
+
+Counter& commandsIssued() {
+    static Counter& c = Metrics::counter("gh_autocontrol_commands_total", "Motor commands issued by the host control loop");
+    return c;
+}
+
+Counter& commandsThrottled() {
+    static Counter& c = Metrics::counter("gh_autocontrol_throttled_total", "Control decisions deferred by rate limiting");
+    return c;
+}
+
+// 风扇/水泵/灯光的开关组合编码
+int stateKey(uint8_t fan, uint8_t pump, uint8_t lamp) {
+    return (fan ? 1 : 0) | (pump ? 2 : 0) | (lamp ? 4 : 0);
+}
+
+// 阈值超出通道范围时，超出范围的一侧永远不会被越过（如光照关闭阈值 500 时灯永不关闭）
+void clampRule(HysteresisRule& rule, int minValue, int maxValue, const char* name) {
+    const int on = qBound(minValue, rule.onThreshold, maxValue);
+    const int off = qBound(minValue, rule.offThreshold, maxValue);
+    if (on == rule.onThreshold && off == rule.offThreshold) return;
+    LOG_WARN("{} 阈值 {}/{} 超出范围 [{}, {}]，已限制为 {}/{}", name, rule.onThreshold, rule.offThreshold,
+             minValue, maxValue, on, off);
+    rule.onThreshold = on;
+    rule.offThreshold = off;
+}
+
+ZoneRules clampRules(ZoneRules rules) {
+    clampRule(rules.fan, SensorViewModel::MIN_TEMPERATURE, SensorViewModel::MAX_TEMPERATURE, "风扇");
+    clampRule(rules.pump, SensorViewModel::MIN_HUMIDITY, SensorViewModel::MAX_HUMIDITY, "水泵");
+    clampRule(rules.lamp, SensorViewModel::MIN_LIGHT, SensorViewModel::MAX_LIGHT, "灯光");
+    return rules;
+}
+
+} // namespace
+
+AutoControlViewModel::AutoControlViewModel(QObject* parent)
+    : QObject(parent)
+    , m_enabled(false)
+    , m_fanKp(10.0)
+    , m_fanKi(0.05)
+    , m_debounceSamples(2)
+    , m_minDwellMs(30000)
+    , m_minCommandIntervalMs(1000)
+    , m_tokens(TOKEN_BUCKET_SIZE)
+    , m_lastRefillMs(-1) {
+    qDebug() << "🤖 AutoControlViewModel 初始化完成";
+}
+
+AutoControlViewModel::~AutoControlViewModel() = default;
+
+// ========================================
+// 配置
+// ========================================
+
+void AutoControlViewModel::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    // 重新启用时从头去抖，PI 积分清零
+    for (auto it = m_zones.begin(); it != m_zones.end(); ++it) {
+        it->pendingKey = -1;
+        it->pendingCount = 0;
+        it->fanIntegral = 0;
+        it->lastSampleMs = -1;
+    }
+    qDebug() << "🤖 上位机自动控制:" << (enabled ? "启用" : "停用");
+}
+
+void AutoControlViewModel::setDefaultRules(const ZoneRules& rules) {
+    m_defaultRules = clampRules(rules);
+}
+
+void AutoControlViewModel::setZoneRules(int zone, const ZoneRules& rules) {
+    ZoneControl& z = m_zones[zone];
+    z.rules = clampRules(rules);
+    z.hasRules = true;
+}
+
+// ========================================
+// 数据输入
+// ========================================
+
+void AutoControlViewModel::onActuatorState(const ActuatorStateData& state, qint64 nowMs, int zone) {
+    ZoneControl& z = m_zones[zone];
+    z.current = state;
+    z.lastFeedbackMs = nowMs;
+}
+
+void AutoControlViewModel::onSensorSample(const SensorSample& data) {
+    if (!m_enabled) return;
+
+    const qint64 nowMs = data.tsMs;
+    const int zone = data.deviceId;
+
+    ZoneControl& z = m_zones[zone];
+    // 下位机自己处于自动模式时不与其争夺控制权
+    if (z.current.autoMode) return;
+
+    const ZoneRules& rules = z.hasRules ? z.rules : m_defaultRules;
+    const ActuatorStateData& cur = z.current;
+
+    // 1. 滞回判断（规则非法时保持当前状态）
+    uint8_t fan = rules.fan.isValid() ? rules.fan.next(cur.fanStatus, data.airTemp) : cur.fanStatus;
+    uint8_t pump = rules.pump.isValid() ? rules.pump.next(cur.pumpStatus, data.soilHumid) : cur.pumpStatus;
+    uint8_t lamp = rules.lamp.isValid() ? rules.lamp.next(cur.lampStatus, data.lightIntensity) : cur.lampStatus;
+    uint8_t speed = fan ? computeFanSpeed(z, rules.fan, data.airTemp, nowMs) : 0;
+    if (!fan) z.fanIntegral = 0;
+
+    // 2. 最短开关间隔：未到时间的执行器保持原状态
+    const uint8_t currentBits[3] = {cur.fanStatus, cur.pumpStatus, cur.lampStatus};
+    uint8_t* desiredBits[3] = {&fan, &pump, &lamp};
+    for (int i = 0; i < 3; ++i) {
+        if (*desiredBits[i] != currentBits[i] && z.lastToggleMs[i] >= 0
+            && nowMs - z.lastToggleMs[i] < m_minDwellMs) {
+            *desiredBits[i] = currentBits[i];
+        }
+    }
+    if (!fan) speed = 0;
+
+    const int key = stateKey(fan, pump, lamp);
+    const bool speedChanged = fan && cur.fanStatus
+        && std::abs(static_cast<int>(speed) - static_cast<int>(cur.fanSpeed)) >= FAN_SPEED_DEADBAND;
+    if (key == stateKey(cur.fanStatus, cur.pumpStatus, cur.lampStatus) && !speedChanged) {
+        z.pendingKey = -1;
+        z.pendingCount = 0;
+        return;
+    }
+
+    // 3. 去抖：同一期望状态需连续出现 m_debounceSamples 次
+    if (key == z.pendingKey) {
+        ++z.pendingCount;
+    } else {
+        z.pendingKey = key;
+        z.pendingCount = 1;
+    }
+    if (z.pendingCount < m_debounceSamples) return;
+
+    // 4. 区域命令间隔 + 全局令牌桶
+    if ((z.lastCommandMs >= 0 && nowMs - z.lastCommandMs < m_minCommandIntervalMs) || !takeToken(nowMs)) {
+        commandsThrottled().inc();
+        return;
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        if (*desiredBits[i] != currentBits[i]) z.lastToggleMs[i] = nowMs;
+    }
+    z.lastCommandMs = nowMs;
+    z.pendingKey = -1;
+    z.pendingCount = 0;
+
+    // 在下一次状态上报之前，以已下发的命令作为当前状态，避免重复下发
+    z.current.fanStatus = fan;
+    z.current.fanSpeed = speed;
+    z.current.pumpStatus = pump;
+    z.current.lampStatus = lamp;
+
+    commandsIssued().inc();
+    LOG_INFO("自动控制 区域={} 风扇={} 转速={} 水泵={} 灯光={}", zone, fan, speed, pump, lamp);
+    emit motorCommandRequested(zone, fan, speed, pump, lamp);
+}
+
+// ========================================
+// 内部实现
+// ========================================
+
+uint8_t AutoControlViewModel::computeFanSpeed(ZoneControl& zone, const HysteresisRule& rule, int temperature, qint64 nowMs) {
+    // 误差：超出关闭阈值的温度
+    const double error = temperature - rule.offThreshold;
+    const double dt = zone.lastSampleMs >= 0 ? (nowMs - zone.lastSampleMs) / 1000.0 : 0.0;
+    zone.lastSampleMs = nowMs;
+
+    const double unclamped = MIN_FAN_SPEED + m_fanKp * error + m_fanKi * (zone.fanIntegral + error * dt);
+    // 抗积分饱和：输出已饱和且误差会继续推高时不再积分
+    if ((unclamped < 100 || error < 0) && (unclamped > MIN_FAN_SPEED || error > 0)) {
+        zone.fanIntegral += error * dt;
+    }
+
+    double speed = MIN_FAN_SPEED + m_fanKp * error + m_fanKi * zone.fanIntegral;
+    if (speed < MIN_FAN_SPEED) speed = MIN_FAN_SPEED;
+    if (speed > 100) speed = 100;
+    return static_cast<uint8_t>(speed + 0.5);
+}
+
+bool AutoControlViewModel::takeToken(qint64 nowMs) {
+    if (m_lastRefillMs >= 0) {
+        m_tokens += (nowMs - m_lastRefillMs) / 1000.0 * TOKENS_PER_SEC;
+        if (m_tokens > TOKEN_BUCKET_SIZE) m_tokens = TOKEN_BUCKET_SIZE;
+    }
+    m_lastRefillMs = nowMs;
+    if (m_tokens < 1.0) return false;
+    m_tokens -= 1.0;
+    return true;
+}
@@ -0,0 +1,157 @@
+#ifndef AUTOCONTROLVIEWMODEL_H
+#define AUTOCONTROLVIEWMODEL_H
+
+#pragma once
+#include <QObject>
+#include <QHash>
+#include "../model/SensorData.h"
+#include "../model/ActuatorStateData.h"
+
+/**
+ * @brief 滞回规则：测量值越过开启阈值时开启，回到关闭阈值另一侧时关闭
+ *
+ * - ActivateAbove（风扇）：温度 >= on 开启，<= off 关闭，要求 on > off
+ * - ActivateBelow（水泵、灯光）：湿度/光照 <= on 开启，>= off 关闭，要求 on < off
+ */
+struct HysteresisRule {
+    enum Direction { ActivateAbove, ActivateBelow };
+
+    int onThreshold = 0;
+    int offThreshold = 0;
+    Direction direction = ActivateAbove;
+
+    bool isValid() const {
+        return direction == ActivateAbove ? onThreshold > offThreshold : onThreshold < offThreshold;
+    }
+
+    /**
+     * @brief 根据当前开关状态和测量值给出下一状态（阈值之间保持不变）
+     */
+    bool next(bool isOn, int value) const {
+        if (direction == ActivateAbove) {
+            return isOn ? value > offThreshold : value >= onThreshold;
+        }
+        return isOn ? value < offThreshold : value <= onThreshold;
+    }
+};
+
+/**
+ * @brief 一个区域的控制规则
+ */
+struct ZoneRules {
+    HysteresisRule fan{30, 25, HysteresisRule::ActivateAbove};     // 空气温度
+    HysteresisRule pump{30, 50, HysteresisRule::ActivateBelow};    // 土壤湿度
+    HysteresisRule lamp{20, 50, HysteresisRule::ActivateBelow};    // 光照（%）
+};
+
+/**
+ * @brief 上位机闭环自动控制 ViewModel
+ *
+ * 职责：
+ * - 消费解码后的传感器数据，按区域执行滞回规则，风扇转速由 PI 控制器给出
+ * - 去抖：期望状态需连续 N 个样本一致才下发
+ * - 限流：每个执行器的最短开关间隔（防止频繁启停）、每个区域的最短命令间隔、
+ *   以及全局命令令牌桶（避免数百个区域同时下发时挤占链路）
+ * - 通过 motorCommandRequested 信号输出命令，由界面层转发给串口/WebSocket
+ *
+ * 每个样本只处理其所属区域，耗时与区域总数无关；下位机处于自动模式的区域不干预。
+ */
+class AutoControlViewModel : public QObject {
+    Q_OBJECT
+
+public:
+    explicit AutoControlViewModel(QObject* parent = nullptr);
+    ~AutoControlViewModel();
+
+    // ========== 配置 ==========
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief 设置默认规则（所有未单独配置的区域使用）
+     *
+     * 阈值限制在对应通道的有效范围内（SensorViewModel 的校验范围）；
+     * 限制后开启/关闭阈值重合的规则无效，对应执行器保持当前状态。
+     */
+    void setDefaultRules(const ZoneRules& rules);
+    const ZoneRules& defaultRules() const { return m_defaultRules; }
+
+    /**
+     * @brief 为指定区域单独设置规则（阈值限制同 setDefaultRules）
+     */
+    void setZoneRules(int zone, const ZoneRules& rules);
+
+    /**
+     * @brief 设置风扇转速 PI 参数
+     * @param kp 每超出关闭阈值 1°C 增加的转速（%）
+     * @param ki 积分系数（%/(°C·s)）
+     */
+    void setFanPid(double kp, double ki) { m_fanKp = kp; m_fanKi = ki; }
+
+    void setDebounceSamples(int samples) { m_debounceSamples = samples < 1 ? 1 : samples; }
+    void setMinDwellMs(qint64 ms) { m_minDwellMs = ms; }
+    void setMinCommandIntervalMs(qint64 ms) { m_minCommandIntervalMs = ms; }
+
+    // ========== 数据输入 ==========
+
+    /**
+     * @brief 处理一个传感器样本（可能产生一条控制命令）
+     *
+     * 样本时间取 data.tsMs（毫秒），区域取 data.deviceId。
+     */
+    void onSensorSample(const SensorSample& data);
+
+    /**
+     * @brief 下位机上报的执行器状态（作为滞回判断的当前状态）
+     */
+    void onActuatorState(const ActuatorStateData& state, qint64 nowMs, int zone = 0);
+
+signals:
+    /**
+     * @brief 请求下发电机控制命令
+     */
+    void motorCommandRequested(int zone, uint8_t fanStatus, uint8_t fanSpeed,
+                               uint8_t pumpStatus, uint8_t lampStatus);
+
+private:
+    struct ZoneControl {
+        bool hasRules = false;
+        ZoneRules rules;
+
+        ActuatorStateData current;       // 当前状态（上报值，或尚未确认的已下发命令）
+        qint64 lastFeedbackMs = 0;
+        qint64 lastCommandMs = -1;
+        qint64 lastToggleMs[3] = {-1, -1, -1};   // 风扇/水泵/灯光最近一次切换
+
+        int pendingKey = -1;             // 去抖中的期望状态
+        int pendingCount = 0;
+
+        double fanIntegral = 0;
+        qint64 lastSampleMs = -1;
+    };
+
+    uint8_t computeFanSpeed(ZoneControl& zone, const HysteresisRule& rule, int temperature, qint64 nowMs);
+    bool takeToken(qint64 nowMs);
+
+    bool m_enabled;
+    ZoneRules m_defaultRules;
+    QHash<int, ZoneControl> m_zones;
+
+    double m_fanKp;
+    double m_fanKi;
+    int m_debounceSamples;
+    qint64 m_minDwellMs;
+    qint64 m_minCommandIntervalMs;
+
+    // 全局令牌桶
+    double m_tokens;
+    qint64 m_lastRefillMs;
+
+    static constexpr int MIN_FAN_SPEED = 30;           // 风扇开启时的最低转速（%）
+    static constexpr int FAN_SPEED_DEADBAND = 10;      // 转速变化小于该值不下发
+    static constexpr double TOKEN_BUCKET_SIZE = 20;    // 全局突发命令数
+    static constexpr double TOKENS_PER_SEC = 10;       // 全局持续命令速率
+};
+
+#endif // AUTOCONTROLVIEWMODEL_H
@@ -1,13 +1,12 @@
 #include "ChartViewModel.h"
 #include <QFile>
-#include <QTextStream>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
 #include <QDebug>
 #include <algorithm>
 #include <numeric>
 
+#include "untils/Log.h"
+#include "untils/TimerUtil.h"
+
 ChartViewModel::ChartViewModel(QObject* parent)
     : QObject(parent) {
     qDebug() << "📊 ChartViewModel 初始化完成";
@@ -19,15 +18,14 @@ ChartViewModel::~ChartViewModel() = default;
 // 数据管理
 // ========================================
 
-void ChartViewModel::addData(const SensorRecord& data) {
+void ChartViewModel::addData(const SensorSample& data) {
     m_dataRecords.append(data);
     limitDataCount();
     
     emit dataAdded(data);
     emit statisticsUpdated();
     
-    qDebug() << "➕ 添加数据点: 总数=" << m_dataRecords.size()
-             << "Temp=" << data.air_temp << "°C";
+    LOG_DEBUG("添加数据点: 总数={} Temp={}°C", m_dataRecords.size(), data.airTemp);
 }
 
 void ChartViewModel::clearAllData() {
@@ -39,28 +37,28 @@ void ChartViewModel::clearAllData() {
     qDebug() << "清空所有数据";
 }
 
-QVector<SensorRecord> ChartViewModel::getDataInRange(const QDateTime& startTime, 
+QVector<SensorSample> ChartViewModel::getDataInRange(const QDateTime& startTime, 
                                                        const QDateTime& endTime) const {
-    QVector<SensorRecord> result;
+    QVector<SensorSample> result;
+    const qint64 startMs = startTime.toMSecsSinceEpoch();
+    const qint64 endMs = endTime.toMSecsSinceEpoch();
     
-    for (const auto& record : m_dataRecords) {
-        QString timeStr = QString::fromStdString(record.record_time);
-        QDateTime recordTime = QDateTime::fromString(timeStr, "yyyy-MM-dd hh:mm:ss");
-        
-        if (recordTime >= startTime && recordTime <= endTime) {
-            result.append(record);
+    for (const auto& sample : m_dataRecords) {
+        if (sample.tsMs >= startMs && sample.tsMs <= endMs) {
+            result.append(sample);
         }
     }
     
     return result;
 }
 
-QVector<SensorRecord> ChartViewModel::getLatestData(int count) const {
+QVector<SensorSample> ChartViewModel::getLatestData(int count) const {
     if (count >= m_dataRecords.size()) {
         return m_dataRecords;
     }
     
-    QVector<SensorRecord> result;
+    QVector<SensorSample> result;
+    result.reserve(count);
     int startIndex = m_dataRecords.size() - count;
     
     for (int i = startIndex; i < m_dataRecords.size(); ++i) {
@@ -75,39 +73,39 @@ QVector<SensorRecord> ChartViewModel::getLatestData(int count) const {
 // ========================================
 
 double ChartViewModel::getAverageTemperature(int startIndex, int endIndex) const {
-    return calculateAverage([](const SensorRecord& r) { return r.air_temp; }, 
+    return calculateAverage([](const SensorSample& r) { return r.airTemp; }, 
                             startIndex, endIndex);
 }
 
 double ChartViewModel::getAverageAirHumidity(int startIndex, int endIndex) const {
-    return calculateAverage([](const SensorRecord& r) { return r.air_humid; }, 
+    return calculateAverage([](const SensorSample& r) { return r.airHumid; }, 
                             startIndex, endIndex);
 }
 
 double ChartViewModel::getAverageSoilHumidity(int startIndex, int endIndex) const {
-    return calculateAverage([](const SensorRecord& r) { return r.soil_humid; }, 
+    return calculateAverage([](const SensorSample& r) { return r.soilHumid; }, 
                             startIndex, endIndex);
 }
 
 double ChartViewModel::getAverageLightIntensity(int startIndex, int endIndex) const {
-    return calculateAverage([](const SensorRecord& r) { return r.light_intensity; }, 
+    return calculateAverage([](const SensorSample& r) { return r.lightIntensity; }, 
                             startIndex, endIndex);
 }
 
 void ChartViewModel::getTemperatureRange(int& min, int& max) const {
-    calculateRange([](const SensorRecord& r) { return r.air_temp; }, min, max);
+    calculateRange([](const SensorSample& r) { return r.airTemp; }, min, max);
 }
 
 void ChartViewModel::getAirHumidityRange(int& min, int& max) const {
-    calculateRange([](const SensorRecord& r) { return r.air_humid; }, min, max);
+    calculateRange([](const SensorSample& r) { return r.airHumid; }, min, max);
 }
 
 void ChartViewModel::getSoilHumidityRange(int& min, int& max) const {
-    calculateRange([](const SensorRecord& r) { return r.soil_humid; }, min, max);
+    calculateRange([](const SensorSample& r) { return r.soilHumid; }, min, max);
 }
 
 void ChartViewModel::getLightIntensityRange(int& min, int& max) const {
-    calculateRange([](const SensorRecord& r) { return r.light_intensity; }, min, max);
+    calculateRange([](const SensorSample& r) { return r.lightIntensity; }, min, max);
 }
 
 // ========================================
@@ -115,65 +113,35 @@ void ChartViewModel::getLightIntensityRange(int& min, int& max) const {
 // ========================================
 
 bool ChartViewModel::exportToCSV(const QString& filePath) const {
-    QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    return exportTo(filePath, ExportFormat::Csv);
+}
+
+bool ChartViewModel::exportToJSON(const QString& filePath) const {
+    return exportTo(filePath, ExportFormat::Json);
+}
+
+bool ChartViewModel::exportTo(const QString& filePath, ExportFormat format) const {
+    // 与数据库导出共用流式写入器，逐行编码，不构造 QJsonArray
+    SensorExportWriter writer;
+    if (!writer.open(QFile::encodeName(filePath).toStdString(), format)) {
         qWarning() << "❌ 无法打开文件进行写入:" << filePath;
         return false;
     }
-    
-    QTextStream out(&file);
-    
-    // 写入 CSV 头部
-    out << "时间,温度(°C),空气湿度(%),土壤湿度(%),光照强度(Lux)\n";
-    
-    // 写入数据
-    for (const auto& record : m_dataRecords) {
-        out << QString::fromStdString(record.record_time) << ","
-            << record.air_temp << ","
-            << record.air_humid << ","
-            << record.soil_humid << ","
-            << record.light_intensity << "\n";
-    }
-    
-    file.close();
-    
-    qDebug() << "✅ 数据导出到 CSV:" << filePath << "行数=" << m_dataRecords.size();
-    
-    return true;
-}
 
-bool ChartViewModel::exportToJSON(const QString& filePath) const {
-    QJsonArray dataArray;
-    
-    for (const auto& record : m_dataRecords) {
-        QJsonObject obj;
-        obj["time"] = QString::fromStdString(record.record_time);
-        obj["temperature"] = record.air_temp;
-        obj["air_humidity"] = record.air_humid;
-        obj["soil_humidity"] = record.soil_humid;
-        obj["light_intensity"] = record.light_intensity;
-        
-        dataArray.append(obj);
+    // 时间字符串只在导出时格式化
+    char timeText[TimerUtil::RECORD_TIME_SIZE];
+    for (const auto& sample : m_dataRecords) {
+        const std::size_t timeLength = TimerUtil::formatRecordTime(sample.tsMs, timeText);
+        writer.writeRow(timeText, static_cast<int>(timeLength),
+                        sample.airTemp, sample.airHumid, sample.soilHumid, sample.lightIntensity);
     }
-    
-    QJsonObject root;
-    root["data"] = dataArray;
-    root["count"] = m_dataRecords.size();
-    root["export_time"] = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
-    
-    QJsonDocument doc(root);
-    
-    QFile file(filePath);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qWarning() << "❌ 无法打开文件进行写入:" << filePath;
+
+    if (!writer.finish()) {
+        qWarning() << "❌ 写入导出文件失败:" << filePath;
         return false;
     }
-    
-    file.write(doc.toJson(QJsonDocument::Indented));
-    file.close();
-    
-    qDebug() << "✅ 数据导出到 JSON:" << filePath << "行数=" << m_dataRecords.size();
-    
+
+    qDebug() << "✅ 数据导出:" << filePath << "行数=" << writer.rows();
     return true;
 }
 
@@ -184,6 +152,10 @@ bool ChartViewModel::exportToJSON(const QString& filePath) const {
 void ChartViewModel::setMaxDataCount(int maxCount) {
     m_maxDataCount = maxCount;
     limitDataCount();
+    if (maxCount > 0) {
+        // 多留一个位置：追加后再裁剪，稳态下不再扩容
+        m_dataRecords.reserve(maxCount + 1);
+    }
     
     qDebug() << "📏 设置最大数据点数量:" << maxCount;
 }
@@ -197,7 +169,7 @@ void ChartViewModel::limitDataCount() {
         int removeCount = m_dataRecords.size() - m_maxDataCount;
         m_dataRecords.remove(0, removeCount);
         
-        qDebug() << "✂️ 删除最旧的" << removeCount << "个数据点";
+        LOG_DEBUG("删除最旧的 {} 个数据点", removeCount);
     }
 }
 
@@ -6,6 +6,7 @@
 #include <QVector>
 #include <QDateTime>
 #include "../model/SensorData.h"
+#include "../model/DataExporter.h"
 
 /**
  * @brief 图表数据 ViewModel
@@ -26,10 +27,10 @@ public:
     // ========== 数据管理 ==========
     
     /**
-     * @brief 添加一条传感器数据
-     * @param data 传感器数据记录
+     * @brief 添加一条传感器样本
+     * @param data 传感器样本（平凡可复制，追加时不分配内存）
      */
-    void addData(const SensorRecord& data);
+    void addData(const SensorSample& data);
     
     /**
      * @brief 清空所有数据
@@ -46,7 +47,7 @@ public:
      * @brief 获取所有数据记录
      * @return 数据记录列表
      */
-    const QVector<SensorRecord>& getAllData() const { return m_dataRecords; }
+    const QVector<SensorSample>& getAllData() const { return m_dataRecords; }
     
     /**
      * @brief 获取指定范围的数据
@@ -54,14 +55,14 @@ public:
      * @param endTime 结束时间
      * @return 指定时间范围内的数据
      */
-    QVector<SensorRecord> getDataInRange(const QDateTime& startTime, const QDateTime& endTime) const;
+    QVector<SensorSample> getDataInRange(const QDateTime& startTime, const QDateTime& endTime) const;
     
     /**
      * @brief 获取最新的 N 条数据
      * @param count 数据条数
      * @return 最新的 N 条数据
      */
-    QVector<SensorRecord> getLatestData(int count) const;
+    QVector<SensorSample> getLatestData(int count) const;
 
     // ========== 数据统计 ==========
     
@@ -127,6 +128,8 @@ public:
 
     // ========== 数据导出 ==========
     
+    // 只导出内存中的图表窗口；数据库中的历史范围用 ExportViewModel 在后台导出
+
     /**
      * @brief 导出数据到 CSV 文件
      * @param filePath 文件路径
@@ -145,7 +148,7 @@ public:
     
     /**
      * @brief 设置最大数据点数量
-     * @param maxCount 最大数量（超过时自动删除最旧的数据）
+     * @param maxCount 最大数量（超过时自动删除最旧的数据），同时按此预留容量
      */
     void setMaxDataCount(int maxCount);
     
@@ -160,7 +163,7 @@ signals:
      * @brief 新数据添加
      * @param data 新添加的数据
      */
-    void dataAdded(const SensorRecord& data);
+    void dataAdded(const SensorSample& data);
     
     /**
      * @brief 数据清空
@@ -173,11 +176,14 @@ signals:
     void statisticsUpdated();
 
 private:
-    QVector<SensorRecord> m_dataRecords;  // 所有数据记录
+    QVector<SensorSample> m_dataRecords;  // 所有数据样本
     int m_maxDataCount = -1;              // 最大数据点数量（-1=无限制）
     
     // 辅助函数：限制数据点数量
     void limitDataCount();
+
+    // 辅助函数：按格式流式导出内存中的数据
+    bool exportTo(const QString& filePath, ExportFormat format) const;
     
     // 辅助函数：计算指定范围的平均值
     template<typename Func>
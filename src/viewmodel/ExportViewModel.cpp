@@ -0,0 +1,61 @@
+#include "ExportViewModel.h"
+#include <QDebug>
+#include <QFile>
+
+ExportViewModel::ExportViewModel(QObject* parent)
+    : QObject(parent) {
+    qDebug() << "📤 ExportViewModel 初始化完成";
+}
+
+ExportViewModel::~ExportViewModel() {
+    cancelExport();
+    joinWorker();
+}
+
+bool ExportViewModel::startExport(const QString& filePath, ExportFormat format,
+                                  const QDateTime& startTime, const QDateTime& endTime) {
+    if (m_running.exchange(true)) {
+        qWarning() << "⚠️ 已有导出任务在运行";
+        return false;
+    }
+    joinWorker();
+    m_cancel.store(false);
+
+    const std::string path = QFile::encodeName(filePath).toStdString();
+    const std::string start = startTime.toString("yyyy-MM-dd hh:mm:ss").toStdString();
+    const std::string end = endTime.toString("yyyy-MM-dd hh:mm:ss").toStdString();
+
+    qDebug() << "📤 开始导出:" << filePath << startTime << "-" << endTime;
+
+    m_worker = std::thread([this, path, format, start, end]() {
+        const DataExporter::Result result = DataExporter::exportRange(
+            path, format, start, end,
+            [this](int64_t rows, int64_t total) { emit exportProgress(rows, total); },
+            &m_cancel);
+
+        QString message;
+        if (result.ok) {
+            message = QString("导出完成：%1 行").arg(result.rows);
+        } else if (result.cancelled) {
+            message = QString("导出已取消：已写出 %1 行").arg(result.rows);
+        } else {
+            message = QString::fromStdString(result.error);
+        }
+
+        m_running.store(false);
+        emit exportFinished(result.ok, result.rows, message);
+    });
+    return true;
+}
+
+void ExportViewModel::cancelExport() {
+    if (m_running.load()) {
+        m_cancel.store(true);
+    }
+}
+
+void ExportViewModel::joinWorker() {
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
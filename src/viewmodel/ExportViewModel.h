@@ -0,0 +1,64 @@
+#ifndef EXPORTVIEWMODEL_H
+#define EXPORTVIEWMODEL_H
+
+#pragma once
+#include <QObject>
+#include <QDateTime>
+#include <QString>
+#include <atomic>
+#include <thread>
+#include "../model/DataExporter.h"
+
+/**
+ * @brief 历史数据导出 ViewModel
+ *
+ * 职责：
+ * - 在后台线程上把数据库中一个时间范围的数据流式导出为 CSV / JSON
+ * - 汇报进度，支持取消
+ *
+ * 同一时刻只运行一个导出任务。信号从后台线程发出，
+ * 连接到 UI 线程对象时由 Qt 自动排队到 UI 线程执行。
+ */
+class ExportViewModel : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ExportViewModel(QObject* parent = nullptr);
+    ~ExportViewModel();
+
+    /**
+     * @brief 开始导出 [startTime, endTime] 的数据
+     * @return 已有导出任务在运行时返回 false
+     */
+    bool startExport(const QString& filePath, ExportFormat format,
+                     const QDateTime& startTime, const QDateTime& endTime);
+
+    /**
+     * @brief 请求取消当前导出（已写出的部分保留在文件中）
+     */
+    void cancelExport();
+
+    bool isExporting() const { return m_running.load(); }
+
+signals:
+    /**
+     * @brief 导出进度
+     * @param rows 已导出行数
+     * @param total 总行数（未知时为 -1）
+     */
+    void exportProgress(qint64 rows, qint64 total);
+
+    /**
+     * @brief 导出结束（成功、失败或取消）
+     */
+    void exportFinished(bool ok, qint64 rows, const QString& message);
+
+private:
+    void joinWorker();
+
+    std::thread m_worker;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_cancel{false};
+};
+
+#endif // EXPORTVIEWMODEL_H
@@ -0,0 +1,85 @@
+#ifndef FRAMEHANDLERS_H
+#define FRAMEHANDLERS_H
+
+#include <QDateTime>
+
+#include "../common/FrameDispatcher.h"
+#include "../common/CommandScheduler.h"
+#include "untils/Log.h"
+
+/**
+ * @brief 上行帧处理函数（串口 / WebSocket 共用）
+ *
+ * ViewModel 需要提供 sensorDataReceived、actuatorStateReceived、timeWeatherReceived、
+ * heartBeatReceived、thresholdReceived 信号。
+ */
+namespace FrameHandlers {
+
+inline const char* commandName(uint8_t cmd) {
+    switch (cmd) {
+    case CMD_MOTOR_CRTL: return "电机控制";
+    case CMD_THRESHOLD: return "阈值设置";
+    case CMD_DATA_CRTL: return "数据采集";
+    case CMD_AUTO_MODE: return "模式切换";
+    case CMD_TIME_WEATHER: return "时间天气";
+    default: return "UNKNOWN";
+    }
+}
+
+template <typename ViewModel>
+void bind(FrameDispatcher& dispatcher, ViewModel* vm, CommandScheduler* scheduler) {
+    dispatcher.on<Protocol::SensorMessage>([vm](const SensorSample& decoded) {
+        SensorSample sample = decoded;
+        sample.tsMs = QDateTime::currentMSecsSinceEpoch();
+        emit vm->sensorDataReceived(sample);
+        LOG_DEBUG("接收传感器数据: Temp={} AirHum={} SoilHum={} Light={}",
+                  sample.airTemp, sample.airHumid, sample.soilHumid, sample.lightIntensity);
+    });
+
+    dispatcher.on<Protocol::MotorStateMessage>([vm](const ActuatorStateData& state) {
+        emit vm->actuatorStateReceived(state);
+        LOG_DEBUG("接收电机状态: Fan={} Pump={} Lamp={} Auto={}",
+                  state.fanStatus, state.pumpStatus, state.lampStatus, state.autoMode);
+    });
+
+    dispatcher.on<Protocol::TimeWeatherMessage>([vm](const TimeWeatherData& weather) {
+        emit vm->timeWeatherReceived(weather);
+        LOG_DEBUG("接收时间天气: {}:{} 天气码={} 温度={}",
+                  weather.hour, weather.minute, weather.weatherCode, weather.tempNow);
+    });
+
+    dispatcher.on<Protocol::CtrlAckMessage>([scheduler](const Protocol::CtrlAckData& ack) {
+        LOG_INFO("接收控制应答: {} CMD={} Result={}",
+                 commandName(ack.originalCmd), ack.originalCmd, (ack.result == 0x01 ? "成功" : "失败"));
+        scheduler->onAck(ack.originalCmd, ack.result);
+    });
+
+    dispatcher.on<Protocol::HeartBeatMessage>([vm](const Protocol::HeartBeatData& heartBeat) {
+        LOG_DEBUG("接收心跳包: 设备状态={}", (heartBeat.status == 0x01 ? "正常" : "异常"));
+        emit vm->heartBeatReceived();
+    });
+
+    dispatcher.on<Protocol::ThresholdReportMessage>([vm](const Threshold& threshold) {
+        emit vm->thresholdReceived(threshold);
+    });
+}
+
+/**
+ * @brief 分发一帧，未注册或长度不符的帧记录警告
+ */
+inline void dispatch(const FrameDispatcher& dispatcher, uint8_t cmd, const uint8_t* payload, uint8_t len) {
+    switch (dispatcher.dispatch(cmd, payload, len)) {
+    case FrameDispatcher::UnknownCommand:
+        LOG_WARN("未知命令: {}", cmd);
+        break;
+    case FrameDispatcher::LengthMismatch:
+        LOG_WARN("帧长度错误: CMD={} LEN={} 应为 {}", cmd, len, dispatcher.expectedLength(cmd));
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace FrameHandlers
+
+#endif // FRAMEHANDLERS_H
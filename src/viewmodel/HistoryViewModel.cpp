@@ -0,0 +1,184 @@
+#include "HistoryViewModel.h"
+#include <QDebug>
+#include <QTimer>
+#include "untils/StartupTrace.h"
+
+namespace {
+
+// 查询范围对齐到整秒（与 record_time 的精度一致）
+int64_t rangeStartMs(const QDateTime& time) { return time.toMSecsSinceEpoch() / 1000 * 1000; }
+int64_t rangeEndMs(const QDateTime& time) { return time.toMSecsSinceEpoch() / 1000 * 1000 + 999; }
+
+} // namespace
+
+HistoryViewModel::HistoryViewModel(QObject* parent)
+    : QObject(parent) {
+    // 缩放 / 平移 / 框选停下后，按新的可见跨度重新取对应级别的瓦片
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(REFRESH_DEBOUNCE_MS);
+    connect(m_refreshTimer, &QTimer::timeout, this, &HistoryViewModel::refreshIfNeeded);
+
+    // 后台取数线程（析构时停止并 join）
+    m_worker = std::thread(&HistoryViewModel::fetchLoop, this);
+    qDebug() << "📈 HistoryViewModel 初始化完成";
+}
+
+HistoryViewModel::~HistoryViewModel() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+// ========================================
+// 视口
+// ========================================
+
+void HistoryViewModel::query(const QDateTime& start, const QDateTime& end, bool preload) {
+    if (!start.isValid() || start >= end) return;
+    m_refreshTimer->stop();   // 查询结果会替换可见范围，之前等待中的刷新不再需要
+    requestFetch(m_visibleChannels, start, end, true, preload);
+}
+
+void HistoryViewModel::setRange(const QDateTime& start, const QDateTime& end) {
+    if (!start.isValid() || start >= end) return;
+    if (start == m_start && end == m_end) return;   // 各图表同步坐标轴时回传的相同范围
+
+    m_start = start;
+    m_end = end;
+    if (m_queryPending) {
+        // 用户在查询结果到达前缩放 / 平移：以最新的范围为准，查询结果到达时丢弃
+        m_queryPending = false;
+        ++m_generation;
+    }
+    emit rangeChanged(m_start, m_end);
+    m_refreshTimer->start();  // 连续滚动时重新计时，停下后才取数
+}
+
+void HistoryViewModel::setVisibleChannels(unsigned channelMask) {
+    if (channelMask == m_visibleChannels) return;
+    m_visibleChannels = channelMask;
+    if (!m_start.isValid() && !m_queryPending) return;   // 还没有范围，等首次查询
+
+    // 切换标签页是一次性的动作，不需要防抖
+    m_refreshTimer->stop();
+    refreshIfNeeded();
+}
+
+void HistoryViewModel::refreshIfNeeded() {
+    if (m_queryPending) {
+        // 查询还在进行：缺少可见通道时带上这些通道重新查询，结果仍按查询处理
+        if ((m_queryChannels & m_visibleChannels) != m_visibleChannels) {
+            requestFetch(m_queryChannels | m_visibleChannels, m_queryStart, m_queryEnd, true, false);
+        }
+        return;
+    }
+    if (!m_start.isValid()) return;
+
+    const int64_t fromMs = rangeStartMs(m_start);
+    const int64_t toMs = rangeEndMs(m_end);
+    const int level = HistoryTileCache::levelForSpan(toMs - fromMs, MAX_CHART_BUCKETS);
+    // 当前数据是同级别瓦片且覆盖了可见范围（小幅平移、查询结果自身设置的范围）时不再取数
+    if (m_dataset && m_dataset->covers(m_visibleChannels, level, fromMs, toMs)) return;
+
+    unsigned channels = m_visibleChannels;
+    // 只缺通道时新数据带上已有的通道，切回之前的标签页不必再取
+    if (m_dataset && m_dataset->covers(m_dataset->channels, level, fromMs, toMs)) {
+        channels |= m_dataset->channels;
+    }
+    requestFetch(channels, m_start, m_end, false, false);
+}
+
+// ========================================
+// 异步取数
+// ========================================
+
+void HistoryViewModel::requestFetch(unsigned channels, const QDateTime& start, const QDateTime& end,
+                                    bool isQuery, bool preload) {
+    FetchRequest request;
+    request.generation = ++m_generation;
+    request.channels = channels;
+    request.start = start;
+    request.end = end;
+    request.isQuery = isQuery;
+    request.preload = preload;
+
+    m_queryPending = isQuery;
+    if (isQuery) {
+        m_queryChannels = channels;
+        m_queryStart = start;
+        m_queryEnd = end;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 还没开始执行的旧请求直接被替换
+        m_pending = request;
+        m_hasPending = true;
+    }
+    m_cv.notify_one();
+}
+
+void HistoryViewModel::fetchLoop() {
+    for (;;) {
+        FetchRequest request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stopping || m_hasPending; });
+            if (m_stopping) return;
+            request = m_pending;
+            m_hasPending = false;
+        }
+
+        const int64_t fromMs = rangeStartMs(request.start);
+        const int64_t toMs = rangeEndMs(request.end);
+        const int level = HistoryTileCache::levelForSpan(toMs - fromMs, MAX_CHART_BUCKETS);
+        const int64_t span = HistoryTileCache::tileSpanMs(level);
+
+        auto dataset = std::make_shared<HistoryDataset>();
+        dataset->level = level;
+        dataset->fromMs = fromMs / span * span;   // fetch 返回整块瓦片
+        dataset->toMs = (toMs / span + 1) * span - 1;
+        dataset->channels = request.channels;
+        std::unique_ptr<StartupTrace::Scope> trace;
+        if (request.preload) {
+            trace = std::make_unique<StartupTrace::Scope>("历史数据预加载");
+        }
+        const bool ok = HistoryTileCache::instance().fetch(request.channels, level, fromMs, toMs, dataset->buckets);
+        trace.reset();   // 启动耗时只计取数本身
+
+        // 析构时先停止并 join 本线程；已排队但未执行的调用随对象析构一并丢弃
+        QMetaObject::invokeMethod(this, [this, request, ok, dataset]() {
+            onFetchFinished(request, ok, dataset);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void HistoryViewModel::onFetchFinished(const FetchRequest& request, bool ok,
+                                       const std::shared_ptr<HistoryDataset>& dataset) {
+    if (request.generation != m_generation) return;   // 之后又发出了新的请求，丢弃过期结果
+    if (request.isQuery) m_queryPending = false;
+
+    if (!ok) {
+        if (request.isQuery && !request.preload) {
+            emit queryFailed("数据库查询失败！");
+        } else {
+            qWarning() << "⚠️ 历史数据查询失败";
+        }
+        return;
+    }
+
+    // 先切换范围再替换数据：坐标轴同步时回传的范围与此相同，不会再触发取数
+    m_dataset = dataset;
+    if (request.isQuery) {
+        m_start = request.start;
+        m_end = request.end;
+        emit rangeChanged(m_start, m_end);
+    }
+    emit datasetChanged();
+}
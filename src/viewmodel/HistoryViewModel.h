@@ -0,0 +1,120 @@
+#ifndef HISTORYVIEWMODEL_H
+#define HISTORYVIEWMODEL_H
+
+#pragma once
+#include <QObject>
+#include <QDateTime>
+#include <QString>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "../model/Database/HistoryTileCache.h"
+
+class QTimer;
+
+/**
+ * @brief 历史曲线的一份降采样数据（所有图表共用，只读）
+ */
+struct HistoryDataset {
+    int level = -1;              // HistoryTileCache 的分辨率级别
+    int64_t fromMs = 0;          // 覆盖的瓦片范围（整块瓦片，可能超出可见范围）
+    int64_t toMs = -1;
+    unsigned channels = 0;       // 包含的通道（1 << SensorChannel）
+    HistoryBuckets buckets;
+
+    bool covers(unsigned needChannels, int needLevel, int64_t from, int64_t to) const {
+        return level == needLevel && (channels & needChannels) == needChannels && fromMs <= from && toMs >= to;
+    }
+};
+
+/**
+ * @brief 历史数据页的共享视口 ViewModel
+ *
+ * 职责：
+ * - 保存所有图表共用的可见时间范围：任一图表缩放 / 平移 / 框选都通过 setRange 修改，
+ *   rangeChanged 再同步到每个图表的 X 轴
+ * - 按可见跨度选择降采样级别，只为可见图表需要的通道取数；结果是一份 HistoryDataset，
+ *   各图表从中取自己的通道，不再各自查询、各自构造
+ * - 取数在后台线程执行，范围变化防抖后才发起；新请求发出后旧结果到达时丢弃，
+ *   新数据到达前保留当前数据
+ */
+class HistoryViewModel : public QObject {
+    Q_OBJECT
+
+public:
+    /// 每条曲线最多绘制的桶数（每个桶至多 2 个点），缩放到任何级别绘制开销都不变
+    static constexpr int MAX_CHART_BUCKETS = 1000;
+    /// 范围停止变化多久后再取数（连续滚轮缩放只取一次）
+    static constexpr int REFRESH_DEBOUNCE_MS = 150;
+
+    explicit HistoryViewModel(QObject* parent = nullptr);
+    ~HistoryViewModel();
+
+    /**
+     * @brief 查询：立即按范围取数，结果到达后切换可见范围并替换数据
+     * @param preload 启动预加载（记入启动耗时，失败时不提示）
+     */
+    void query(const QDateTime& start, const QDateTime& end, bool preload = false);
+
+    /**
+     * @brief 修改可见范围（缩放 / 平移）；当前数据不覆盖新范围时防抖后重新取数
+     */
+    void setRange(const QDateTime& start, const QDateTime& end);
+
+    /**
+     * @brief 设置可见图表需要的通道（切换标签页时调用）；当前数据缺少这些通道时取数
+     */
+    void setVisibleChannels(unsigned channelMask);
+
+    QDateTime rangeStart() const { return m_start; }
+    QDateTime rangeEnd() const { return m_end; }
+    std::shared_ptr<const HistoryDataset> dataset() const { return m_dataset; }
+
+signals:
+    void rangeChanged(const QDateTime& start, const QDateTime& end);
+    void datasetChanged();
+    /**
+     * @brief 查询失败（预加载和缩放取数失败只记日志）
+     */
+    void queryFailed(const QString& message);
+
+private:
+    struct FetchRequest {
+        uint64_t generation = 0;
+        unsigned channels = 0;
+        QDateTime start;
+        QDateTime end;
+        bool isQuery = false;
+        bool preload = false;
+    };
+
+    void requestFetch(unsigned channels, const QDateTime& start, const QDateTime& end,
+                      bool isQuery, bool preload);
+    void fetchLoop();
+    void onFetchFinished(const FetchRequest& request, bool ok, const std::shared_ptr<HistoryDataset>& dataset);
+    void refreshIfNeeded();
+
+    // ---------- 后台取数（只保留最新的一个请求） ----------
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    FetchRequest m_pending;
+    bool m_hasPending = false;
+    bool m_stopping = false;
+
+    // ---------- 以下只在 UI 线程访问 ----------
+    uint64_t m_generation = 0;
+    bool m_queryPending = false;     // 最新的请求是查询（结果到达后切换范围）
+    unsigned m_queryChannels = 0;
+    QDateTime m_queryStart;
+    QDateTime m_queryEnd;
+    QDateTime m_start;
+    QDateTime m_end;
+    unsigned m_visibleChannels = (1u << CHANNEL_COUNT) - 1;
+    std::shared_ptr<const HistoryDataset> m_dataset;
+    QTimer* m_refreshTimer = nullptr;
+};
+
+#endif // HISTORYVIEWMODEL_H
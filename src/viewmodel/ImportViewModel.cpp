@@ -0,0 +1,59 @@
+#include "ImportViewModel.h"
+#include <QDebug>
+#include <QFile>
+
+ImportViewModel::ImportViewModel(QObject* parent)
+    : QObject(parent) {
+    qDebug() << "📥 ImportViewModel 初始化完成";
+}
+
+ImportViewModel::~ImportViewModel() {
+    cancelImport();
+    joinWorker();
+}
+
+bool ImportViewModel::startImport(const QString& filePath) {
+    if (m_running.exchange(true)) {
+        qWarning() << "⚠️ 已有导入任务在运行";
+        return false;
+    }
+    joinWorker();
+    m_cancel.store(false);
+
+    const std::string path = QFile::encodeName(filePath).toStdString();
+
+    qDebug() << "📥 开始导入:" << filePath;
+
+    m_worker = std::thread([this, path]() {
+        const DataImporter::Result result = DataImporter::importCsv(
+            path, DataImporter::Options(),
+            [this](int64_t done, int64_t total) { emit importProgress(done, total); },
+            &m_cancel);
+
+        QString message;
+        if (result.ok) {
+            message = QString("导入完成：写入 %1 行，跳过重复 %2 行，格式错误 %3 行")
+                          .arg(result.rowsInserted).arg(result.duplicates).arg(result.malformed);
+        } else if (result.cancelled) {
+            message = QString("导入已取消：已写入 %1 行").arg(result.rowsInserted);
+        } else {
+            message = QString::fromStdString(result.error);
+        }
+
+        m_running.store(false);
+        emit importFinished(result.ok, result.rowsInserted, message);
+    });
+    return true;
+}
+
+void ImportViewModel::cancelImport() {
+    if (m_running.load()) {
+        m_cancel.store(true);
+    }
+}
+
+void ImportViewModel::joinWorker() {
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
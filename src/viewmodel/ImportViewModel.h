@@ -0,0 +1,63 @@
+#ifndef IMPORTVIEWMODEL_H
+#define IMPORTVIEWMODEL_H
+
+#pragma once
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <thread>
+#include "../model/DataImporter.h"
+
+/**
+ * @brief 历史数据导入 ViewModel
+ *
+ * 职责：
+ * - 在后台线程上把 CSV 文件批量导入数据库（格式与导出的 CSV 相同）
+ * - 汇报进度，支持取消
+ *
+ * 同一时刻只运行一个导入任务。信号从后台线程发出，
+ * 连接到 UI 线程对象时由 Qt 自动排队到 UI 线程执行。
+ */
+class ImportViewModel : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ImportViewModel(QObject* parent = nullptr);
+    ~ImportViewModel();
+
+    /**
+     * @brief 开始导入，已存在的同一时刻数据会被跳过
+     * @return 已有导入任务在运行时返回 false
+     */
+    bool startImport(const QString& filePath);
+
+    /**
+     * @brief 请求取消当前导入（已提交的部分保留在数据库中）
+     */
+    void cancelImport();
+
+    bool isImporting() const { return m_running.load(); }
+
+signals:
+    /**
+     * @brief 导入进度
+     * @param doneBytes 已处理字节数
+     * @param totalBytes 文件总字节数
+     */
+    void importProgress(qint64 doneBytes, qint64 totalBytes);
+
+    /**
+     * @brief 导入结束（成功、失败或取消）
+     * @param inserted 实际写入的行数
+     */
+    void importFinished(bool ok, qint64 inserted, const QString& message);
+
+private:
+    void joinWorker();
+
+    std::thread m_worker;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_cancel{false};
+};
+
+#endif // IMPORTVIEWMODEL_H
@@ -0,0 +1,257 @@
+#include "LinkSupervisorViewModel.h"
+#include <QDebug>
+#include <QTimer>
+
+#include "../untils/Log.h"
+#include "../untils/Metrics.h"
+
+namespace {
+
+Counter& linkStalls() {
+    static Counter& c = Metrics::counter("gh_link_stalls_total", "Active link stalls or unexpected disconnects");
+    return c;
+}
+
+Counter& linkRecoveries() {
+    static Counter& c = Metrics::counter("gh_link_recoveries_total", "Links restored after a stall");
+    return c;
+}
+
+Counter& linkFailovers() {
+    static Counter& c = Metrics::counter("gh_link_failovers_total", "Recoveries that switched to the alternate transport");
+    return c;
+}
+
+Histogram& linkOutageMs() {
+    static Histogram& h = Metrics::histogram("gh_link_outage_ms", "Time from last frame to first frame after recovery", "ms");
+    return h;
+}
+
+Gauge& heartBeatIntervalMs() {
+    static Gauge& g = Metrics::gauge("gh_link_heartbeat_interval_ms", "Smoothed heartbeat interval on the active link");
+    return g;
+}
+
+qint64 nowMs() {
+    return Metrics::nowNs() / 1000000;
+}
+
+const char* transportName(LinkSupervisorViewModel::Transport transport) {
+    return transport == LinkSupervisorViewModel::Serial ? "串口" : "WebSocket";
+}
+
+} // namespace
+
+LinkSupervisorViewModel::LinkSupervisorViewModel(QObject* parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_state(Idle)
+    , m_active(Serial)
+    , m_healthySinceMs(0)
+    , m_deadlineMs(0)
+    , m_lastSampleMs(-1)
+    , m_target(Serial)
+    , m_attemptOpen(false)
+    , m_attempt(0)
+    , m_backoffMs(INITIAL_BACKOFF_MS)
+    , m_attemptStartMs(0)
+    , m_nextAttemptMs(0)
+    , m_outageStartMs(0)
+    , m_stallTimeoutMs(5000)
+    , m_autoFailover(true) {
+    m_timer->setInterval(TICK_MS);
+    connect(m_timer, &QTimer::timeout, this, &LinkSupervisorViewModel::onTick);
+    qDebug() << "🩺 LinkSupervisorViewModel 初始化完成";
+}
+
+LinkSupervisorViewModel::~LinkSupervisorViewModel() = default;
+
+// ========================================
+// 配置 / 监测控制
+// ========================================
+
+void LinkSupervisorViewModel::setTransport(Transport transport, const TransportHooks& hooks) {
+    m_hooks[transport] = hooks;
+}
+
+void LinkSupervisorViewModel::start(Transport active) {
+    const qint64 now = nowMs();
+    m_state = Healthy;
+    m_active = active;
+    m_healthySinceMs = now;
+    m_deadlineMs = now + m_stallTimeoutMs;
+    m_lastSampleMs = -1;
+    m_attemptOpen = false;
+    m_pending.clear();
+    sampleFrames(now);
+    m_timer->start();
+    qDebug() << "🩺 开始监测链路:" << transportName(active);
+}
+
+void LinkSupervisorViewModel::stop() {
+    if (m_state == Idle) return;
+    m_timer->stop();
+    if (m_state == Recovering && m_attemptOpen) {
+        // 用户在恢复过程中手动断开：放弃正在进行的重连
+        m_hooks[m_target].close();
+    }
+    m_state = Idle;
+    m_attemptOpen = false;
+    m_pending.clear();
+    qDebug() << "🩺 停止监测链路";
+}
+
+void LinkSupervisorViewModel::onHeartBeat(Transport transport) {
+    LinkHealth& h = m_health[transport];
+    const qint64 now = nowMs();
+    if (h.lastHeartBeatMs >= 0) {
+        const double interval = static_cast<double>(now - h.lastHeartBeatMs);
+        h.heartBeatIntervalMs = h.heartBeatIntervalMs > 0 ? 0.8 * h.heartBeatIntervalMs + 0.2 * interval : interval;
+        if (transport == m_active) heartBeatIntervalMs().set(static_cast<int64_t>(h.heartBeatIntervalMs));
+    }
+    h.lastHeartBeatMs = now;
+    if (m_state == Healthy && transport == m_active) m_deadlineMs = now + m_stallTimeoutMs;
+}
+
+// ========================================
+// 周期检查
+// ========================================
+
+void LinkSupervisorViewModel::onTick() {
+    const qint64 now = nowMs();
+    sampleFrames(now);
+
+    if (m_state == Healthy) {
+        const LinkHealth& h = m_health[m_active];
+        const qint64 silent = now - qMax(qMax(h.lastFrameMs, h.lastHeartBeatMs), m_healthySinceMs);
+        // 截止时间在连接建立时设定，连接后一帧都没有收到（如下位机未上电）同样判定为停滞
+        if (!m_hooks[m_active].isConnected() || now >= m_deadlineMs) {
+            beginRecovery(now, silent);
+        }
+        return;
+    }
+
+    if (m_state != Recovering) return;
+
+    if (m_attemptOpen) {
+        // 新链路连上并且收到了帧才算恢复（WebSocket 连接是异步的）
+        if (m_hooks[m_target].isConnected() && m_health[m_target].lastFrameMs >= m_attemptStartMs) {
+            recovered(now);
+        } else if (now - m_attemptStartMs >= m_stallTimeoutMs) {
+            m_hooks[m_target].close();
+            attemptFailed(now);
+        }
+    } else if (now >= m_nextAttemptMs) {
+        attempt(now);
+    }
+}
+
+void LinkSupervisorViewModel::sampleFrames(qint64 now) {
+    const qint64 dt = m_lastSampleMs >= 0 ? now - m_lastSampleMs : 0;
+    m_lastSampleMs = now;
+
+    for (int i = 0; i < 2; ++i) {
+        if (!m_hooks[i].framesReceived) continue;
+        LinkHealth& h = m_health[i];
+        const quint64 frames = m_hooks[i].framesReceived();
+        const quint64 delta = frames >= h.frames ? frames - h.frames : 0;
+        h.frames = frames;
+        if (delta > 0) {
+            h.lastFrameMs = now;
+            if (m_state == Healthy && i == m_active) m_deadlineMs = now + m_stallTimeoutMs;
+        }
+        if (dt > 0) {
+            const double rate = delta * 1000.0 / dt;
+            h.frameRate = 0.8 * h.frameRate + 0.2 * rate;
+        }
+    }
+}
+
+// ========================================
+// 故障恢复
+// ========================================
+
+void LinkSupervisorViewModel::beginRecovery(qint64 now, qint64 silentMs) {
+    LinkHealth& h = m_health[m_active];
+    ++h.stalls;
+    linkStalls().inc();
+    LOG_WARN("链路故障: {} 已 {} ms 未收到数据", transportName(m_active), silentMs);
+
+    m_outageStartMs = h.lastFrameMs >= 0 ? h.lastFrameMs : now;
+    m_hooks[m_active].close();
+    collectPending(m_active);
+
+    m_state = Recovering;
+    m_attempt = 0;
+    m_backoffMs = INITIAL_BACKOFF_MS;
+    m_attemptOpen = false;
+    m_target = (m_autoFailover && hasHooks(other(m_active))) ? other(m_active) : m_active;
+    m_nextAttemptMs = now;
+
+    emit linkStalled(m_active, silentMs);
+}
+
+void LinkSupervisorViewModel::attempt(qint64 now) {
+    ++m_attempt;
+    emit reconnecting(m_target, m_attempt);
+    LOG_INFO("链路重连: {} 第 {} 次", transportName(m_target), m_attempt);
+
+    if (!m_hooks[m_target].open()) {
+        attemptFailed(now);
+        return;
+    }
+    m_attemptOpen = true;
+    m_attemptStartMs = now;
+}
+
+void LinkSupervisorViewModel::attemptFailed(qint64 now) {
+    m_attemptOpen = false;
+    m_nextAttemptMs = now + m_backoffMs;
+    m_backoffMs = m_backoffMs * 2 > MAX_BACKOFF_MS ? MAX_BACKOFF_MS : m_backoffMs * 2;
+    // 两种链路交替尝试，哪一边先恢复就用哪一边
+    if (m_autoFailover && hasHooks(other(m_target))) {
+        m_target = other(m_target);
+    }
+}
+
+void LinkSupervisorViewModel::recovered(qint64 now) {
+    const Transport previous = m_active;
+    const qint64 outageMs = now - m_outageStartMs;
+    linkRecoveries().inc();
+    linkOutageMs().record(static_cast<uint64_t>(outageMs));
+
+    m_state = Healthy;
+    m_active = m_target;
+    m_healthySinceMs = now;
+    m_deadlineMs = now + m_stallTimeoutMs;
+    m_attemptOpen = false;
+
+    const PendingCommands pending = m_pending;
+    m_pending.clear();
+    if (!pending.isEmpty() && m_hooks[m_active].replay) {
+        m_hooks[m_active].replay(pending);
+    }
+
+    LOG_INFO("链路恢复: {} 中断 {} ms，重放 {} 条命令", transportName(m_active), outageMs, pending.size());
+    if (m_active != previous) {
+        linkFailovers().inc();
+        emit activeTransportChanged(m_active);
+    }
+    emit linkRecovered(m_active, outageMs, pending.size());
+}
+
+void LinkSupervisorViewModel::collectPending(Transport transport) {
+    if (!m_hooks[transport].takePending) return;
+    // 同一 CMD 只保留最新的一条
+    for (const CommandScheduler::PendingCommand& command : m_hooks[transport].takePending()) {
+        bool replaced = false;
+        for (CommandScheduler::PendingCommand& existing : m_pending) {
+            if (existing.cmd == command.cmd) {
+                existing.payload = command.payload;
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced) m_pending.append(command);
+    }
+}
@@ -0,0 +1,164 @@
+#ifndef LINKSUPERVISORVIEWMODEL_H
+#define LINKSUPERVISORVIEWMODEL_H
+
+#pragma once
+#include <QObject>
+#include <QVector>
+#include <functional>
+
+#include "../common/CommandScheduler.h"
+
+class QTimer;
+
+/**
+ * @brief 链路健康监测与故障恢复 ViewModel
+ *
+ * 职责：
+ * - 统计每种连接方式的帧速率和心跳间隔
+ * - 活动链路维护一个接收截止时间：连接建立时设为 now + 停滞判定时间，每收到一帧或一次心跳顺延；
+ *   超过截止时间（包括连接后一帧都没有收到）或连接已断开时判定为故障
+ * - 故障后关闭原链路，按退避间隔重连；启用自动切换时在串口与 WebSocket 之间交替尝试
+ * - 新链路收到第一帧即视为恢复，重放故障时尚未确认的控制命令
+ *
+ * 只在用户手动连接成功后（start）开始监测，用户手动断开（stop）后停止。
+ * 实际的打开/关闭由界面层通过 TransportHooks 提供（串口参数、服务器地址等由界面层持有）。
+ */
+class LinkSupervisorViewModel : public QObject {
+    Q_OBJECT
+
+public:
+    enum Transport {
+        Serial = 0,       // 与 RealTimeDate::ConnectionMode 取值一致
+        WebSocket = 1
+    };
+
+    enum State {
+        Idle,             // 未监测
+        Healthy,          // 活动链路正常
+        Recovering        // 故障恢复中
+    };
+
+    using PendingCommands = QVector<CommandScheduler::PendingCommand>;
+
+    /**
+     * @brief 一种连接方式的操作接口
+     */
+    struct TransportHooks {
+        std::function<bool()> isConnected;
+        std::function<bool()> open;                       // 发起连接，false 表示无法发起（如未选择串口）
+        std::function<void()> close;
+        std::function<quint64()> framesReceived;          // 累计收到的有效帧数
+        std::function<PendingCommands()> takePending;     // 取出未确认的命令
+        std::function<void(const PendingCommands&)> replay;
+    };
+
+    /**
+     * @brief 一种连接方式的健康统计
+     */
+    struct LinkHealth {
+        quint64 frames = 0;
+        qint64 lastFrameMs = -1;
+        qint64 lastHeartBeatMs = -1;
+        double heartBeatIntervalMs = 0;   // 心跳间隔（指数平滑）
+        double frameRate = 0;             // 帧/秒（指数平滑）
+        int stalls = 0;
+    };
+
+    explicit LinkSupervisorViewModel(QObject* parent = nullptr);
+    ~LinkSupervisorViewModel();
+
+    // ========== 配置 ==========
+
+    void setTransport(Transport transport, const TransportHooks& hooks);
+    void setStallTimeoutMs(int ms) { m_stallTimeoutMs = ms < MIN_STALL_TIMEOUT_MS ? MIN_STALL_TIMEOUT_MS : ms; }
+    void setAutoFailover(bool enabled) { m_autoFailover = enabled; }
+
+    // ========== 监测控制 ==========
+
+    /**
+     * @brief 用户手动连接成功后开始监测
+     */
+    void start(Transport active);
+
+    /**
+     * @brief 用户手动断开时停止监测（丢弃待重放的命令）
+     */
+    void stop();
+
+    /**
+     * @brief 收到心跳帧
+     */
+    void onHeartBeat(Transport transport);
+
+    // ========== 状态查询 ==========
+
+    State state() const { return m_state; }
+    Transport activeTransport() const { return m_active; }
+    const LinkHealth& health(Transport transport) const { return m_health[transport]; }
+
+signals:
+    /**
+     * @brief 检测到链路故障
+     * @param silentMs 最后一帧距今的时间
+     */
+    void linkStalled(Transport transport, qint64 silentMs);
+
+    /**
+     * @brief 开始一次重连尝试
+     */
+    void reconnecting(Transport transport, int attempt);
+
+    /**
+     * @brief 链路恢复
+     * @param outageMs 中断时长
+     * @param replayed 重放的命令数
+     */
+    void linkRecovered(Transport transport, qint64 outageMs, int replayed);
+
+    /**
+     * @brief 故障切换后活动链路改变
+     */
+    void activeTransportChanged(Transport transport);
+
+private:
+    void onTick();
+    void sampleFrames(qint64 now);
+    void beginRecovery(qint64 now, qint64 silentMs);
+    void attempt(qint64 now);
+    void attemptFailed(qint64 now);
+    void recovered(qint64 now);
+    void collectPending(Transport transport);
+
+    bool hasHooks(Transport transport) const { return static_cast<bool>(m_hooks[transport].open); }
+    static Transport other(Transport transport) { return transport == Serial ? WebSocket : Serial; }
+
+    TransportHooks m_hooks[2];
+    LinkHealth m_health[2];
+    QTimer* m_timer;
+
+    State m_state;
+    Transport m_active;
+    qint64 m_healthySinceMs;
+    qint64 m_deadlineMs;          // 活动链路的接收截止时间
+    qint64 m_lastSampleMs;
+
+    // 故障恢复
+    Transport m_target;
+    bool m_attemptOpen;
+    int m_attempt;
+    int m_backoffMs;
+    qint64 m_attemptStartMs;
+    qint64 m_nextAttemptMs;
+    qint64 m_outageStartMs;
+    PendingCommands m_pending;
+
+    int m_stallTimeoutMs;
+    bool m_autoFailover;
+
+    static constexpr int TICK_MS = 250;
+    static constexpr int MIN_STALL_TIMEOUT_MS = 500;
+    static constexpr int INITIAL_BACKOFF_MS = 1000;
+    static constexpr int MAX_BACKOFF_MS = 30000;
+};
+
+#endif // LINKSUPERVISORVIEWMODEL_H
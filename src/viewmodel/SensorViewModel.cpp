@@ -2,41 +2,59 @@
 #include <QDateTime>
 #include <QDebug>
 
+#include "untils/Log.h"
+#include "untils/Metrics.h"
+#include "model/AnomalyEventStore.h"
+#include "common/ProtocolMessages.h"
+#include "untils/TimerUtil.h"
+
+namespace {
+
+Counter& anomaliesDetected() {
+    static Counter& c = Metrics::counter("gh_sensor_anomalies_total", "Sensor anomaly events (range, spike, rate, stuck)");
+    return c;
+}
+
+const char* channelName(SensorChannel channel) {
+    switch (channel) {
+    case CHANNEL_AIR_TEMP: return "温度";
+    case CHANNEL_AIR_HUMID: return "空气湿度";
+    case CHANNEL_SOIL_HUMID: return "土壤湿度";
+    case CHANNEL_LIGHT: return "光照强度";
+    default: return "未知通道";
+    }
+}
+
+} // namespace
+
 SensorViewModel::SensorViewModel(QObject* parent)
     : QObject(parent) {
     qDebug() << "🌡️ SensorViewModel 初始化完成";
 }
 
-// 辅助函数：大端转 int16_t
-static int16_t bigEndianToInt16(uint8_t high, uint8_t low) {
-    return (static_cast<int16_t>(high) << 8) | low;
-}
+SensorSample SensorViewModel::parseFromPayload(const QByteArray& payload) {
+    Q_ASSERT(payload.size() == static_cast<int>(Protocol::SensorMessage::SIZE));
 
-SensorRecord SensorViewModel::parseFromPayload(const QByteArray& payload) {
-    Q_ASSERT(payload.size() == 6);
+    SensorSample sample;
+    Protocol::SensorMessage::Layout::decode(reinterpret_cast<const uint8_t*>(payload.constData()), sample);
+    sample.tsMs = QDateTime::currentMSecsSinceEpoch();
 
-    const uint8_t* p = reinterpret_cast<const uint8_t*>(payload.constData());
+    LOG_DEBUG("解析传感器数据: Temp={}°C AirHum={}% SoilHum={}% Light={}Lux",
+              sample.airTemp, sample.airHumid, sample.soilHumid, sample.lightIntensity);
 
-    uint8_t airHum = p[0];
-    int16_t airTmp = bigEndianToInt16(p[1], p[2]);
-    uint8_t soilHum = p[3];
-    int16_t light = bigEndianToInt16(p[4], p[5]);
+    return sample;
+}
 
-    SensorRecord record;
-    record.record_time = QDateTime::currentDateTime()
-                            .toString("yyyy-MM-dd hh:mm:ss")
-                            .toStdString();
-    record.air_temp = static_cast<int>(airTmp);
-    record.air_humid = static_cast<int>(airHum);
-    record.soil_humid = static_cast<int>(soilHum);
-    record.light_intensity = static_cast<int>(light);
-
-    qDebug() << "📊 解析传感器数据:"
-             << "Temp:" << record.air_temp << "°C"
-             << "AirHum:" << record.air_humid << "%"
-             << "SoilHum:" << record.soil_humid << "%"
-             << "Light:" << record.light_intensity << "Lux";
+SensorRecord SensorViewModel::toRecord(const SensorSample& sample) {
+    char timeBuf[TimerUtil::RECORD_TIME_SIZE];
+    const std::size_t timeLen = TimerUtil::formatRecordTime(sample.tsMs, timeBuf);
 
+    SensorRecord record;
+    record.record_time.assign(timeBuf, timeLen);
+    record.air_temp = sample.airTemp;
+    record.air_humid = sample.airHumid;
+    record.soil_humid = sample.soilHumid;
+    record.light_intensity = sample.lightIntensity;
     return record;
 }
 
@@ -44,23 +62,23 @@ SensorRecord SensorViewModel::parseFromPayload(const QByteArray& payload) {
 // 数据验证
 // ========================================
 
-bool SensorViewModel::validateSensorData(const SensorRecord& record) {
-    bool tempValid = isValidTemperature(record.air_temp);
-    bool airHumValid = isValidHumidity(record.air_humid);
-    bool soilHumValid = isValidHumidity(record.soil_humid);
-    bool lightValid = isValidLightIntensity(record.light_intensity);
+bool SensorViewModel::validateSensorData(const SensorSample& sample) {
+    bool tempValid = isValidTemperature(sample.airTemp);
+    bool airHumValid = isValidHumidity(sample.airHumid);
+    bool soilHumValid = isValidHumidity(sample.soilHumid);
+    bool lightValid = isValidLightIntensity(sample.lightIntensity);
     
     if (!tempValid) {
-        qWarning() << "⚠️ 温度数据异常:" << record.air_temp << "°C";
+        qWarning() << "⚠️ 温度数据异常:" << sample.airTemp << "°C";
     }
     if (!airHumValid) {
-        qWarning() << "⚠️ 空气湿度数据异常:" << record.air_humid << "%";
+        qWarning() << "⚠️ 空气湿度数据异常:" << sample.airHumid << "%";
     }
     if (!soilHumValid) {
-        qWarning() << "⚠️ 土壤湿度数据异常:" << record.soil_humid << "%";
+        qWarning() << "⚠️ 土壤湿度数据异常:" << sample.soilHumid << "%";
     }
     if (!lightValid) {
-        qWarning() << "⚠️ 光照强度数据异常:" << record.light_intensity << "Lux";
+        qWarning() << "⚠️ 光照强度数据异常:" << sample.lightIntensity << "Lux";
     }
     
     return tempValid && airHumValid && soilHumValid && lightValid;
@@ -121,3 +139,38 @@ QString SensorViewModel::getLightLevel(int lightIntensity) {
     if (lightIntensity <= 3000) return "较亮";
     return "强光";
 }
+
+// ========================================
+// 异常检测
+// ========================================
+
+int SensorViewModel::detectAnomalies(const SensorSample& sample) {
+    AnomalyEvent events[AnomalyDetector::MAX_EVENTS_PER_SAMPLE];
+    const int count = m_detector.process(sample, events);
+    if (count == 0) return 0;
+
+    anomaliesDetected().inc(count);
+    for (int i = 0; i < count; ++i) {
+        AnomalyEventStore::instance().insert(events[i]);
+        const QString reason = describeAnomaly(events[i]);
+        LOG_WARN("传感器异常 区域={} {}", sample.deviceId, reason);
+        emit abnormalDataDetected(sample, reason);
+    }
+    return count;
+}
+
+QString SensorViewModel::describeAnomaly(const AnomalyEvent& event) {
+    const QString name = channelName(event.channel);
+    switch (event.kind) {
+    case ANOMALY_OUT_OF_RANGE:
+        return QString("%1超出量程: %2").arg(name).arg(event.value);
+    case ANOMALY_SPIKE:
+        return QString("%1突变: %2（z=%3）").arg(name).arg(event.value).arg(event.score, 0, 'f', 1);
+    case ANOMALY_RATE:
+        return QString("%1变化过快: %2/秒").arg(name).arg(event.score, 0, 'f', 2);
+    case ANOMALY_STUCK:
+        return QString("%1传感器疑似卡死: 连续 %2 个样本均为 %3").arg(name).arg(event.score).arg(event.value);
+    default:
+        return QString("%1异常").arg(name);
+    }
+}
@@ -4,6 +4,7 @@
 #pragma once
 #include <QObject>
 #include "../model/SensorData.h"
+#include "../model/AnomalyDetector.h"
 
 /**
  * @brief 传感器数据 ViewModel
@@ -21,20 +22,25 @@ public:
     explicit SensorViewModel(QObject* parent = nullptr);
 
     /**
-     * @brief 将下位机的 6 字节 payload 解析为 SensorRecord
+     * @brief 将下位机的 6 字节 payload 解析为 SensorSample
      * @param payload 必须是 6 字节（[airHum, tmpH, tmpL, soilHum, lightH, lightL]）
-     * @return 解析成功的 SensorRecord（时间由调用者设置）
+     * @return 解析成功的样本（tsMs 为当前时间）
      */
-    static SensorRecord parseFromPayload(const QByteArray& payload);
+    static SensorSample parseFromPayload(const QByteArray& payload);
+
+    /**
+     * @brief 样本转为 SensorRecord（record_time 由 tsMs 格式化），只在入库 / 导出边界使用
+     */
+    static SensorRecord toRecord(const SensorSample& sample);
 
     // ========== 数据验证 ==========
     
     /**
      * @brief 验证传感器数据是否有效
-     * @param record 传感器数据记录
+     * @param sample 传感器样本
      * @return true=数据有效, false=数据异常
      */
-    static bool validateSensorData(const SensorRecord& record);
+    static bool validateSensorData(const SensorSample& sample);
     
     /**
      * @brief 验证温度值是否在合理范围内
@@ -103,6 +109,30 @@ public:
      */
     static QString getLightLevel(int lightIntensity);
 
+    // ========== 异常检测 ==========
+
+    /**
+     * @brief 流式异常检测（量程、突刺、变化速率、卡死）
+     *
+     * 每个异常发出一次 abnormalDataDetected 并写入 anomaly_events 表。
+     * 正常样本不分配内存，单个样本耗时为常数。
+     * 样本时间取 sample.tsMs，区域取 sample.deviceId。
+     * @return 检测到的异常数
+     */
+    int detectAnomalies(const SensorSample& sample);
+
+    /**
+     * @brief 清空异常检测的历史统计（重新连接时调用）
+     */
+    void resetAnomalyDetection() { m_detector.reset(); }
+
+    AnomalyDetector& anomalyDetector() { return m_detector; }
+
+    /**
+     * @brief 异常事件的文字描述
+     */
+    static QString describeAnomaly(const AnomalyEvent& event);
+
 signals:
     /**
      * @brief 传感器数据更新
@@ -112,19 +142,22 @@ signals:
     
     /**
      * @brief 检测到异常数据
-     * @param record 异常的数据
+     * @param sample 异常的数据
      * @param reason 异常原因
      */
-    void abnormalDataDetected(const SensorRecord& record, const QString& reason);
+    void abnormalDataDetected(const SensorSample& sample, const QString& reason);
 
-private:
-    // 数据有效范围常量
+public:
+    // 数据有效范围常量（超出范围的样本校验失败；自动控制规则的阈值也限制在此范围内）
     static constexpr int MIN_TEMPERATURE = -20;  // 最低温度（°C）
     static constexpr int MAX_TEMPERATURE = 60;   // 最高温度（°C）
     static constexpr int MIN_HUMIDITY = 0;       // 最低湿度（%）
     static constexpr int MAX_HUMIDITY = 100;     // 最高湿度（%）
     static constexpr int MIN_LIGHT = 0;          // 最低光照（%）
     static constexpr int MAX_LIGHT = 100;      // 最高光照（%）
+
+private:
+    AnomalyDetector m_detector;
 };
 
 #endif // SENSORVIEWMODEL_H
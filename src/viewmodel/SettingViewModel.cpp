@@ -73,7 +73,7 @@ int SettingViewModel::getLampOnThreshold() const {
 void SettingViewModel::setLampOnThreshold(int value) {
     m_settings->setValue("threshold/lamp_on", value);
     emit thresholdChanged();
-    qDebug() << "⚙️ 设置灯光开启阈值:" << value << " Lux";
+    qDebug() << "⚙️ 设置灯光开启阈值:" << value << "%";
 }
 
 int SettingViewModel::getLampOffThreshold() const {
@@ -83,7 +83,7 @@ int SettingViewModel::getLampOffThreshold() const {
 void SettingViewModel::setLampOffThreshold(int value) {
     m_settings->setValue("threshold/lamp_off", value);
     emit thresholdChanged();
-    qDebug() << "⚙️ 设置灯光关闭阈值:" << value << " Lux";
+    qDebug() << "⚙️ 设置灯光关闭阈值:" << value << "%";
 }
 
 // ========================================
@@ -110,6 +110,16 @@ void SettingViewModel::setSerialBaudRate(int baudRate) {
     qDebug() << "⚙️ 设置串口波特率:" << baudRate;
 }
 
+QString SettingViewModel::getWebSocketUrl() const {
+    return m_settings->value("websocket/url", "ws://123.249.39.224:8080/").toString();
+}
+
+void SettingViewModel::setWebSocketUrl(const QString& url) {
+    m_settings->setValue("websocket/url", url);
+    emit serialSettingsChanged();
+    qDebug() << "⚙️ 设置WebSocket地址:" << url;
+}
+
 // ========================================
 // 图表设置
 // ========================================
@@ -168,6 +178,97 @@ void SettingViewModel::setAutoSaveToDatabase(bool enabled) {
     qDebug() << "⚙️ 设置自动保存到数据库:" << (enabled ? "启用" : "禁用");
 }
 
+int SettingViewModel::getHotCacheHours() const {
+    return m_settings->value("data/hot_cache_hours", DEFAULT_HOT_CACHE_HOURS).toInt();
+}
+
+void SettingViewModel::setHotCacheHours(int hours) {
+    m_settings->setValue("data/hot_cache_hours", hours);
+    qDebug() << "⚙️ 设置热数据缓存窗口:" << hours << "小时";
+}
+
+// ========================================
+// 诊断设置
+// ========================================
+
+int SettingViewModel::getMetricsPort() const {
+    return m_settings->value("diagnostics/metrics_port", DEFAULT_METRICS_PORT).toInt();
+}
+
+void SettingViewModel::setMetricsPort(int port) {
+    m_settings->setValue("diagnostics/metrics_port", port);
+    qDebug() << "⚙️ 设置指标端口:" << port;
+}
+
+// ========================================
+// 控制设置
+// ========================================
+
+bool SettingViewModel::getHostAutoControl() const {
+    return m_settings->value("control/host_auto", false).toBool();
+}
+
+void SettingViewModel::setHostAutoControl(bool enabled) {
+    m_settings->setValue("control/host_auto", enabled);
+    qDebug() << "⚙️ 设置上位机自动控制:" << enabled;
+    emit controlSettingsChanged();
+}
+
+// ========================================
+// 能耗设置
+// ========================================
+
+int SettingViewModel::getFanPowerW() const {
+    return m_settings->value("energy/fan_power_w", DEFAULT_FAN_POWER_W).toInt();
+}
+
+void SettingViewModel::setFanPowerW(int watts) {
+    m_settings->setValue("energy/fan_power_w", watts);
+    emit energySettingsChanged();
+}
+
+int SettingViewModel::getPumpPowerW() const {
+    return m_settings->value("energy/pump_power_w", DEFAULT_PUMP_POWER_W).toInt();
+}
+
+void SettingViewModel::setPumpPowerW(int watts) {
+    m_settings->setValue("energy/pump_power_w", watts);
+    emit energySettingsChanged();
+}
+
+int SettingViewModel::getLampPowerW() const {
+    return m_settings->value("energy/lamp_power_w", DEFAULT_LAMP_POWER_W).toInt();
+}
+
+void SettingViewModel::setLampPowerW(int watts) {
+    m_settings->setValue("energy/lamp_power_w", watts);
+    emit energySettingsChanged();
+}
+
+// ========================================
+// 链路设置
+// ========================================
+
+int SettingViewModel::getLinkStallTimeoutMs() const {
+    return m_settings->value("link/stall_timeout_ms", DEFAULT_LINK_STALL_TIMEOUT_MS).toInt();
+}
+
+void SettingViewModel::setLinkStallTimeoutMs(int ms) {
+    m_settings->setValue("link/stall_timeout_ms", ms);
+    qDebug() << "⚙️ 设置链路停滞判定时间:" << ms << "ms";
+    emit linkSettingsChanged();
+}
+
+bool SettingViewModel::getLinkAutoFailover() const {
+    return m_settings->value("link/auto_failover", true).toBool();
+}
+
+void SettingViewModel::setLinkAutoFailover(bool enabled) {
+    m_settings->setValue("link/auto_failover", enabled);
+    qDebug() << "⚙️ 设置链路自动切换:" << enabled;
+    emit linkSettingsChanged();
+}
+
 // ========================================
 // 通用设置
 // ========================================
@@ -194,6 +295,22 @@ void SettingViewModel::resetToDefaults() {
     // 数据采集
     setDataCollectionInterval(DEFAULT_DATA_INTERVAL);
     setAutoSaveToDatabase(true);
+    setHotCacheHours(DEFAULT_HOT_CACHE_HOURS);
+
+    // 诊断
+    setMetricsPort(DEFAULT_METRICS_PORT);
+
+    // 控制
+    setHostAutoControl(false);
+
+    // 能耗
+    setFanPowerW(DEFAULT_FAN_POWER_W);
+    setPumpPowerW(DEFAULT_PUMP_POWER_W);
+    setLampPowerW(DEFAULT_LAMP_POWER_W);
+
+    // 链路
+    setLinkStallTimeoutMs(DEFAULT_LINK_STALL_TIMEOUT_MS);
+    setLinkAutoFailover(true);
     
     saveSettings();
     
@@ -213,12 +330,15 @@ void SettingViewModel::loadSettings() {
     emit serialSettingsChanged();
     emit chartSettingsChanged();
     emit dataCollectionSettingsChanged();
+    emit controlSettingsChanged();
+    emit energySettingsChanged();
+    emit linkSettingsChanged();
     
     // 打印当前设置
     qDebug() << "📋 当前设置:";
     qDebug() << "  风扇阈值:" << getFanOffThreshold() << "-" << getFanOnThreshold() << "°C";
     qDebug() << "  水泵阈值:" << getPumpOffThreshold() << "-" << getPumpOnThreshold() << "%";
-    qDebug() << "  灯光阈值:" << getLampOffThreshold() << "-" << getLampOnThreshold() << " Lux";
+    qDebug() << "  灯光阈值:" << getLampOffThreshold() << "-" << getLampOnThreshold() << "%";
     qDebug() << "  串口波特率:" << getSerialBaudRate();
     qDebug() << "  图表最大点数:" << getChartMaxPoints();
     qDebug() << "  数据采集间隔:" << getDataCollectionInterval() << "秒";
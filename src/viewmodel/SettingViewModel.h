@@ -122,6 +122,18 @@ public:
      */
     void setSerialBaudRate(int baudRate);
 
+    /**
+     * @brief 获取 WebSocket 服务器地址
+     * @return 地址（如 "ws://127.0.0.1:9000/"，本地模拟器调试时使用）
+     */
+    QString getWebSocketUrl() const;
+    
+    /**
+     * @brief 设置 WebSocket 服务器地址
+     * @param url 地址
+     */
+    void setWebSocketUrl(const QString& url);
+
     // ========== 图表设置 ==========
     
     /**
@@ -186,6 +198,110 @@ public:
      */
     void setAutoSaveToDatabase(bool enabled);
 
+    /**
+     * @brief 获取内存热数据缓存的时间窗口（小时，0 表示不启用）
+     * @return 小时数
+     */
+    int getHotCacheHours() const;
+
+    /**
+     * @brief 设置内存热数据缓存的时间窗口（下次启动生效）
+     * @param hours 小时数，0 表示不启用
+     */
+    void setHotCacheHours(int hours);
+
+    // ========== 诊断设置 ==========
+
+    /**
+     * @brief 获取指标 HTTP 端口（仅监听 127.0.0.1，0 表示不启用）
+     * @return 端口号
+     */
+    int getMetricsPort() const;
+
+    /**
+     * @brief 设置指标 HTTP 端口
+     * @param port 端口号，0 表示不启用
+     */
+    void setMetricsPort(int port);
+
+    // ========== 控制设置 ==========
+
+    /**
+     * @brief 获取是否启用上位机闭环自动控制
+     * @return true=由上位机按阈值下发控制命令, false=不干预
+     */
+    bool getHostAutoControl() const;
+
+    /**
+     * @brief 设置是否启用上位机闭环自动控制
+     * @param enabled true=启用, false=停用
+     */
+    void setHostAutoControl(bool enabled);
+
+    // ========== 能耗设置 ==========
+
+    /**
+     * @brief 获取风扇全速功率
+     * @return 功率（W）
+     */
+    int getFanPowerW() const;
+
+    /**
+     * @brief 设置风扇全速功率
+     * @param watts 功率（W）
+     */
+    void setFanPowerW(int watts);
+
+    /**
+     * @brief 获取水泵功率
+     * @return 功率（W）
+     */
+    int getPumpPowerW() const;
+
+    /**
+     * @brief 设置水泵功率
+     * @param watts 功率（W）
+     */
+    void setPumpPowerW(int watts);
+
+    /**
+     * @brief 获取灯光功率
+     * @return 功率（W）
+     */
+    int getLampPowerW() const;
+
+    /**
+     * @brief 设置灯光功率
+     * @param watts 功率（W）
+     */
+    void setLampPowerW(int watts);
+
+    // ========== 链路设置 ==========
+
+    /**
+     * @brief 获取链路停滞判定时间（超过该时间未收到任何帧视为链路故障）
+     * @return 毫秒
+     */
+    int getLinkStallTimeoutMs() const;
+
+    /**
+     * @brief 设置链路停滞判定时间
+     * @param ms 毫秒
+     */
+    void setLinkStallTimeoutMs(int ms);
+
+    /**
+     * @brief 获取链路故障时是否自动切换到另一种连接方式
+     * @return true=串口/WebSocket 互为备份, false=只重连原链路
+     */
+    bool getLinkAutoFailover() const;
+
+    /**
+     * @brief 设置链路故障时是否自动切换
+     * @param enabled true=启用, false=停用
+     */
+    void setLinkAutoFailover(bool enabled);
+
     // ========== 通用设置 ==========
     
     /**
@@ -224,6 +340,21 @@ signals:
      */
     void dataCollectionSettingsChanged();
 
+    /**
+     * @brief 控制设置变化
+     */
+    void controlSettingsChanged();
+
+    /**
+     * @brief 能耗设置变化
+     */
+    void energySettingsChanged();
+
+    /**
+     * @brief 链路设置变化
+     */
+    void linkSettingsChanged();
+
 private:
     QSettings* m_settings;
     
@@ -232,12 +363,18 @@ private:
     static constexpr int DEFAULT_FAN_OFF = 25;
     static constexpr int DEFAULT_PUMP_ON = 30;
     static constexpr int DEFAULT_PUMP_OFF = 50;
-    static constexpr int DEFAULT_LAMP_ON = 200;
-    static constexpr int DEFAULT_LAMP_OFF = 500;
+    static constexpr int DEFAULT_LAMP_ON = 20;     // 光照为 0~100 的百分比
+    static constexpr int DEFAULT_LAMP_OFF = 50;
     static constexpr int DEFAULT_BAUD_RATE = 9600;
     static constexpr int DEFAULT_CHART_MAX_POINTS = 100;
     static constexpr int DEFAULT_CHART_TIME_WINDOW = 300;  // 5分钟
     static constexpr int DEFAULT_DATA_INTERVAL = 10;  // 10秒
+    static constexpr int DEFAULT_HOT_CACHE_HOURS = 48;
+    static constexpr int DEFAULT_METRICS_PORT = 9464;
+    static constexpr int DEFAULT_FAN_POWER_W = 20;
+    static constexpr int DEFAULT_PUMP_POWER_W = 35;
+    static constexpr int DEFAULT_LAMP_POWER_W = 15;
+    static constexpr int DEFAULT_LINK_STALL_TIMEOUT_MS = 5000;
 };
 
 #endif // SETTINGVIEWMODEL_H
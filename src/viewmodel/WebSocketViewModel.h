@@ -8,6 +8,10 @@
 #include "../model/SensorData.h"
 #include "../model/ActuatorStateData.h"
 #include "../common/Protocol.h"
+#include "../common/ProtocolParser.h"
+#include "../common/CommandScheduler.h"
+#include "../common/FrameBuilder.h"
+#include "../common/FrameDispatcher.h"
 #include "model/UserSetting.h"
 
 class WebSocketViewModel : public QObject {
@@ -28,12 +32,19 @@ public:
     void sendAutoModeControl(bool enable);
     void sendGetData(bool enable);
 
+    // ========== 链路恢复 ==========
+    quint64 framesReceived() const { return m_framesReceived; }                  // 累计收到的有效帧数
+    QVector<CommandScheduler::PendingCommand> takePendingCommands();            // 取出未确认的命令
+    void replayCommands(const QVector<CommandScheduler::PendingCommand>& commands);  // 重新提交命令
+
 signals:
-    void sensorDataReceived(const SensorRecord& data);         // 传感器数据
+    void sensorDataReceived(const SensorSample& data);         // 传感器数据
     void actuatorStateReceived(const ActuatorStateData& data); // 电机状态
     void timeWeatherReceived(const TimeWeatherData& data);     // 时间天气
     void heartBeatReceived();                                  // 心跳包接收
     void thresholdReceived(const Threshold &threshold);
+    void commandAcked(uint8_t cmd, bool success);               // 控制命令收到应答
+    void commandFailed(uint8_t cmd);                           // 控制命令重试后仍无应答
     void connected();
     void disconnected();
     void errorOccurred(const QString& error);
@@ -46,24 +57,24 @@ private slots:
     void onError(QAbstractSocket::SocketError error);
 
 private:
-    enum State {
-        WAIT_SOF,
-        WAIT_CMD,
-        WAIT_LEN,
-        WAIT_DATA,
-        WAIT_CRC
-    };
-
     QWebSocket* m_webSocket;
-    State m_state = WAIT_SOF;
-    uint8_t m_cmd = 0;
-    uint8_t m_len = 0;
-    QByteArray m_buffer;
-    int m_index = 0;
+    ProtocolParser m_parser;  // 帧解析状态机（与模拟器共用）
+    FrameDispatcher m_dispatcher;   // 按 CMD 查表解码并分发上行帧
+    CommandScheduler* m_scheduler;  // 下行命令调度（合并 / 应答匹配 / 重发）
+    FrameBuilder m_txFrames;        // 待写出的下行帧（同一轮事件循环内的帧合并为一次写）
+    bool m_txFlushPending;
+    quint64 m_framesReceived;
+    QVector<CommandScheduler::PendingCommand> m_unsentCommands;  // 断开时尚未确认的命令
+
+    bool sendFrame(uint8_t cmd, const uint8_t* payload, uint8_t len);  // 发送帧（由调度器调用）
+    void flushFrames();  // 一次性写出缓冲的所有帧
+    void submitCommand(uint8_t cmd, const uint8_t* payload, uint8_t len);  // 提交到调度器
 
-    uint8_t calcCRC(const uint8_t* data, int len);  // CRC-8计算
-    void processFrame(uint8_t cmd, const QByteArray& data);  // 处理接收到的帧
-    void sendFrame(uint8_t cmd, const uint8_t* payload, uint8_t len);  // 发送帧
+    template <typename Msg>
+    void submitMessage(const typename Msg::Type& value) {  // 按协议布局编码后提交
+        uint8_t payload[Msg::SIZE];
+        submitCommand(Msg::CMD, payload, Msg::encode(value, payload));
+    }
 };
 
 #endif // WEBSOCKETVIEWMODEL_H
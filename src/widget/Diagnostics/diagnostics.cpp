@@ -0,0 +1,129 @@
+#include "diagnostics.h"
+
+#include <QHeaderView>
+#include <QVBoxLayout>
+#include <QDebug>
+
+#include "untils/Metrics.h"
+
+namespace {
+
+// 列：指标 | 类型 | 计数/当前值 | 平均 | P50 | P90 | P99 | 最大
+enum Column {
+    COL_NAME,
+    COL_TYPE,
+    COL_VALUE,
+    COL_MEAN,
+    COL_P50,
+    COL_P90,
+    COL_P99,
+    COL_MAX,
+    COL_COUNT
+};
+
+// 微秒值转为易读文本
+QString formatMicros(double us) {
+    if (us < 1000.0) return QString::number(us, 'f', 0) + " µs";
+    if (us < 1000000.0) return QString::number(us / 1000.0, 'f', 2) + " ms";
+    return QString::number(us / 1000000.0, 'f', 2) + " s";
+}
+
+QString formatHistogramValue(double v, const std::string& unit) {
+    return unit == "us" ? formatMicros(v) : QString::number(v, 'f', 0);
+}
+
+} // namespace
+
+Diagnostics::Diagnostics(QWidget* parent)
+    : QWidget(parent)
+    , m_endpointLabel(new QLabel(this))
+    , m_table(new QTableWidget(0, COL_COUNT, this))
+    , m_refreshTimer(new QTimer(this))
+{
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(12);
+
+    m_endpointLabel->setStyleSheet("color: #5a6b8c; font-size: 13px;");
+    m_endpointLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    layout->addWidget(m_endpointLabel);
+
+    m_table->setHorizontalHeaderLabels({"指标", "类型", "计数/当前值", "平均", "P50", "P90", "P99", "最大"});
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionMode(QAbstractItemView::NoSelection);
+    m_table->horizontalHeader()->setSectionResizeMode(COL_NAME, QHeaderView::Stretch);
+    for (int c = COL_TYPE; c < COL_COUNT; ++c) {
+        m_table->horizontalHeader()->setSectionResizeMode(c, QHeaderView::ResizeToContents);
+    }
+    layout->addWidget(m_table, 1);
+
+    setEndpoint(QString());
+
+    m_refreshTimer->setInterval(1000);
+    connect(m_refreshTimer, &QTimer::timeout, this, &Diagnostics::refresh);
+}
+
+Diagnostics::~Diagnostics() = default;
+
+void Diagnostics::setEndpoint(const QString& url)
+{
+    m_endpointLabel->setText(url.isEmpty()
+        ? "指标 HTTP 端点未启用（设置 diagnostics/metrics_port 启用）"
+        : "指标 HTTP 端点：" + url + "（Prometheus 文本） / " + url + ".json");
+}
+
+void Diagnostics::refresh()
+{
+    const std::vector<MetricSnapshot> metrics = Metrics::snapshotAll();
+    m_table->setRowCount(static_cast<int>(metrics.size()));
+
+    auto setCell = [this](int row, int col, const QString& text) {
+        QTableWidgetItem* item = m_table->item(row, col);
+        if (!item) {
+            item = new QTableWidgetItem;
+            if (col != COL_NAME) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            m_table->setItem(row, col, item);
+        }
+        item->setText(text);
+    };
+
+    for (int row = 0; row < static_cast<int>(metrics.size()); ++row) {
+        const MetricSnapshot& m = metrics[row];
+        setCell(row, COL_NAME, QString::fromStdString(m.name));
+        m_table->item(row, COL_NAME)->setToolTip(QString::fromStdString(m.help));
+
+        if (m.type != MetricSnapshot::HISTOGRAM) {
+            setCell(row, COL_TYPE, m.type == MetricSnapshot::COUNTER ? "计数器" : "仪表");
+            setCell(row, COL_VALUE, QString::number(m.value));
+            for (int c = COL_MEAN; c < COL_COUNT; ++c) setCell(row, c, "-");
+            continue;
+        }
+
+        const HistogramSnapshot& h = m.histogram;
+        setCell(row, COL_TYPE, "直方图");
+        setCell(row, COL_VALUE, QString::number(h.count));
+        if (h.count == 0) {
+            for (int c = COL_MEAN; c < COL_COUNT; ++c) setCell(row, c, "-");
+            continue;
+        }
+        setCell(row, COL_MEAN, formatHistogramValue(h.mean(), m.unit));
+        setCell(row, COL_P50, formatHistogramValue(static_cast<double>(h.percentile(50)), m.unit));
+        setCell(row, COL_P90, formatHistogramValue(static_cast<double>(h.percentile(90)), m.unit));
+        setCell(row, COL_P99, formatHistogramValue(static_cast<double>(h.percentile(99)), m.unit));
+        setCell(row, COL_MAX, formatHistogramValue(static_cast<double>(h.max), m.unit));
+    }
+}
+
+void Diagnostics::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    refresh();
+    m_refreshTimer->start();
+}
+
+void Diagnostics::hideEvent(QHideEvent* event)
+{
+    QWidget::hideEvent(event);
+    m_refreshTimer->stop();
+}
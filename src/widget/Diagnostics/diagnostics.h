@@ -0,0 +1,40 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <QLabel>
+#include <QTableWidget>
+#include <QTimer>
+#include <QWidget>
+
+/**
+ * @brief 诊断页面 - 展示采集链路的计数器和延迟直方图
+ *
+ * 数据来源于 Metrics 注册表，仅在页面可见时每秒刷新一次。
+ */
+class Diagnostics : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit Diagnostics(QWidget* parent = nullptr);
+    ~Diagnostics();
+
+    /**
+     * @brief 设置 HTTP 端点说明（端口未启用时传空字符串）
+     */
+    void setEndpoint(const QString& url);
+
+public slots:
+    void refresh();
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private:
+    QLabel* m_endpointLabel;
+    QTableWidget* m_table;
+    QTimer* m_refreshTimer;
+};
+
+#endif // DIAGNOSTICS_H
@@ -9,10 +9,36 @@
 #include <QDateTimeAxis>
 #include <QValueAxis>
 #include <QVBoxLayout>
+#include <QDebug>
 #include "MyToast.h"
+#include "viewmodel/HistoryViewModel.h"
 
 QT_CHARTS_USE_NAMESPACE
 
+namespace {
+
+QDateTimeAxis* axisXOf(QChartView* view) {
+    if (!view || !view->chart()) return nullptr;
+    const auto axes = view->chart()->axes(Qt::Horizontal);
+    return axes.isEmpty() ? nullptr : qobject_cast<QDateTimeAxis*>(axes.at(0));
+}
+
+// 桶内只有一个值时画一个点，否则画最小值、最大值两个点（保留峰谷）
+QVector<QPointF> toPoints(const std::vector<TileBucket>& buckets, int64_t bucketMs) {
+    QVector<QPointF> points;
+    points.reserve(static_cast<int>(buckets.size()) * 2);
+    for (const TileBucket& bucket : buckets) {
+        const qreal x = static_cast<qreal>(bucket.startMs);
+        points.append(QPointF(x, bucket.minValue));
+        if (bucket.maxValue != bucket.minValue) {
+            points.append(QPointF(x + bucketMs / 2, bucket.maxValue));
+        }
+    }
+    return points;
+}
+
+} // namespace
+
 test::test(QWidget *parent) : QWidget(parent), ui(new Ui::test) {
     ui->setupUi(this);
     //设置默认时间范围（最近一天）
@@ -27,8 +53,27 @@ test::test(QWidget *parent) : QWidget(parent), ui(new Ui::test) {
     initAirChart();
     initSoilChart();
     initLightChart();
-    // 加载初始数据
-    updateChartData();
+
+    // 三个图表共用一个视口：任一坐标轴变化都写入视口，视口变化再同步到全部坐标轴
+    m_history = new HistoryViewModel(this);
+    connect(m_history, &HistoryViewModel::rangeChanged, this, &test::onViewportChanged);
+    connect(m_history, &HistoryViewModel::datasetChanged, this, [this]() { populateChart(currentChart()); });
+    connect(m_history, &HistoryViewModel::queryFailed, this, [this](const QString& message) {
+        QMessageBox::critical(this, "错误", message);
+    });
+    for (int i = 0; i < CHART_COUNT; ++i) {
+        if (QDateTimeAxis* axisX = axisXOf(chartView(i))) {
+            connect(axisX, &QDateTimeAxis::rangeChanged, this, [this](QDateTime min, QDateTime max) {
+                if (!m_syncingAxes) m_history->setRange(min, max);
+            });
+        }
+    }
+    // 只为当前标签页的图表取数 / 填充
+    connect(ui->tabSum, &QTabWidget::currentChanged, this, [this]() { onVisibleTabChanged(); });
+    m_history->setVisibleChannels(channelsOf(currentChart()));
+
+    // 加载初始数据（异步，记入启动耗时）
+    m_history->query(ui->dateStartTime->dateTime(), ui->dateOverTime->dateTime(), true);
 }
 //初始化空气温湿度图表
 void test::initAirChart() {
@@ -202,75 +247,88 @@ void test::updateChartData(bool resetZoom) {
         return;
     }
 
-    // 查询数据库数据
-    std::string startTime = start.toString("yyyy-MM-dd HH:mm:ss").toStdString();
-    std::string endTime = end.toString("yyyy-MM-dd HH:mm:ss").toStdString();
+    if (resetZoom) resetChartZoom();
+    // 查询降采样瓦片（已缓存的瓦片不再访问数据库），结果到达后切换视口，到达前保留当前曲线
+    m_history->query(start, end);
+}
+
+// ========================================
+// 共享视口
+// ========================================
+
+void test::onViewportChanged(const QDateTime& start, const QDateTime& end) {
+    // 根据时间跨度自动调整格式
+    const qint64 secs = start.secsTo(end);
+    const QString format = secs < 3600 ? "HH:mm:ss" : (secs < 86400 ? "MM-dd HH:mm" : "yyyy-MM-dd");
+
+    // 写回坐标轴时各坐标轴的 rangeChanged 不再回传给视口
+    m_syncingAxes = true;
+    for (int i = 0; i < CHART_COUNT; ++i) {
+        QDateTimeAxis* axisX = axisXOf(chartView(i));
+        if (!axisX) continue;
+        if (axisX->min() != start || axisX->max() != end) axisX->setRange(start, end);
+        axisX->setFormat(format);
+    }
+    m_syncingAxes = false;
+}
 
-    std::vector<SensorRecord> dataList;
-    bool querySuccess = Database::instance().queryByTime(startTime, endTime, dataList);
+void test::onVisibleTabChanged() {
+    const int chart = currentChart();
+    // 数据集缺少该图表的通道时视口会取数，到达后经 datasetChanged 填充
+    m_history->setVisibleChannels(channelsOf(chart));
+    populateChart(chart);
+}
 
-    if (!querySuccess) {
-        QMessageBox::critical(this, "错误", "数据库查询失败！");
-        return;
+void test::populateChart(int chart) {
+    if (chart < 0 || chart >= CHART_COUNT) return;
+    const auto dataset = m_history->dataset();
+    if (!dataset || dataset == m_shown[chart]) return;
+    const unsigned channels = channelsOf(chart);
+    if ((dataset->channels & channels) != channels) return;   // 缺少的通道正在取
+
+    // replace 一次性替换全部点，比逐点 append 少很多次重绘
+    const int64_t bucketMs = HistoryTileCache::bucketMs(dataset->level);
+    QLineSeries* const seriesOf[CHANNEL_COUNT] = {tempSeries, humiSeries, soilSeries, lightSeries};
+    for (int c = 0; c < CHANNEL_COUNT; ++c) {
+        if (channels & (1u << c)) seriesOf[c]->replace(toPoints(dataset->buckets[c], bucketMs));
     }
+    m_shown[chart] = dataset;
+}
 
-    // 更新图表数据系列
-    auto updateSeries = [](QLineSeries* series, const std::vector<SensorRecord>& data,
-                          std::function<double(const SensorRecord&)> getValue) {
-        series->clear();
-        for (const auto& d : data) {
-            QDateTime time = QDateTime::fromString(QString::fromStdString(d.record_time),
-                                                 "yyyy-MM-dd HH:mm:ss");
-            if (time.isValid()) {
-                series->append(time.toMSecsSinceEpoch(), getValue(d));
-            }
-        }
-    };
-
-    if (!dataList.empty()) {
-        updateSeries(tempSeries, dataList, [](const SensorRecord& d) { return d.air_temp; });
-        updateSeries(humiSeries, dataList, [](const SensorRecord& d) { return d.air_humid; });
-        updateSeries(lightSeries, dataList, [](const SensorRecord& d) { return d.light_intensity; });
-        updateSeries(soilSeries, dataList, [](const SensorRecord& d) { return d.soil_humid; });
-    } else {
-        // 无数据时清空图表
-        tempSeries->clear();
-        humiSeries->clear();
-        lightSeries->clear();
-        soilSeries->clear();
-        //QMessageBox::information(this, "提示", "所选时间范围内无数据！");
+void test::resetChartZoom() {
+    // 只清掉图表自身的缩放记录，范围由视口统一设置
+    m_syncingAxes = true;
+    for (int i = 0; i < CHART_COUNT; ++i) {
+        if (QChartView* view = chartView(i)) view->chart()->zoomReset();
     }
+    m_syncingAxes = false;
+    // zoomReset 会把坐标轴恢复成缩放前的范围，再对齐回当前视口
+    if (m_history->rangeStart().isValid()) onViewportChanged(m_history->rangeStart(), m_history->rangeEnd());
+}
 
-    // === 更新所有 X 轴范围 ===
-    auto updateAxis = [&](QChartView* view) {
-        if (!view) return;
-        auto axes = view->chart()->axes(Qt::Horizontal);
-        if (!axes.isEmpty()) {
-            QDateTimeAxis* axisX = qobject_cast<QDateTimeAxis*>(axes.at(0));
-            if (axisX) {
-                axisX->setRange(start, end);
-                // 根据时间跨度自动调整格式
-                qint64 secs = start.secsTo(end);
-                if (secs < 3600) {
-                    axisX->setFormat("HH:mm:ss");
-                } else if (secs < 86400) {
-                    axisX->setFormat("MM-dd HH:mm");
-                } else {
-                    axisX->setFormat("yyyy-MM-dd");
-                }
-            }
-        }
-    };
+int test::currentChart() const {
+    QWidget* tab = ui->tabSum->currentWidget();
+    if (tab == ui->tabAir) return CHART_AIR;
+    if (tab == ui->tabSoil) return CHART_SOIL;
+    if (tab == ui->tabLight) return CHART_LIGHT;
+    return CHART_AIR;
+}
 
-    updateAxis(airChartView);
-    updateAxis(lightChartView);
-    updateAxis(soilChartView);
+QChartView* test::chartView(int chart) const {
+    switch (chart) {
+    case CHART_AIR:   return airChartView;
+    case CHART_SOIL:  return soilChartView;
+    case CHART_LIGHT: return lightChartView;
+    default:          return nullptr;
+    }
+}
 
-    // === 是否重置缩放 ===
-    if (resetZoom) {
-        if (airChartView) airChartView->chart()->zoomReset();
-        if (lightChartView) lightChartView->chart()->zoomReset();
-        if (soilChartView) soilChartView->chart()->zoomReset();
+unsigned test::channelsOf(int chart) {
+    switch (chart) {
+    case CHART_AIR:   return (1u << CHANNEL_AIR_TEMP) | (1u << CHANNEL_AIR_HUMID);
+    case CHART_SOIL:  return 1u << CHANNEL_SOIL_HUMID;
+    case CHART_LIGHT: return 1u << CHANNEL_LIGHT;
+    default:          return 0;
     }
 }
 
@@ -286,7 +344,7 @@ bool test::eventFilter(QObject *watched, QEvent *event) {
 
         // 动态获取当前被操作的 ChartView
         QChartView *currentChartView = qobject_cast<QChartView*>(watched);
-        QDateTimeAxis *axisX = qobject_cast<QDateTimeAxis*>(currentChartView->chart()->axes(Qt::Horizontal).at(0));
+        QDateTimeAxis *axisX = axisXOf(currentChartView);
         if (!axisX) return false;
 
         // 获取当前时间范围
@@ -294,13 +352,13 @@ bool test::eventFilter(QObject *watched, QEvent *event) {
         QDateTime max = axisX->max();
         qint64 totalSecs = min.secsTo(max);
 
-        // 自动调整时间格式
-        if (totalSecs < 3600) {
-            axisX->setFormat("HH:mm:ss");
-        } else if (totalSecs < 86400) {
-            axisX->setFormat("MM-dd HH:mm");
-        } else {
-            axisX->setFormat("yyyy-MM-dd");
+        // Shift + 滚轮或横向滚轮：平移可见跨度的 10%（向上 / 向左 = 更早）
+        const QPoint delta = wheelEvent->angleDelta();
+        if (delta.x() != 0 || (wheelEvent->modifiers() & Qt::ShiftModifier)) {
+            const int direction = (delta.x() != 0 ? delta.x() : delta.y()) > 0 ? -1 : 1;
+            const qint64 shiftSecs = qMax<qint64>(1, totalSecs / 10) * direction;
+            m_history->setRange(min.addSecs(shiftSecs), max.addSecs(shiftSecs));
+            return true;
         }
 
         // 计算缩放比例（滚轮向上=放大，向下=缩小）
@@ -320,8 +378,8 @@ bool test::eventFilter(QObject *watched, QEvent *event) {
         QDateTime newMin = mouseDateTime.addSecs(-newSecs * mouseRatio);
         QDateTime newMax = mouseDateTime.addSecs(newSecs * (1 - mouseRatio));
 
-        // 更新X轴范围实现缩放
-        axisX->setRange(newMin, newMax);
+        // 修改共享视口：三个图表的 X 轴一起缩放，并按新跨度取数
+        m_history->setRange(newMin, newMax);
 
         // 阻止事件传递（避免滚动穿透）
         return true;
@@ -338,22 +396,9 @@ void test::on_pushQuery_clicked() {
 void test::on_pushClear_clicked() {
     ui->dateStartTime->setDateTime(QDateTime::currentDateTime().addDays(-2));
     ui->dateOverTime->setDateTime(QDateTime::currentDateTime().addDays(-1));
-    // 统一重置函数：安全处理单个 ChartView
-    auto resetChartXAxis = [&](QChartView *view) {
-        if (!view || !view->chart()) return;
-        auto axes = view->chart()->axes(Qt::Horizontal);
-        if (axes.isEmpty()) return;
-        QDateTimeAxis *axisX = qobject_cast<QDateTimeAxis*>(axes.at(0));
-        if (axisX) {
-            axisX->setRange(ui->dateStartTime->dateTime(), ui->dateOverTime->dateTime());
-            axisX->setFormat("yyyy-MM-dd");
-        }
-        view->chart()->zoomReset(); // 同时重置缩放
-    };
-    // 一键重置所有图表
-    resetChartXAxis(airChartView);
-    resetChartXAxis(lightChartView);
-    resetChartXAxis(soilChartView);
+    // 一键重置所有图表：清掉缩放记录，视口同步三个图表的坐标轴并按需取数
+    resetChartZoom();
+    m_history->setRange(ui->dateStartTime->dateTime(), ui->dateOverTime->dateTime());
 
     //updateChartData(true);
 }
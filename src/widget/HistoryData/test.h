@@ -4,10 +4,13 @@
 #include <qdatetime.h>
 #include <QWidget>
 #include <QtCharts>
+#include <memory>
 
 QVector<QPair<QDateTime, double>> generateDate(const QDateTime &start, const QDateTime &end, int count = 50);
 QVector<QPair<QDateTime, double>> generateDate(const QDateTime &start, const QDateTime &end, double minVal, double maxVal, int count = 50);
 class QVBoxLayout;
+class HistoryViewModel;
+struct HistoryDataset;
 
 namespace QtCharts {
     class QChartView;
@@ -41,7 +44,30 @@ private:
     QChartView *soilChartView = nullptr;  // 土壤湿度图表视图
     QChartView *lightChartView = nullptr; // 光照强度图表视图
 
+    enum ChartIndex {
+        CHART_AIR = 0,
+        CHART_SOIL,
+        CHART_LIGHT,
+        CHART_COUNT
+    };
+
     void updateChartData(bool resetZoom = false);
+
+    // ===== 共享视口 =====
+    // 三个图表的 X 轴联动：任一坐标轴变化（滚轮缩放 / 平移、框选放大）都交给 HistoryViewModel，
+    // 它的 rangeChanged 再同步到所有坐标轴。数据是一份共用的降采样数据集，
+    // 只填充当前标签页的图表，其余图表切换到时再从数据集取
+    void onViewportChanged(const QDateTime& start, const QDateTime& end);
+    void onVisibleTabChanged();
+    void populateChart(int chart);
+    void resetChartZoom();
+    int currentChart() const;
+    QChartView* chartView(int chart) const;
+    static unsigned channelsOf(int chart);
+
+    HistoryViewModel* m_history = nullptr;
+    bool m_syncingAxes = false;                                  // 正在把视口范围写回坐标轴
+    std::shared_ptr<const HistoryDataset> m_shown[CHART_COUNT];  // 各图表当前显示的数据集
     // Series 指针（用于更新数据）
     QLineSeries *tempSeries = nullptr;
     QLineSeries *humiSeries = nullptr;
@@ -4,22 +4,47 @@
 #include <QDebug>
 #include <QPushButton>
 
+#include "model/SensorBus.h"
+
 HomePage::HomePage(QWidget *parent)
     : QWidget(parent)
         , ui(new Ui::HomePage)
+        , m_updateTimer(new QTimer(this))
+        , m_busConsumer(-1)
 
 
 {
     ui->setupUi(this);
     loadStyleSheet();
 
+    // 首页只需要最新的环境数据：定时从样本总线读取，积压的旧样本直接跳过
+    m_busConsumer = SensorBus::instance().subscribe("home", SensorBus::DropOldest);
+    m_updateTimer->setInterval(UPDATE_INTERVAL_MS);
+    connect(m_updateTimer, &QTimer::timeout, this, &HomePage::pollSensorBus);
+    m_updateTimer->start();
 }
 
 HomePage::~HomePage()
 {
+    SensorBus::instance().unsubscribe(m_busConsumer);
     delete ui;
 }
 
+void HomePage::pollSensorBus()
+{
+    SensorSample latest;
+    bool updated = false;
+    SensorBus::instance().drain(m_busConsumer, [&latest, &updated](const SensorSample& sample) {
+        if (!(sample.flags & SAMPLE_VALID)) return;
+        latest = sample;
+        updated = true;
+    });
+    if (updated)
+    {
+        updateEnvironmentData(latest);
+    }
+}
+
 
 void HomePage::loadStyleSheet()
 {
@@ -37,32 +62,32 @@ void HomePage::loadStyleSheet()
 /**
  * 更新传感器数据（逻辑按你需要实现）
  */
-void HomePage::updateEnvironmentData(const SensorRecord& data)
+void HomePage::updateEnvironmentData(const SensorSample& data)
 {
 
     // ----- 写入控件 -----
 
-    ui->tempValue->setText(QString::number(data.air_temp)+"℃");
-    ui->humidityValue->setText(QString::number(data.air_humid) + " %");
-    ui->lightValue->setText(QString::number(data.light_intensity) + " %");
-    ui->soilValue->setText(QString::number(data.soil_humid) + " %");
+    ui->tempValue->setText(QString::number(data.airTemp)+"℃");
+    ui->humidityValue->setText(QString::number(data.airHumid) + " %");
+    ui->lightValue->setText(QString::number(data.lightIntensity) + " %");
+    ui->soilValue->setText(QString::number(data.soilHumid) + " %");
 
     // 状态判断
     updateCardStatus(ui->tempStatus,
-                     (data.air_temp > 30 ? "偏高" :
-                      data.air_temp < 15 ? "偏低" : "正常"));
+                     (data.airTemp > 30 ? "偏高" :
+                      data.airTemp < 15 ? "偏低" : "正常"));
 
     updateCardStatus(ui->humidityStatus,
-                     (data.air_humid > 70 ? "偏高" :
-                      data.air_humid < 40 ? "偏低" : "正常"));
+                     (data.airHumid > 70 ? "偏高" :
+                      data.airHumid < 40 ? "偏低" : "正常"));
 
     updateCardStatus(ui->lightStatus,
-                     (data.light_intensity < 200 ? "偏弱" :
-                      data.light_intensity > 800 ? "偏强" : "正常"));
+                     (data.lightIntensity < 200 ? "偏弱" :
+                      data.lightIntensity > 800 ? "偏强" : "正常"));
 
     updateCardStatus(ui->soilStatus,
-                     (data.soil_humid < 30 ? "偏干" :
-                      data.soil_humid > 70 ? "偏湿" : "正常"));
+                     (data.soilHumid < 30 ? "偏干" :
+                      data.soilHumid > 70 ? "偏湿" : "正常"));
 
     // 建议框
     updateSuggestion(data);
@@ -73,18 +98,18 @@ void HomePage::updateCardStatus(QLabel *statusLabel, const QString &status)
     statusLabel->setText("状态：" + status);
 }
 
-void HomePage::updateSuggestion(const SensorRecord& data)
+void HomePage::updateSuggestion(const SensorSample& data)
 {
     QString s;
 
 
-    if (data.air_temp > 30) s += "温度较高，建议通风降温。\n";
-    if (data.air_temp < 15) s += "温度偏低，可适当加热。\n";
+    if (data.airTemp > 30) s += "温度较高，建议通风降温。\n";
+    if (data.airTemp < 15) s += "温度偏低，可适当加热。\n";
 
-    if (data.air_humid < 40) s += "空气较干燥，可增加湿度。\n";
-    if (data.soil_humid < 30) s += "土壤偏干，可适当浇水。\n";
+    if (data.airHumid < 40) s += "空气较干燥，可增加湿度。\n";
+    if (data.soilHumid < 30) s += "土壤偏干，可适当浇水。\n";
 
-    if (data.light_intensity<30) s+="光线较暗，请及时开灯\n";
+    if (data.lightIntensity<30) s+="光线较暗，请及时开灯\n";
 
     if (s.isEmpty()) s = "环境正常，无需额外操作。";
 
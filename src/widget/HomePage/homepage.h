@@ -23,14 +23,17 @@ public:
     ~HomePage();
 
 public slots:
-    void updateEnvironmentData(const SensorRecord& data);
+    void updateEnvironmentData(const SensorSample& data);
 
 private:
     Ui::HomePage *ui;
     QTimer *m_updateTimer;
+    int m_busConsumer;  // 传感器样本总线消费者（只显示最新样本）
+    static constexpr int UPDATE_INTERVAL_MS = 500;
 
     void loadStyleSheet();
-    void updateSuggestion(const SensorRecord& data);
+    void pollSensorBus();
+    void updateSuggestion(const SensorSample& data);
     void updateCardStatus(QLabel* statusLabel, const QString& status);
 
 };
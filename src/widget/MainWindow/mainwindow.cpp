@@ -6,6 +6,11 @@
 #include "../Login/login.h"
 #include "../UserInfo/userinfo.h"
 #include "../HomePage/homepage.h"
+#include "../Diagnostics/diagnostics.h"
+#include "model/Database/HotTierCache.h"
+#include "untils/MetricsServer.h"
+#include "untils/StartupTrace.h"
+#include "viewmodel/SettingViewModel.h"
 
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -42,6 +47,8 @@ MainWindow::MainWindow(QWidget *parent)
     , m_realTimeDate(nullptr)
     , m_historyData(nullptr)
     , m_userInfoPage(nullptr)
+    , m_diagnostics(nullptr)
+    , m_metricsServer(nullptr)
     , m_currentPageIndex(0)
     , m_timeTimer(nullptr)
     , m_isLoggedIn(false)
@@ -93,11 +100,13 @@ void MainWindow::setupUI()
     
     // 设置导航
     setupNavigation();
-    connect(m_login,&Login::snedUserInfo,m_userInfoPage,&UserInfo::setCurrentUser);
-    connect(m_userInfoPage,&UserInfo::logOut,this,&MainWindow::setLoginState);
-    connect(m_realTimeDate,&RealTimeDate::sensorDataReceived,m_homePage,&HomePage::updateEnvironmentData);
+    // 用户管理页在收到登录用户信息时才构建（与 RealTimeDate 相关的连接在 ensurePage 中建立）
+    connect(m_login, &Login::snedUserInfo, this,
+            [this](int userId, const QString& username, const QString& password) {
+        ensurePage(PAGE_USERINFO);
+        m_userInfoPage->setCurrentUser(userId, username, password);
+    });
     connect(this->m_refreshBtn,&QPushButton::clicked,this,&MainWindow::sendGetData);
-    connect(this,&MainWindow::sendGetData,m_realTimeDate,&RealTimeDate::on_RefreshClicked);
 
 }
 
@@ -218,24 +227,24 @@ void MainWindow::setupContentArea()
     m_contentLayout->addWidget(m_stackedWidget, 1);  // 拉伸因子为1，支持自适应
     
     // 创建子页面（注意顺序：Login 作为第一个，HomePage 作为登录后的首页）
+    // 启动时只构建登录页；其余页面（图表、ViewModel、串口枚举、数据库查询）先用占位控件，
+    // 第一次切换到该页面时由 ensurePage 构建，缩短首帧时间
     m_login = new Login(this);
     m_stackedWidget->addWidget(m_login);  // 索引 0
-    
-    m_homePage = new HomePage(this);
-    m_homePage->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_stackedWidget->addWidget(m_homePage);  // 索引 1 - 首页
-    
-    m_realTimeDate = new RealTimeDate(this);
-    m_realTimeDate->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_stackedWidget->addWidget(m_realTimeDate);  // 索引 2
-    
-    m_historyData = new test(this);
-    m_historyData->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_stackedWidget->addWidget(m_historyData);  // 索引 3
-    
-    m_userInfoPage = new UserInfo(this);
-    m_userInfoPage->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_stackedWidget->addWidget(m_userInfoPage);  // 索引 4
+    for (int i = PAGE_HOME; i < PAGE_COUNT; ++i) {
+        m_stackedWidget->addWidget(new QWidget(m_stackedWidget));  // 索引 1~5：首页、实时数据、历史数据、用户管理、系统诊断
+    }
+
+    // 指标 HTTP 端点（仅本机访问）
+    SettingViewModel settings;
+    m_metricsServer = new MetricsServer(this);
+    const int metricsPort = settings.getMetricsPort();
+    if (metricsPort > 0 && m_metricsServer->start(static_cast<quint16>(metricsPort))) {
+        m_metricsEndpoint = QString("http://127.0.0.1:%1/metrics").arg(metricsPort);
+    }
+
+    // 最近数据的内存缓存在后台线程加载，不影响首帧
+    HotTierCache::instance().start(settings.getHotCacheHours());
     
     // 连接登录页面的信号
     connect(m_login, &Login::loginSuccess, this, &MainWindow::onLoginSuccess);
@@ -251,17 +260,18 @@ void MainWindow::setupContentArea()
 
 void MainWindow::setupNavigation()
 {
-    // 创建导航按钮（页面索引：0=登录, 1=首页, 2=实时数据, 3=历史数据, 4=用户管理）
+    // 创建导航按钮（页面索引：0=登录, 1=首页, 2=实时数据, 3=历史数据, 4=用户管理, 5=系统诊断）
     QStringList navItems = {
         "🔐 登录",
         "🏠 首页",
         "📊 实时数据",
         "📈 历史数据",
-        "👥 用户管理"
+        "👥 用户管理",
+        "🩺 系统诊断"
     };
     
     // 页面索引映射（导航按钮索引 -> 堆叠页面索引）
-    QList<int> pageIndices = {0, 1, 2, 3, 4};  // 登录, 首页, 实时数据, 历史数据, 用户管理
+    QList<int> pageIndices = {0, 1, 2, 3, 4, 5};  // 登录, 首页, 实时数据, 历史数据, 用户管理, 系统诊断
     
     for (int i = 0; i < navItems.size(); ++i) {
         QPushButton* btn = createNavButton("", navItems[i], pageIndices[i]);
@@ -280,6 +290,64 @@ void MainWindow::setupNavigation()
     updateNavigationButtons();
 }
 
+QWidget* MainWindow::ensurePage(int index)
+{
+    QWidget* page = nullptr;
+    switch (index) {
+    case PAGE_HOME:        page = m_homePage; break;
+    case PAGE_REALTIME:    page = m_realTimeDate; break;
+    case PAGE_HISTORY:     page = m_historyData; break;
+    case PAGE_USERINFO:    page = m_userInfoPage; break;
+    case PAGE_DIAGNOSTICS: page = m_diagnostics; break;
+    default:               return m_stackedWidget->widget(index);
+    }
+    if (page) return page;
+
+    static const char* const kPagePhases[PAGE_COUNT] = {
+        "构建页面：登录", "构建页面：首页", "构建页面：实时数据",
+        "构建页面：历史数据", "构建页面：用户管理", "构建页面：系统诊断"
+    };
+    StartupTrace::Scope trace(kPagePhases[index]);
+
+    switch (index) {
+    case PAGE_HOME:
+        m_homePage = new HomePage(this);
+        page = m_homePage;
+        break;
+    case PAGE_REALTIME:
+        m_realTimeDate = new RealTimeDate(this);
+        connect(this, &MainWindow::sendGetData, m_realTimeDate, &RealTimeDate::on_RefreshClicked);
+        page = m_realTimeDate;
+        break;
+    case PAGE_HISTORY:
+        m_historyData = new test(this);
+        page = m_historyData;
+        break;
+    case PAGE_USERINFO:
+        m_userInfoPage = new UserInfo(this);
+        connect(m_userInfoPage, &UserInfo::logOut, this, &MainWindow::setLoginState);
+        page = m_userInfoPage;
+        break;
+    case PAGE_DIAGNOSTICS:
+        m_diagnostics = new Diagnostics(this);
+        if (!m_metricsEndpoint.isEmpty()) {
+            m_diagnostics->setEndpoint(m_metricsEndpoint);
+        }
+        page = m_diagnostics;
+        break;
+    }
+    page->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+    // 用真正的页面替换同一索引上的占位控件
+    QWidget* placeholder = m_stackedWidget->widget(index);
+    m_stackedWidget->removeWidget(placeholder);
+    placeholder->deleteLater();
+    m_stackedWidget->insertWidget(index, page);
+
+    qDebug() << "🧩 页面按需构建完成:" << index;
+    return page;
+}
+
 QPushButton* MainWindow::createNavButton(const QString& icon, const QString& text, int pageIndex)
 {
     QPushButton* btn = new QPushButton(text, m_navMenu);
@@ -333,7 +401,8 @@ void MainWindow::switchToPage(int index)
         m_navButtons[i]->style()->polish(m_navButtons[i]);
     }
     
-    // 切换页面
+    // 切换页面（首次访问时构建）
+    ensurePage(index);
     m_stackedWidget->setCurrentIndex(index);
     m_currentPageIndex = index;
 
@@ -345,6 +414,7 @@ void MainWindow::switchToPage(int index)
     titles[2] = "实时数据监控";
     titles[3] = "历史数据查询";
     titles[4] = "用户管理";
+    titles[5] = "系统诊断";
     
     if (titles.contains(index)) {
         m_pageTitle->setText(titles[index]);
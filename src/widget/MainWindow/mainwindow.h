@@ -16,6 +16,8 @@ class test;  // HistoryData
 class Login;
 class UserInfo;
 class HomePage;
+class Diagnostics;
+class MetricsServer;
 
 namespace Ui {
 class MainWindow;
@@ -63,6 +65,20 @@ private:
     
     // 创建导航按钮
     QPushButton* createNavButton(const QString& icon, const QString& text, int pageIndex);
+
+    // 页面索引（与导航按钮、堆叠页面顺序一致）
+    enum PageIndex {
+        PAGE_LOGIN = 0,
+        PAGE_HOME,
+        PAGE_REALTIME,
+        PAGE_HISTORY,
+        PAGE_USERINFO,
+        PAGE_DIAGNOSTICS,
+        PAGE_COUNT
+    };
+
+    // 按需构建页面：启动时只构建登录页，其余页面先放占位控件，第一次切换到该页面时再构建
+    QWidget* ensurePage(int index);
     
     // UI 组件
     Ui::MainWindow *ui;
@@ -92,6 +108,11 @@ private:
     RealTimeDate* m_realTimeDate;
     test* m_historyData;
     UserInfo* m_userInfoPage;  // 避免与成员变量 m_userInfo 冲突
+    Diagnostics* m_diagnostics;
+
+    // 本地指标 HTTP 端点
+    MetricsServer* m_metricsServer;
+    QString m_metricsEndpoint;  // 诊断页构建时设置
     
     // 导航按钮列表
     QList<QPushButton*> m_navButtons;
@@ -15,6 +15,7 @@
 #include <QFile>
 #include <QDebug>
 #include <QDateTime>
+#include <QCoreApplication>
 #include <QLineSeries>
 #include <QDateTimeAxis>
 #include <QValueAxis>
@@ -22,6 +23,10 @@
 
 #include "MyToast.h"
 #include "model/Database/Database.h"
+#include "model/ActuatorTimeline.h"
+#include "model/SensorBus.h"
+#include "untils/Log.h"
+#include "untils/Metrics.h"
 
 QT_CHARTS_USE_NAMESPACE
 
@@ -47,6 +52,19 @@ protected:
         chart->zoom(factor);
         QChartView::wheelEvent(event);
     }
+
+    void paintEvent(QPaintEvent* event) override
+    {
+        QChartView::paintEvent(event);
+
+        // 记录最早一个未上屏采样从解码到本次绘制的延迟
+        const int64_t markNs = PipelineMetrics::sampleMark().take();
+        if (markNs != 0)
+        {
+            PipelineMetrics::sampleToPixelUs().record(
+                static_cast<uint64_t>((Metrics::nowNs() - markNs) / 1000));
+        }
+    }
 };
 
 // ========================================
@@ -66,8 +84,11 @@ RealTimeDate::RealTimeDate(QWidget* parent)
       , m_serialViewModel(nullptr)
       , m_sensorViewModel(nullptr)
       , m_controlViewModel(nullptr)
+      , m_analyticsViewModel(nullptr)
+      , m_autoControlViewModel(nullptr)
       , m_chartViewModel(nullptr)
       , m_settingViewModel(nullptr)
+      , m_linkSupervisor(nullptr)
       , m_serialPort(nullptr)
       , m_isCollecting(false)
       , m_isUpdatingSlider(false)
@@ -108,6 +129,11 @@ RealTimeDate::RealTimeDate(QWidget* parent)
 RealTimeDate::~RealTimeDate()
 {
     qDebug() << "🔚 RealTimeDate 析构";
+    // 尚未入库的样本已在 onAboutToQuit 中写出（此时数据库写线程已关闭）
+    SensorBus& bus = SensorBus::instance();
+    bus.unsubscribe(m_anomalyConsumer);
+    bus.unsubscribe(m_chartConsumer);
+    bus.unsubscribe(m_dbConsumer);
     delete ui;
 }
 
@@ -131,6 +157,23 @@ void RealTimeDate::setupViewModels()
     m_controlViewModel = new ControlViewModel(this);
     qDebug() << "  ControlViewModel 创建完成";
 
+    // 3.1 执行器统计 ViewModel（使用设置中的设备功率）
+    m_analyticsViewModel = new ActuatorAnalyticsViewModel(this);
+    auto applyDevicePower = [this]() {
+        m_analyticsViewModel->setDevicePower(m_settingViewModel->getFanPowerW(),
+                                             m_settingViewModel->getPumpPowerW(),
+                                             m_settingViewModel->getLampPowerW());
+    };
+    applyDevicePower();
+    connect(m_settingViewModel, &SettingViewModel::energySettingsChanged, this, applyDevicePower);
+    qDebug() << "  ActuatorAnalyticsViewModel 创建完成";
+
+    // 3.2 上位机自动控制 ViewModel（规则来自设置中的阈值）
+    m_autoControlViewModel = new AutoControlViewModel(this);
+    applyAutoControlRules();
+    m_autoControlViewModel->setEnabled(m_settingViewModel->getHostAutoControl());
+    qDebug() << "  AutoControlViewModel 创建完成";
+
     // 4. 图表 ViewModel（使用设置中的最大点数）
     m_chartViewModel = new ChartViewModel(this);
     m_chartViewModel->setMaxDataCount(m_settingViewModel->getChartMaxPoints());
@@ -145,6 +188,133 @@ void RealTimeDate::setupViewModels()
     // 6. WebSocket ViewModel
     m_webSocketViewModel = new WebSocketViewModel(this);
     qDebug() << "  WebSocketViewModel 创建完成";
+
+    // 7. 链路监测 ViewModel（依赖串口和 WebSocket ViewModel）
+    m_linkSupervisor = new LinkSupervisorViewModel(this);
+    setupLinkSupervisor();
+    qDebug() << "  LinkSupervisorViewModel 创建完成";
+
+    // 8. 传感器样本总线消费者
+    setupSensorBus();
+    qDebug() << "  传感器样本总线订阅完成";
+}
+
+// ========================================
+// 传感器样本总线：每个消费者独立游标，按自己的节奏读取
+// ========================================
+void RealTimeDate::setupSensorBus()
+{
+    SensorBus& bus = SensorBus::instance();
+    m_anomalyConsumer = bus.subscribe("anomaly", SensorBus::DropOldest);
+    m_chartConsumer = bus.subscribe("chart", SensorBus::DropOldest);
+    m_dbConsumer = bus.subscribe("db_writer", SensorBus::Backpressure);
+
+    // 数据库写入按批读取，写线程把同一批合并为一个事务
+    m_dbWriterTimer = new QTimer(this);
+    m_dbWriterTimer->setInterval(DB_WRITER_INTERVAL_MS);
+    connect(m_dbWriterTimer, &QTimer::timeout, this, &RealTimeDate::drainDatabaseWriter);
+    m_dbWriterTimer->start();
+
+    // 窗口在 ConnectionManager::shutdown() 之后才析构，析构时写入会被丢弃，退出事件循环时先写出
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &RealTimeDate::onAboutToQuit);
+}
+
+void RealTimeDate::onAboutToQuit()
+{
+    qDebug() << "🔚 退出前写出待入库的样本";
+    m_dbWriterTimer->stop();
+    drainDatabaseWriter();
+    // 结束进行中的执行器区间，否则 actuator_states 中留下未结束的区间
+    ActuatorTimeline::instance().close();
+}
+
+void RealTimeDate::drainDatabaseWriter()
+{
+    if (m_dbConsumer < 0) return;
+    const bool save = m_settingViewModel->getAutoSaveToDatabase();
+
+    // 样本装进池中的定长块，整块交给写线程，写入后归还；稳态下不分配内存
+    SensorBus::BatchPool& pool = SensorBus::batchPool();
+    SensorBus::Batch* batch = pool.acquire();
+    std::size_t queued = 0;
+    SensorBus::instance().drain(m_dbConsumer, [&](const SensorSample& sample)
+    {
+        if (!save || !(sample.flags & SAMPLE_VALID)) return;
+        batch->push(sample);
+        if (batch->isFull())
+        {
+            queued += batch->size;
+            Database::instance().insertBatch(batch);
+            batch = pool.acquire();
+        }
+    });
+    if (batch->size > 0)
+    {
+        queued += batch->size;
+        Database::instance().insertBatch(batch);
+    }
+    else
+    {
+        pool.release(batch);
+    }
+
+    if (queued > 0)
+    {
+        LOG_DEBUG("{} 条样本已提交到数据库", queued);
+    }
+    SensorBus::instance().reportMetrics();
+}
+
+// ========================================
+// 链路监测：提供两种连接方式的打开/关闭操作
+// ========================================
+void RealTimeDate::setupLinkSupervisor()
+{
+    LinkSupervisorViewModel::TransportHooks serial;
+    serial.isConnected = [this]() { return m_serialPort->isOpen(); };
+    serial.open = [this]() {
+        // 重连上次成功使用的串口（设备重新插拔后端口名通常不变）
+        const QString portName = m_settingViewModel->getLastSerialPort();
+        if (portName.isEmpty() || !openSerialPort(portName)) return false;
+        ui->pbtlink->setText("断开");
+        return true;
+    };
+    serial.close = [this]() {
+        if (!m_serialPort->isOpen()) return;
+        m_serialViewModel->stopListening();
+        m_serialPort->close();
+        ActuatorTimeline::instance().close();
+        ui->pbtlink->setText("连接");
+    };
+    serial.framesReceived = [this]() { return m_serialViewModel->framesReceived(); };
+    serial.takePending = [this]() { return m_serialViewModel->takePendingCommands(); };
+    serial.replay = [this](const LinkSupervisorViewModel::PendingCommands& commands) {
+        m_serialViewModel->replayCommands(commands);
+    };
+    m_linkSupervisor->setTransport(LinkSupervisorViewModel::Serial, serial);
+
+    LinkSupervisorViewModel::TransportHooks webSocket;
+    webSocket.isConnected = [this]() { return m_webSocketViewModel->isConnected(); };
+    webSocket.open = [this]() {
+        const QString wsUrl = m_settingViewModel->getWebSocketUrl();
+        if (wsUrl.isEmpty()) return false;
+        m_webSocketViewModel->connectToServer(wsUrl);  // 异步，收到第一帧才算恢复
+        return true;
+    };
+    webSocket.close = [this]() { m_webSocketViewModel->disconnectFromServer(); };
+    webSocket.framesReceived = [this]() { return m_webSocketViewModel->framesReceived(); };
+    webSocket.takePending = [this]() { return m_webSocketViewModel->takePendingCommands(); };
+    webSocket.replay = [this](const LinkSupervisorViewModel::PendingCommands& commands) {
+        m_webSocketViewModel->replayCommands(commands);
+    };
+    m_linkSupervisor->setTransport(LinkSupervisorViewModel::WebSocket, webSocket);
+
+    auto applyLinkSettings = [this]() {
+        m_linkSupervisor->setStallTimeoutMs(m_settingViewModel->getLinkStallTimeoutMs());
+        m_linkSupervisor->setAutoFailover(m_settingViewModel->getLinkAutoFailover());
+    };
+    applyLinkSettings();
+    connect(m_settingViewModel, &SettingViewModel::linkSettingsChanged, this, applyLinkSettings);
 }
 
 // ========================================
@@ -269,6 +439,10 @@ void RealTimeDate::connectViewModelSignals()
                 if (ui->btnWebsocketLink) {
                     ui->btnWebsocketLink->setText("断开WebSocket");
                 }
+                // 故障恢复中的重连由监测自己接管，这里只处理手动连接
+                if (m_linkSupervisor->state() == LinkSupervisorViewModel::Idle) {
+                    m_linkSupervisor->start(LinkSupervisorViewModel::WebSocket);
+                }
                 // WebSocket连接成功后，自动开始数据采集
                 if (!m_isCollecting) {
                     m_isCollecting = true;
@@ -279,6 +453,7 @@ void RealTimeDate::connectViewModelSignals()
     connect(m_webSocketViewModel, &WebSocketViewModel::disconnected,
             this, [this]() {
                 MyToast::info(this, "已断开", "WebSocket已断开连接");
+                ActuatorTimeline::instance().close();
                 if (ui->btnWebsocketLink) {
                     ui->btnWebsocketLink->setText("连接WebSocket");
                 }
@@ -291,8 +466,56 @@ void RealTimeDate::connectViewModelSignals()
             this, &RealTimeDate::onHeartBeatReceived);
     //connect(m_serialViewModel,&SerialViewModel::thresholdReceived,
     //        this,&RealTimeDate::onThresholdReceived);
+
+    // 重发次数用尽仍未收到下位机应答
+    auto onCommandFailed = [this](uint8_t cmd) {
+        MyToast::warning(this, "命令未应答",
+                         QString("下位机未确认命令 0x%1，请检查连接").arg(cmd, 2, 16, QChar('0')));
+    };
+    connect(m_serialViewModel, &SerialViewModel::commandFailed, this, onCommandFailed);
+    connect(m_webSocketViewModel, &WebSocketViewModel::commandFailed, this, onCommandFailed);
     qDebug() << "  ✅ SerialViewModel 信号连接完成";
 
+    // ===== SensorViewModel 信号 =====
+    // 异常已写入事件表，界面提示限流，避免持续异常时刷屏
+    connect(m_sensorViewModel, &SensorViewModel::abnormalDataDetected,
+            this, [this](const SensorSample&, const QString& reason)
+            {
+                const qint64 now = QDateTime::currentMSecsSinceEpoch();
+                if (now - m_lastAnomalyToastMs < ANOMALY_TOAST_INTERVAL_MS) return;
+                m_lastAnomalyToastMs = now;
+                MyToast::warning(this, "传感器异常", reason);
+            });
+
+    // ===== LinkSupervisorViewModel 信号 =====
+    connect(m_linkSupervisor, &LinkSupervisorViewModel::linkStalled,
+            this, [this](LinkSupervisorViewModel::Transport transport, qint64 silentMs)
+            {
+                // 中断期间不计入上一个状态：区间在最后一次收到状态帧的时间结束
+                ActuatorTimeline::instance().close();
+                MyToast::warning(this, "链路中断",
+                                 QString("%1 已 %2 秒未收到数据，正在自动恢复…")
+                                 .arg(transport == LinkSupervisorViewModel::Serial ? "串口" : "WebSocket")
+                                 .arg(silentMs / 1000));
+            });
+    connect(m_linkSupervisor, &LinkSupervisorViewModel::activeTransportChanged,
+            this, [this](LinkSupervisorViewModel::Transport transport)
+            {
+                switchConnectionMode(static_cast<ConnectionMode>(transport));
+                ui->btnModechange->setText(transport == LinkSupervisorViewModel::Serial
+                                           ? "切换到WebSocket模式" : "切换到串口模式");
+            });
+    connect(m_linkSupervisor, &LinkSupervisorViewModel::linkRecovered,
+            this, [this](LinkSupervisorViewModel::Transport transport, qint64 outageMs, int replayed)
+            {
+                MyToast::success(this, "链路已恢复",
+                                 QString("已通过%1恢复，中断 %2 秒，重发 %3 条命令")
+                                 .arg(transport == LinkSupervisorViewModel::Serial ? "串口" : "WebSocket")
+                                 .arg(outageMs / 1000.0, 0, 'f', 1)
+                                 .arg(replayed));
+            });
+    qDebug() << "  ✅ LinkSupervisorViewModel 信号连接完成";
+
     // ===== ControlViewModel 信号 =====
     connect(m_controlViewModel, &ControlViewModel::fanStateChanged,
             this, [this](bool isOn)
@@ -329,9 +552,9 @@ void RealTimeDate::connectViewModelSignals()
 
     // ===== ChartViewModel 信号 =====
     connect(m_chartViewModel, &ChartViewModel::dataAdded,
-            this, [this](const SensorRecord& data)
+            this, [this](const SensorSample&)
             {
-                qDebug() << "图表数据已添加，总数=" << m_chartViewModel->getDataCount();
+                LOG_DEBUG("图表数据已添加，总数={}", m_chartViewModel->getDataCount());
             });
 
     connect(m_chartViewModel, &ChartViewModel::dataCleared,
@@ -345,7 +568,23 @@ void RealTimeDate::connectViewModelSignals()
     // ===== SettingViewModel 信号 =====
     connect(m_settingViewModel, &SettingViewModel::thresholdChanged,
             this, &RealTimeDate::updateThresholdUI);
+    connect(m_settingViewModel, &SettingViewModel::thresholdChanged,
+            this, &RealTimeDate::applyAutoControlRules);
+    connect(m_settingViewModel, &SettingViewModel::controlSettingsChanged,
+            this, [this]()
+            {
+                m_autoControlViewModel->setEnabled(m_settingViewModel->getHostAutoControl());
+            });
     qDebug() << "  SettingViewModel 信号连接完成";
+
+    // ===== AutoControlViewModel 信号 =====
+    connect(m_autoControlViewModel, &AutoControlViewModel::motorCommandRequested,
+            this, [this](int zone, uint8_t fanStatus, uint8_t fanSpeed, uint8_t pumpStatus, uint8_t lampStatus)
+            {
+                // 当前只有一个下位机连接（区域 0）
+                if (zone != 0 || !isAnyConnectionActive()) return;
+                sendMotorControlCommand(fanStatus, fanSpeed, pumpStatus, lampStatus);
+            });
 }
 
 // ========================================
@@ -422,19 +661,11 @@ void RealTimeDate::on_pbtlink_clicked()
             return;
         }
 
-        // 配置串口
-        m_serialPort->setPortName(portName);
-        m_serialPort->setBaudRate(m_settingViewModel->getSerialBaudRate());
-        m_serialPort->setDataBits(QSerialPort::Data8);
-        m_serialPort->setParity(QSerialPort::NoParity);
-        m_serialPort->setStopBits(QSerialPort::OneStop);
-
-        if (m_serialPort->open(QIODevice::ReadWrite))
+        if (openSerialPort(portName))
         {
             // 连接成功
-            m_currentMode = MODE_SERIAL;
-            m_serialViewModel->startListening();
             ui->pbtlink->setText("断开");
+            m_linkSupervisor->start(LinkSupervisorViewModel::Serial);
 
             // 保存串口到设置
             m_settingViewModel->setLastSerialPort(portName);
@@ -463,8 +694,10 @@ void RealTimeDate::on_pbtlink_clicked()
 
         if (reply == QMessageBox::Yes)
         {
+            m_linkSupervisor->stop();
             m_serialViewModel->stopListening();
             m_serialPort->close();
+            ActuatorTimeline::instance().close();
             m_isCollecting = false;
             m_currentMode = MODE_SERIAL;  // 重置模式
             ui->pbtlink->setText("连接");
@@ -679,10 +912,8 @@ void RealTimeDate::on_Automatic_clicked()
 // ========================================
 // ViewModel 数据接收回调
 // ========================================
-void RealTimeDate::onSensorDataReceived(const SensorRecord& data)
+void RealTimeDate::onSensorDataReceived(const SensorSample& data)
 {
-    emit sensorDataReceived(data);
-    
     // 如果未开始采集，自动开始（适用于WebSocket模式）
     if (!m_isCollecting && isAnyConnectionActive())
     {
@@ -692,43 +923,71 @@ void RealTimeDate::onSensorDataReceived(const SensorRecord& data)
     
     if (!m_isCollecting)
     {
-        qDebug() << "⚠️ 数据采集未开始，忽略数据";
+        LOG_DEBUG("数据采集未开始，忽略数据");
+        PipelineMetrics::sampleMark().take();
         return;
     }
 
-    qDebug() << "📥 接收传感器数据";
+    LOG_DEBUG("接收传感器数据");
+
+    // 0. 校验一次，结果随样本发布给所有消费者
+    SensorSample sample = data;
+    const bool valid = SensorViewModel::validateSensorData(sample);
+    if (valid) sample.flags |= SAMPLE_VALID;
 
-    // 1. 使用 SensorViewModel 验证数据
-    if (!SensorViewModel::validateSensorData(data))
+    // 1. 发布到样本总线（首页、数据库写入、导出等各自读取）
+    SensorBus& bus = SensorBus::instance();
+    if (!bus.publish(sample))
     {
-        qWarning() << "⚠️ 数据验证失败";
-        return;
+        LOG_WARN("样本总线已满（数据库写入积压），丢弃样本");
     }
 
-    // 2. 更新 UI 标签（使用 SensorViewModel 的格式化函数）
-    updateSensorLabels(data);
+    // 2. 流式异常检测（超量程的样本也记录为异常事件）
+    bus.drain(m_anomalyConsumer, [this](const SensorSample& s)
+    {
+        m_sensorViewModel->detectAnomalies(s);
+    });
 
-    // 3. 使用 ChartViewModel 添加数据
-    m_chartViewModel->addData(data);
+    if (!valid)
+    {
+        LOG_WARN("数据验证失败");
+        PipelineMetrics::sampleMark().take();
+        return;
+    }
+
+    // 3. 上位机闭环控制（先于界面刷新执行，保证在本采样周期内响应）
+    m_autoControlViewModel->onSensorSample(sample);
 
-    // 4. 更新图表显示
-    updateChartDisplay(data);
+    // 4. 更新 UI 标签（使用 SensorViewModel 的格式化函数）
+    updateSensorLabels(sample);
 
-    // 5. 保存到数据库（如果启用）
-    if (m_settingViewModel->getAutoSaveToDatabase())
+    // 5. 图表：读取积压的样本，只重绘一次
+    bool added = false;
+    bus.drain(m_chartConsumer, [this, &added](const SensorSample& s)
     {
-        Database::instance().insert(data);
-        qDebug() << "  💾 数据已保存到数据库";
+        if (!(s.flags & SAMPLE_VALID)) return;
+        m_chartViewModel->addData(s);
+        added = true;
+    });
+    if (added)
+    {
+        updateChartDisplay();
     }
 }
 
 void RealTimeDate::onActuatorStateReceived(const ActuatorStateData& data)
 {
-    qDebug() << "📥 接收执行器状态";
+    LOG_DEBUG("接收执行器状态");
 
     // 使用 ControlViewModel 更新状态
     // ViewModel 会自动发出信号更新 UI
     m_controlViewModel->updateState(data);
+
+    // 记录执行器状态区间（状态不变时只推进结束时间），并累加当天的占空比/能耗统计
+    const qint64 nowSecs = QDateTime::currentSecsSinceEpoch();
+    ActuatorTimeline::instance().onState(data, nowSecs);
+    m_analyticsViewModel->onStateReceived(data, nowSecs);
+    m_autoControlViewModel->onActuatorState(data, nowSecs * 1000);
 }
 
 void RealTimeDate::onTimeWeatherReceived(const TimeWeatherData& data)
@@ -746,8 +1005,8 @@ void RealTimeDate::onTimeWeatherReceived(const TimeWeatherData& data)
 
 void RealTimeDate::onHeartBeatReceived()
 {
-    qDebug() << "💓 接收心跳包";
-    // 更新连接状态指示
+    LOG_DEBUG("接收心跳包");
+    m_linkSupervisor->onHeartBeat(static_cast<LinkSupervisorViewModel::Transport>(m_currentMode));
 }
 
 void RealTimeDate::onThresholdReceived(const Threshold& threshold)
@@ -764,13 +1023,13 @@ void RealTimeDate::onThresholdReceived(const Threshold& threshold)
 // ========================================
 // UI 更新辅助函数
 // ========================================
-void RealTimeDate::updateSensorLabels(const SensorRecord& data)
+void RealTimeDate::updateSensorLabels(const SensorSample& data)
 {
     // 使用 SensorViewModel 的格式化函数
-    QString tempStr = SensorViewModel::formatTemperature(data.air_temp);
-    QString airHumStr = SensorViewModel::formatHumidity(data.air_humid);
-    QString soilHumStr = SensorViewModel::formatHumidity(data.soil_humid);
-    QString lightStr = SensorViewModel::formatLightIntensity(data.light_intensity);
+    QString tempStr = SensorViewModel::formatTemperature(data.airTemp);
+    QString airHumStr = SensorViewModel::formatHumidity(data.airHumid);
+    QString soilHumStr = SensorViewModel::formatHumidity(data.soilHumid);
+    QString lightStr = SensorViewModel::formatLightIntensity(data.lightIntensity);
 
     // 更新UI标签（需要根据实际UI组件名称调整）
     // ui->lblTemperature->setText(tempStr);
@@ -779,17 +1038,25 @@ void RealTimeDate::updateSensorLabels(const SensorRecord& data)
     // ui->lblLightIntensity->setText(lightStr);
 
     // 显示数据等级
-    // ui->lblTempLevel->setText(SensorViewModel::getTemperatureLevel(data.air_temp));
+    // ui->lblTempLevel->setText(SensorViewModel::getTemperatureLevel(data.airTemp));
 }
 
-void RealTimeDate::updateChartDisplay(const SensorRecord& data)
+void RealTimeDate::updateChartDisplay()
 {
-    // 从 ChartViewModel 获取所有数据
-    auto allData = m_chartViewModel->getAllData();
+    ScopedTimer timer(PipelineMetrics::chartUpdateUs());
+
+    // 页面不可见时不会绘制，丢弃延迟标记，避免切回页面时记入过大的延迟
+    if (!m_chartView || !m_chartView->isVisible())
+    {
+        PipelineMetrics::sampleMark().take();
+    }
+
+    // 从 ChartViewModel 获取所有数据（引用，不复制）
+    const auto& allData = m_chartViewModel->getAllData();
 
     if (allData.isEmpty())
     {
-        qDebug() << "📊 图表数据为空，跳过更新";
+        LOG_DEBUG("图表数据为空，跳过更新");
         return;
     }
 
@@ -799,43 +1066,27 @@ void RealTimeDate::updateChartDisplay(const SensorRecord& data)
     m_soilHumiditySeries->clear();
     m_lightIntensitySeries->clear();
 
-    // 添加所有数据点
-    QDateTime minTime, maxTime;
+    // 添加所有数据点（样本按到达顺序存放，首尾即时间范围）
+    const QDateTime minTime = QDateTime::fromMSecsSinceEpoch(allData.first().tsMs);
+    const QDateTime maxTime = QDateTime::fromMSecsSinceEpoch(allData.last().tsMs);
     double maxValue = 0;
 
-    for (int i = 0; i < allData.size(); ++i)
+    for (const auto& sample : allData)
     {
-        const auto& record = allData[i];
-
-        // 解析时间
-        QDateTime dateTime = QDateTime::fromString(
-            QString::fromStdString(record.record_time),
-            "yyyy-MM-dd hh:mm:ss"
-        );
-
-        if (!dateTime.isValid())
-        {
-            dateTime = QDateTime::currentDateTime().addSecs(-allData.size() + i);
-        }
-
-        qint64 timestamp = dateTime.toMSecsSinceEpoch();
-
-        // 更新时间范围
-        if (i == 0 || dateTime < minTime) minTime = dateTime;
-        if (i == 0 || dateTime > maxTime) maxTime = dateTime;
+        const qint64 timestamp = sample.tsMs;
 
         // 添加数据点
-        m_temperatureSeries->append(timestamp, record.air_temp);
-        m_airHumiditySeries->append(timestamp, record.air_humid);
-        m_soilHumiditySeries->append(timestamp, record.soil_humid);
+        m_temperatureSeries->append(timestamp, sample.airTemp);
+        m_airHumiditySeries->append(timestamp, sample.airHumid);
+        m_soilHumiditySeries->append(timestamp, sample.soilHumid);
 
-        m_lightIntensitySeries->append(timestamp, record.light_intensity);
+        m_lightIntensitySeries->append(timestamp, sample.lightIntensity);
 
         // 更新最大值（用于Y轴范围）
-        maxValue = qMax(maxValue, (double)record.air_temp);
-        maxValue = qMax(maxValue, (double)record.air_humid);
-        maxValue = qMax(maxValue, (double)record.soil_humid);
-        maxValue = qMax(maxValue, (double)record.light_intensity);
+        maxValue = qMax(maxValue, (double)sample.airTemp);
+        maxValue = qMax(maxValue, (double)sample.airHumid);
+        maxValue = qMax(maxValue, (double)sample.soilHumid);
+        maxValue = qMax(maxValue, (double)sample.lightIntensity);
     }
 
     // 更新X轴范围（显示最近的数据）
@@ -850,10 +1101,8 @@ void RealTimeDate::updateChartDisplay(const SensorRecord& data)
         m_axisY->setRange(-20, qMax(100.0, maxValue * 1.2)); // 留20%余量
     }
 
-    qDebug() << "📊 图表已更新：" << allData.size() << "个数据点"
-        << "时间范围:" << minTime.toString("hh:mm:ss")
-        << "-" << maxTime.toString("hh:mm:ss")
-        << "Y轴范围:" << 0 << "-" << maxValue * 1.2;
+    LOG_DEBUG("图表已更新：{} 个数据点 时间范围: {} - {} Y轴范围: 0 - {}",
+              allData.size(), minTime.toMSecsSinceEpoch(), maxTime.toMSecsSinceEpoch(), maxValue * 1.2);
 }
 
 void RealTimeDate::updateDeviceButtonsUI()
@@ -866,6 +1115,18 @@ void RealTimeDate::updateDeviceButtonsUI()
     ui->pbtWater->setEnabled(isManual);
 }
 
+void RealTimeDate::applyAutoControlRules()
+{
+    ZoneRules rules;
+    rules.fan = {m_settingViewModel->getFanOnThreshold(), m_settingViewModel->getFanOffThreshold(),
+                 HysteresisRule::ActivateAbove};
+    rules.pump = {m_settingViewModel->getPumpOnThreshold(), m_settingViewModel->getPumpOffThreshold(),
+                  HysteresisRule::ActivateBelow};
+    rules.lamp = {m_settingViewModel->getLampOnThreshold(), m_settingViewModel->getLampOffThreshold(),
+                  HysteresisRule::ActivateBelow};
+    m_autoControlViewModel->setDefaultRules(rules);
+}
+
 void RealTimeDate::updateThresholdUI()
 {
     // 从 SettingViewModel 读取阈值并更新UI
@@ -1258,8 +1519,10 @@ void RealTimeDate::on_btnModechange_clicked()
             }
             
             // 断开串口
+            m_linkSupervisor->stop();
             m_serialViewModel->stopListening();
             m_serialPort->close();
+            ActuatorTimeline::instance().close();
             ui->pbtlink->setText("连接");
             m_isCollecting = false;
         }
@@ -1285,6 +1548,7 @@ void RealTimeDate::on_btnModechange_clicked()
             }
             
             // 断开WebSocket
+            m_linkSupervisor->stop();
             m_webSocketViewModel->disconnectFromServer();
             m_isCollecting = false;
         }
@@ -1312,7 +1576,7 @@ void RealTimeDate::on_btnWebsocketLink_clicked()
     
     if (!m_webSocketViewModel->isConnected())
     {
-        QString wsUrl = "ws://123.249.39.224:8080/";  // 默认地址
+        QString wsUrl = m_settingViewModel->getWebSocketUrl();  // 默认为云端服务器地址
         m_webSocketViewModel->connectToServer(wsUrl);
         m_currentMode = MODE_WEBSOCKET;
         
@@ -1331,6 +1595,7 @@ void RealTimeDate::on_btnWebsocketLink_clicked()
         
         if (reply == QMessageBox::Yes)
         {
+            m_linkSupervisor->stop();
             m_webSocketViewModel->disconnectFromServer();
             m_isCollecting = false;
             ui->btnWebsocketLink->setText("连接WebSocket");
@@ -1356,15 +1621,38 @@ bool RealTimeDate::isAnyConnectionActive() const
     return m_serialPort->isOpen() || m_webSocketViewModel->isConnected();
 }
 
+// ========================================
+// 按设置配置并打开串口（手动连接和自动重连共用）
+// ========================================
+bool RealTimeDate::openSerialPort(const QString& portName)
+{
+    m_serialPort->setPortName(portName);
+    m_serialPort->setBaudRate(m_settingViewModel->getSerialBaudRate());
+    m_serialPort->setDataBits(QSerialPort::Data8);
+    m_serialPort->setParity(QSerialPort::NoParity);
+    m_serialPort->setStopBits(QSerialPort::OneStop);
+
+    if (!m_serialPort->open(QIODevice::ReadWrite))
+    {
+        return false;
+    }
+    m_currentMode = MODE_SERIAL;
+    m_serialViewModel->startListening();
+    return true;
+}
+
 // ========================================
 // 断开所有连接
 // ========================================
 void RealTimeDate::disconnectAll()
 {
+    m_linkSupervisor->stop();
+
     if (m_serialPort->isOpen())
     {
         m_serialViewModel->stopListening();
         m_serialPort->close();
+        ActuatorTimeline::instance().close();
         ui->pbtlink->setText("连接");
     }
     
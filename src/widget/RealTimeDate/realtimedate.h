@@ -14,6 +14,7 @@
 #include <QDateTimeAxis>
 #include <QLineSeries>
 #include <QValueAxis>
+#include <QTimer>
 
 #include "../../model/SensorData.h"
 #include "../../model/ActuatorStateData.h"
@@ -21,6 +22,9 @@
 #include "../../viewmodel/WebSocketViewModel.h"
 #include "../../viewmodel/SensorViewModel.h"
 #include "../../viewmodel/ControlViewModel.h"
+#include "../../viewmodel/ActuatorAnalyticsViewModel.h"
+#include "../../viewmodel/AutoControlViewModel.h"
+#include "../../viewmodel/LinkSupervisorViewModel.h"
 #include "../../viewmodel/ChartViewModel.h"
 #include "../../viewmodel/SettingViewModel.h"
 
@@ -41,7 +45,7 @@ QT_END_NAMESPACE
  * 架构说明：
  * - View 层：只负责界面显示和用户交互
  * - ViewModel 层：SerialViewModel, SensorViewModel, ControlViewModel, ChartViewModel, SettingViewModel
- * - Model 层：SensorRecord, ActuatorStateData, TimeWeatherData
+ * - Model 层：SensorSample, ActuatorStateData, TimeWeatherData
  *
  * 数据流：
  * - 接收数据：Model → ViewModel → View
@@ -58,9 +62,6 @@ public:
 public slots:
     void on_RefreshClicked();
 
-signals:
-    void sensorDataReceived(const SensorRecord& data);
-
 private slots:
     // ========== 连接管理 ==========
     void on_pbtlink_clicked();
@@ -102,7 +103,7 @@ private slots:
 
 private:
     // ========== ViewModel 数据接收回调 ==========
-    void onSensorDataReceived(const SensorRecord& data);
+    void onSensorDataReceived(const SensorSample& data);
     void onActuatorStateReceived(const ActuatorStateData& data);
     void onTimeWeatherReceived(const TimeWeatherData& data);
     void onHeartBeatReceived();
@@ -115,10 +116,11 @@ private:
     void initializeChart(); // 初始化图表
 
     // ========== UI 更新辅助函数 ==========
-    void updateChartDisplay(const SensorRecord& data);
-    void updateSensorLabels(const SensorRecord& data);
+    void updateChartDisplay();
+    void updateSensorLabels(const SensorSample& data);
     void updateDeviceButtonsUI();
     void updateThresholdUI();
+    void applyAutoControlRules(); // 把设置中的阈值同步为自动控制规则
     void loadStyleSheet();
     void sendAllThresholdsToDevice(); // 发送所有阈值到下位机
     void removeSizeConstraints(); // 移除所有子组件的尺寸限制
@@ -142,8 +144,11 @@ private:
     WebSocketViewModel* m_webSocketViewModel; // WebSocket通信 ViewModel
     SensorViewModel* m_sensorViewModel; // 传感器数据 ViewModel
     ControlViewModel* m_controlViewModel; // 设备控制 ViewModel
+    ActuatorAnalyticsViewModel* m_analyticsViewModel; // 执行器统计 ViewModel
+    AutoControlViewModel* m_autoControlViewModel; // 上位机自动控制 ViewModel
     ChartViewModel* m_chartViewModel; // 图表数据 ViewModel
     SettingViewModel* m_settingViewModel; // 设置管理 ViewModel
+    LinkSupervisorViewModel* m_linkSupervisor; // 链路监测与故障恢复 ViewModel
 
     // ========== 底层依赖 ==========
     QSerialPort* m_serialPort;
@@ -157,10 +162,24 @@ private:
         MODE_WEBSOCKET = 1
     };
     ConnectionMode m_currentMode = MODE_SERIAL;  // 当前连接模式
+    qint64 m_lastAnomalyToastMs = 0;  // 上次异常提示时间
+    static constexpr qint64 ANOMALY_TOAST_INTERVAL_MS = 30000;
+
+    // ========== 样本总线消费者 ==========
+    int m_anomalyConsumer = -1;  // 异常检测（每个样本发布后立即读取）
+    int m_chartConsumer = -1;    // 图表（只保留最新数据，可丢弃）
+    int m_dbConsumer = -1;       // 数据库写入（背压，不丢数据）
+    QTimer* m_dbWriterTimer = nullptr;
+    static constexpr int DB_WRITER_INTERVAL_MS = 200;
     
     // ========== 辅助函数 ==========
     void switchConnectionMode(ConnectionMode mode);  // 切换连接模式
     bool isAnyConnectionActive() const;  // 检查是否有任何连接处于活动状态
+    bool openSerialPort(const QString& portName);  // 按设置配置并打开串口
+    void setupLinkSupervisor();  // 为链路监测提供串口/WebSocket 的打开关闭操作
+    void setupSensorBus();  // 订阅传感器样本总线（异常检测 / 图表 / 数据库写入）
+    void drainDatabaseWriter();  // 把总线上积压的样本批量交给数据库写线程
+    void onAboutToQuit();  // 退出事件循环时（数据库关闭之前）写出尚未入库的数据
     void disconnectAll();  // 断开所有连接
     void sendMotorControlCommand(uint8_t fanStatus, uint8_t fanSpeed, 
                                 uint8_t pumpStatus, uint8_t lampStatus);
@@ -0,0 +1,121 @@
+//
+// greenhouse_tests —— 上位机自动控制规则的单元测试
+//
+// 不依赖事件循环：motorCommandRequested 以直连方式同步接收。
+// 任一检查失败时返回非零，由 ctest 报告。
+//
+
+#include <QCoreApplication>
+#include <cstdio>
+#include <vector>
+
+#include "viewmodel/AutoControlViewModel.h"
+#include "viewmodel/SensorViewModel.h"
+
+namespace {
+
+int g_failures = 0;
+
+#define CHECK(cond)                                                              \
+    do {                                                                         \
+        if (!(cond)) {                                                           \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) 失败\n", __FILE__, __LINE__, #cond); \
+            ++g_failures;                                                        \
+        }                                                                        \
+    } while (0)
+
+struct Command {
+    int zone;
+    uint8_t fan;
+    uint8_t pump;
+    uint8_t lamp;
+};
+
+// 去抖、最短间隔、命令间隔都关闭：每个样本的期望状态立即下发
+struct Fixture {
+    AutoControlViewModel control;
+    std::vector<Command> commands;
+    int64_t nowMs = 0;
+
+    Fixture() {
+        control.setDebounceSamples(1);
+        control.setMinDwellMs(0);
+        control.setMinCommandIntervalMs(0);
+        QObject::connect(&control, &AutoControlViewModel::motorCommandRequested,
+                         [this](int zone, uint8_t fan, uint8_t, uint8_t pump, uint8_t lamp) {
+                             commands.push_back({zone, fan, pump, lamp});
+                         });
+        control.setEnabled(true);
+    }
+
+    // 温度、土壤湿度落在风扇、水泵的关闭区间内，只有灯光会动作
+    void feedLight(int light) {
+        SensorSample sample;
+        nowMs += 1000;
+        sample.tsMs = nowMs;
+        sample.airTemp = 20;
+        sample.airHumid = 50;
+        sample.soilHumid = 60;
+        sample.lightIntensity = light;
+        control.onSensorSample(sample);
+    }
+};
+
+void testLampTurnsOffAboveOffThreshold() {
+    Fixture f;
+    const HysteresisRule& lamp = f.control.defaultRules().lamp;
+    CHECK(lamp.isValid());
+    CHECK(lamp.offThreshold <= SensorViewModel::MAX_LIGHT);
+
+    f.feedLight(lamp.onThreshold - 1);
+    CHECK(f.commands.size() == 1);
+    CHECK(!f.commands.empty() && f.commands.back().lamp == 1);
+
+    // 阈值之间保持开启
+    f.feedLight((lamp.onThreshold + lamp.offThreshold) / 2);
+    CHECK(f.commands.size() == 1);
+
+    f.feedLight(lamp.offThreshold + 1);
+    CHECK(f.commands.size() == 2);
+    CHECK(f.commands.size() == 2 && f.commands.back().lamp == 0);
+}
+
+void testOutOfRangeRulesAreClamped() {
+    Fixture f;
+    ZoneRules rules;
+    rules.lamp = {200, 500, HysteresisRule::ActivateBelow};   // 旧版本以 lux 保存的阈值
+    f.control.setDefaultRules(rules);
+
+    const HysteresisRule& lamp = f.control.defaultRules().lamp;
+    CHECK(lamp.onThreshold == SensorViewModel::MAX_LIGHT);
+    CHECK(lamp.offThreshold == SensorViewModel::MAX_LIGHT);
+    // 限制后开启/关闭阈值重合，规则无效：灯保持当前状态，不会常亮
+    CHECK(!lamp.isValid());
+    f.feedLight(SensorViewModel::MAX_LIGHT);
+    f.feedLight(SensorViewModel::MIN_LIGHT);
+    CHECK(f.commands.empty());
+
+    // 区域规则同样限制；有效部分不受影响
+    rules.lamp = {-10, 80, HysteresisRule::ActivateBelow};
+    f.control.setZoneRules(0, rules);
+    f.feedLight(SensorViewModel::MIN_LIGHT);
+    CHECK(f.commands.size() == 1 && f.commands.back().lamp == 1);
+    f.feedLight(81);
+    CHECK(f.commands.size() == 2 && f.commands.back().lamp == 0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    testLampTurnsOffAboveOffThreshold();
+    testOutOfRangeRulesAreClamped();
+
+    if (g_failures > 0) {
+        std::fprintf(stderr, "%d 项检查失败\n", g_failures);
+        return 1;
+    }
+    std::printf("全部通过\n");
+    return 0;
+}
@@ -0,0 +1,304 @@
+#include "DeviceSimulator.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QHostAddress>
+#include <QWebSocket>
+#include <QWebSocketServer>
+#include <algorithm>
+
+DeviceSimulator::DeviceSimulator(const SimulatorConfig& config, QObject* parent)
+    : QObject(parent)
+    , m_config(config)
+    , m_server(new QWebSocketServer(QStringLiteral("GreenHouseSimulator"),
+                                    QWebSocketServer::NonSecureMode, this))
+    , m_rng(config.seed)
+{
+    m_nodes.resize(std::max(1, m_config.nodes));
+
+    // 各节点初始值与发送相位错开，避免所有节点在同一时刻集中发帧
+    for (int i = 0; i < m_nodes.size(); ++i) {
+        VirtualNode& node = m_nodes[i];
+        node.airTemp = 20.0 + 10.0 * m_uniform(m_rng);
+        node.airHumid = 40.0 + 40.0 * m_uniform(m_rng);
+        node.soilHumid = 30.0 + 40.0 * m_uniform(m_rng);
+        node.light = 100.0 * m_uniform(m_rng);
+        node.nextSensor = static_cast<qint64>(periodMs(m_config.sensorHz) * m_uniform(m_rng));
+        node.nextMotor = static_cast<qint64>(periodMs(m_config.motorHz) * m_uniform(m_rng));
+        node.nextHeartBeat = static_cast<qint64>(periodMs(m_config.heartBeatHz) * m_uniform(m_rng));
+        node.nextWeather = static_cast<qint64>(periodMs(m_config.weatherHz) * m_uniform(m_rng));
+    }
+
+    m_parser.setFrameHandler([this](uint8_t cmd, const uint8_t* payload, uint8_t len) {
+        handleCommand(cmd, payload, len);
+    });
+    m_parser.setCrcErrorHandler([](uint8_t cmd, uint8_t, uint8_t) {
+        qWarning() << "❌ 上位机命令 CRC 校验失败 CMD:" << QString::number(cmd, 16);
+    });
+
+    connect(m_server, &QWebSocketServer::newConnection, this, &DeviceSimulator::onNewConnection);
+    connect(&m_tickTimer, &QTimer::timeout, this, &DeviceSimulator::onTick);
+    connect(&m_statsTimer, &QTimer::timeout, this, &DeviceSimulator::printStats);
+}
+
+DeviceSimulator::~DeviceSimulator() {
+    m_server->close();
+    qDeleteAll(m_clients);
+}
+
+bool DeviceSimulator::start() {
+    if (!m_server->listen(QHostAddress::LocalHost, m_config.port)) {
+        qCritical() << "❌ 模拟器监听失败:" << m_server->errorString();
+        return false;
+    }
+
+    m_clock.start();
+    m_tickTimer.setTimerType(Qt::PreciseTimer);
+    m_tickTimer.start(std::max(1, m_config.tickMs));
+    if (m_config.statsIntervalSec > 0) {
+        m_statsTimer.start(m_config.statsIntervalSec * 1000);
+    }
+
+    qDebug() << "✅ 模拟器已启动: ws://127.0.0.1:" + QString::number(m_config.port) + "/"
+             << "节点数=" << m_nodes.size()
+             << "传感器频率=" << m_config.sensorHz << "Hz/节点";
+    return true;
+}
+
+// ========================================
+// 连接管理
+// ========================================
+
+void DeviceSimulator::onNewConnection() {
+    while (QWebSocket* client = m_server->nextPendingConnection()) {
+        connect(client, &QWebSocket::binaryMessageReceived,
+                this, &DeviceSimulator::onBinaryMessageReceived);
+        connect(client, &QWebSocket::disconnected,
+                this, &DeviceSimulator::onClientDisconnected);
+        m_clients.append(client);
+        m_parser.reset();
+        qDebug() << "🔗 上位机已连接:" << client->peerAddress().toString();
+    }
+}
+
+void DeviceSimulator::onClientDisconnected() {
+    QWebSocket* client = qobject_cast<QWebSocket*>(sender());
+    if (!client) return;
+    m_clients.removeAll(client);
+    client->deleteLater();
+    qDebug() << "🔌 上位机已断开";
+}
+
+void DeviceSimulator::onBinaryMessageReceived(const QByteArray& message) {
+    m_parser.feed(reinterpret_cast<const uint8_t*>(message.constData()),
+                  static_cast<std::size_t>(message.size()));
+}
+
+// ========================================
+// 控制命令应答
+// ========================================
+
+void DeviceSimulator::handleCommand(uint8_t cmd, const uint8_t* payload, uint8_t len) {
+    ++m_stats.commandsReceived;
+
+    bool ok = true;
+    ActuatorStateData control;
+    switch (cmd) {
+    case CMD_MOTOR_CRTL:
+        // 协议没有节点地址，控制命令作用于所有节点
+        if (Protocol::MotorControlMessage::decode(payload, len, control)) {
+            for (VirtualNode& node : m_nodes) {
+                node.fanStatus = control.fanStatus;
+                node.fanSpeed = control.fanSpeed;
+                node.pumpStatus = control.pumpStatus;
+                node.lampStatus = control.lampStatus;
+                node.nextMotor = 0;  // 尽快回报新的电机状态
+            }
+        } else {
+            ok = false;
+        }
+        break;
+    case CMD_THRESHOLD:
+        ok = (len == 6);
+        break;
+    case CMD_DATA_CRTL:
+        ok = (len == 1);
+        if (ok) m_collecting = payload[0] != 0;
+        break;
+    case CMD_AUTO_MODE:
+        ok = (len == 1);
+        if (ok) {
+            for (VirtualNode& node : m_nodes) {
+                node.autoMode = payload[0] ? 1 : 0;
+            }
+        }
+        break;
+    default:
+        // CMD_Get_Date 等命令没有应答
+        return;
+    }
+
+    Protocol::CtrlAckData ack;
+    ack.originalCmd = cmd;
+    ack.result = ok ? 0x01 : 0x00;
+    appendMessage<Protocol::CtrlAckMessage>(ack, false);
+    ++m_stats.acksSent;
+    flush();
+}
+
+// ========================================
+// 帧生成
+// ========================================
+
+void DeviceSimulator::onTick() {
+    const qint64 now = m_clock.elapsed();
+
+    for (VirtualNode& node : m_nodes) {
+        if (m_collecting && m_config.sensorHz > 0 && now >= node.nextSensor) {
+            emitSensor(node);
+            node.nextSensor += periodMs(m_config.sensorHz);
+        }
+        if (m_config.motorHz > 0 && now >= node.nextMotor) {
+            emitMotorState(node);
+            node.nextMotor = std::max(node.nextMotor, now - periodMs(m_config.motorHz))
+                             + periodMs(m_config.motorHz);
+        }
+        if (m_config.heartBeatHz > 0 && now >= node.nextHeartBeat) {
+            emitHeartBeat();
+            node.nextHeartBeat += periodMs(m_config.heartBeatHz);
+        }
+        if (m_config.weatherHz > 0 && now >= node.nextWeather) {
+            emitTimeWeather(node);
+            node.nextWeather += periodMs(m_config.weatherHz);
+        }
+    }
+
+    flush();
+}
+
+void DeviceSimulator::emitSensor(VirtualNode& node) {
+    // 随机游走并限制在传感器合理范围内
+    node.airTemp = qBound(-10.0, node.airTemp + m_noise(m_rng), 50.0);
+    node.airHumid = qBound(0.0, node.airHumid + m_noise(m_rng), 100.0);
+    node.soilHumid = qBound(0.0, node.soilHumid + m_noise(m_rng), 100.0);
+    node.light = qBound(0.0, node.light + m_noise(m_rng), 100.0);
+
+    SensorSample sample;
+    sample.airTemp = static_cast<int16_t>(node.airTemp);
+    sample.airHumid = static_cast<uint8_t>(node.airHumid);
+    sample.soilHumid = static_cast<uint8_t>(node.soilHumid);
+    sample.lightIntensity = static_cast<int16_t>(node.light);
+    appendMessage<Protocol::SensorMessage>(sample);
+}
+
+void DeviceSimulator::emitMotorState(const VirtualNode& node) {
+    ActuatorStateData state;
+    state.fanStatus = node.fanStatus;
+    state.fanSpeed = node.fanSpeed;
+    state.pumpStatus = node.pumpStatus;
+    state.lampStatus = node.lampStatus;
+    state.autoMode = node.autoMode;
+    appendMessage<Protocol::MotorStateMessage>(state);
+}
+
+void DeviceSimulator::emitHeartBeat() {
+    Protocol::HeartBeatData heartBeat;
+    heartBeat.status = 0x01;
+    appendMessage<Protocol::HeartBeatMessage>(heartBeat);
+}
+
+void DeviceSimulator::emitTimeWeather(const VirtualNode& node) {
+    const QTime now = QTime::currentTime();
+    const int16_t tempNow = static_cast<int16_t>(node.airTemp);
+
+    TimeWeatherData weather;
+    weather.hour = static_cast<uint8_t>(now.hour());
+    weather.minute = static_cast<uint8_t>(now.minute());
+    weather.tempNow = tempNow;
+    weather.tempLow = static_cast<uint8_t>(qMax(0, tempNow - 5));
+    weather.tempHigh = static_cast<uint8_t>(tempNow + 5);
+    appendMessage<Protocol::TimeWeatherMessage>(weather);
+}
+
+void DeviceSimulator::appendFrame(uint8_t cmd, const uint8_t* payload, uint8_t len, bool allowFaults) {
+    uint8_t frame[ProtocolParser::MAX_FRAME_SIZE];
+    std::size_t size = ProtocolParser::encodeFrame(cmd, payload, len, frame);
+
+    ++m_stats.frames[cmd & 0x1F];
+
+    if (allowFaults) {
+        if (chance(m_config.crcErrorRate)) {
+            frame[size - 1] ^= 0x5A;
+            ++m_stats.crcErrors;
+        }
+        if (chance(m_config.truncateRate)) {
+            // 残缺帧：丢掉尾部若干字节，上位机需要依靠下一个 SOF 重新同步
+            size = 1 + static_cast<std::size_t>(m_uniform(m_rng) * (size - 1));
+            ++m_stats.truncatedFrames;
+        } else if (chance(m_config.splitRate) && size > 1) {
+            // 跨消息拆分：前半部分作为当前消息的结尾立即发送，后半部分作为下一条消息的开头，
+            // 之后生成的帧都排在尾部之后，两半之间不会插入其他帧
+            std::size_t head = 1 + static_cast<std::size_t>(m_uniform(m_rng) * (size - 1));
+            m_outgoing.append(reinterpret_cast<const char*>(frame), static_cast<int>(head));
+            flush();
+            m_outgoing.append(reinterpret_cast<const char*>(frame + head), static_cast<int>(size - head));
+            ++m_stats.splitFrames;
+            return;
+        }
+    }
+
+    m_outgoing.append(reinterpret_cast<const char*>(frame), static_cast<int>(size));
+}
+
+void DeviceSimulator::flush() {
+    if (m_outgoing.isEmpty()) return;
+
+    if (!m_clients.isEmpty()) {
+        for (QWebSocket* client : m_clients) {
+            client->sendBinaryMessage(m_outgoing);
+        }
+        m_stats.bytes += static_cast<quint64>(m_outgoing.size());
+        ++m_stats.messages;
+    }
+    m_outgoing.clear();
+}
+
+// ========================================
+// 统计输出
+// ========================================
+
+void DeviceSimulator::printStats() {
+    const double secs = m_config.statsIntervalSec;
+    auto rate = [&](quint64 now, quint64 last) { return (now - last) / secs; };
+
+    qDebug().noquote()
+        << QString("📈 [%1] clients=%2 sensor=%3/s motor=%4/s hb=%5/s weather=%6/s "
+                   "msgs=%7/s bytes=%8/s crcErr=%9 split=%10 trunc=%11 cmds=%12 acks=%13")
+               .arg(QDateTime::currentDateTime().toString("hh:mm:ss"))
+               .arg(m_clients.size())
+               .arg(rate(m_stats.frames[CMD_SENSOR], m_lastStats.frames[CMD_SENSOR]), 0, 'f', 1)
+               .arg(rate(m_stats.frames[CMD_MOTOR_STATE], m_lastStats.frames[CMD_MOTOR_STATE]), 0, 'f', 1)
+               .arg(rate(m_stats.frames[CMD_HEART_BEAT], m_lastStats.frames[CMD_HEART_BEAT]), 0, 'f', 1)
+               .arg(rate(m_stats.frames[CMD_TIME_WEATHER], m_lastStats.frames[CMD_TIME_WEATHER]), 0, 'f', 1)
+               .arg(rate(m_stats.messages, m_lastStats.messages), 0, 'f', 1)
+               .arg(rate(m_stats.bytes, m_lastStats.bytes), 0, 'f', 0)
+               .arg(m_stats.crcErrors)
+               .arg(m_stats.splitFrames)
+               .arg(m_stats.truncatedFrames)
+               .arg(m_stats.commandsReceived)
+               .arg(m_stats.acksSent);
+
+    m_lastStats = m_stats;
+}
+
+// ========================================
+// 辅助函数
+// ========================================
+
+bool DeviceSimulator::chance(double probability) {
+    return probability > 0.0 && m_uniform(m_rng) < probability;
+}
+
+qint64 DeviceSimulator::periodMs(double hz) {
+    return hz > 0.0 ? std::max<qint64>(1, static_cast<qint64>(1000.0 / hz)) : 0;
+}
@@ -0,0 +1,137 @@
+//
+// 多节点下位机模拟器 —— 通过本地 WebSocket 服务端按 Protocol.h 帧格式收发数据
+//
+
+#ifndef GREENHOUSE_DEVICESIMULATOR_H
+#define GREENHOUSE_DEVICESIMULATOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QTimer>
+#include <QVector>
+#include <random>
+
+#include "common/ProtocolParser.h"
+#include "common/ProtocolMessages.h"
+
+class QWebSocket;
+class QWebSocketServer;
+
+/**
+ * @brief 模拟器配置（全部可由命令行覆盖）
+ */
+struct SimulatorConfig {
+    quint16 port = 9000;            // WebSocket 监听端口
+    int nodes = 1;                  // 虚拟节点数量
+    double sensorHz = 1.0;          // 每个节点 CMD_SENSOR 频率
+    double motorHz = 0.2;           // 每个节点 CMD_MOTOR_STATE 频率
+    double heartBeatHz = 0.5;       // 每个节点 CMD_HEART_BEAT 频率
+    double weatherHz = 0.05;        // 每个节点 CMD_TIME_WEATHER 频率
+    double crcErrorRate = 0.0;      // 注入 CRC 错误的概率 [0,1]
+    double splitRate = 0.0;         // 将一帧拆到两条消息中发送的概率
+    double truncateRate = 0.0;      // 发送残缺帧（截断尾部）的概率
+    int tickMs = 5;                 // 调度周期，同一周期内的帧合并成一条消息
+    int statsIntervalSec = 5;       // 统计输出间隔
+    quint32 seed = 12345;           // 随机种子，便于复现
+};
+
+/**
+ * @brief 多节点设备模拟器
+ *
+ * - 按配置频率为每个虚拟节点生成 CMD_SENSOR / CMD_MOTOR_STATE /
+ *   CMD_HEART_BEAT / CMD_TIME_WEATHER 帧
+ * - 可按概率注入 CRC 错误、跨消息拆分帧和残缺帧
+ * - 收到 CMD_MOTOR_CRTL / CMD_THRESHOLD 等控制命令时回复 CMD_CRTL_ACK
+ *
+ * 协议本身没有节点地址字段，所有节点的帧在同一连接上交错发送；
+ * 通过对比模拟器的发送计数与上位机的接收计数即可得到丢帧率。
+ */
+class DeviceSimulator : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DeviceSimulator(const SimulatorConfig& config, QObject* parent = nullptr);
+    ~DeviceSimulator() override;
+
+    bool start();
+
+private slots:
+    void onNewConnection();
+    void onClientDisconnected();
+    void onBinaryMessageReceived(const QByteArray& message);
+    void onTick();
+    void printStats();
+
+private:
+    struct VirtualNode {
+        // 传感器随机游走状态
+        double airTemp = 25.0;
+        double airHumid = 60.0;
+        double soilHumid = 45.0;
+        double light = 50.0;
+        // 执行器状态
+        uint8_t fanStatus = 0;
+        uint8_t fanSpeed = 0;
+        uint8_t pumpStatus = 0;
+        uint8_t lampStatus = 0;
+        uint8_t autoMode = 0;
+        // 下一次发送时间（ms，相对启动时刻）
+        qint64 nextSensor = 0;
+        qint64 nextMotor = 0;
+        qint64 nextHeartBeat = 0;
+        qint64 nextWeather = 0;
+    };
+
+    struct Stats {
+        quint64 frames[32] = {};    // 按 CMD 统计已发送帧数
+        quint64 bytes = 0;
+        quint64 messages = 0;
+        quint64 crcErrors = 0;
+        quint64 splitFrames = 0;
+        quint64 truncatedFrames = 0;
+        quint64 commandsReceived = 0;
+        quint64 acksSent = 0;
+    };
+
+    void emitSensor(VirtualNode& node);
+    void emitMotorState(const VirtualNode& node);
+    void emitHeartBeat();
+    void emitTimeWeather(const VirtualNode& node);
+    void appendFrame(uint8_t cmd, const uint8_t* payload, uint8_t len, bool allowFaults);
+
+    template <typename Msg>
+    void appendMessage(const typename Msg::Type& value, bool allowFaults = true) {
+        uint8_t payload[Msg::SIZE];
+        appendFrame(Msg::CMD, payload, Msg::encode(value, payload), allowFaults);
+    }
+
+    void flush();
+    void handleCommand(uint8_t cmd, const uint8_t* payload, uint8_t len);
+
+    bool chance(double probability);
+    static qint64 periodMs(double hz);
+
+    SimulatorConfig m_config;
+    QWebSocketServer* m_server;
+    QList<QWebSocket*> m_clients;
+    QVector<VirtualNode> m_nodes;
+    ProtocolParser m_parser;
+
+    QTimer m_tickTimer;
+    QTimer m_statsTimer;
+    QElapsedTimer m_clock;
+
+    QByteArray m_outgoing;          // 待发送的数据（可能以上一条消息中拆分帧的尾部开头）
+    bool m_collecting = true;       // CMD_DATA_CRTL 控制的采集开关
+
+    std::mt19937 m_rng;
+    std::uniform_real_distribution<double> m_uniform{0.0, 1.0};
+    std::normal_distribution<double> m_noise{0.0, 0.3};
+
+    Stats m_stats;
+    Stats m_lastStats;
+};
+
+#endif // GREENHOUSE_DEVICESIMULATOR_H
@@ -0,0 +1,62 @@
+//
+// greenhouse_sim —— 多节点下位机模拟器
+//
+// 用法示例：
+//   greenhouse_sim --port 9000 --nodes 200 --sensor-hz 1 --crc-error-rate 0.01
+// 然后在 greenhouse_settings.ini 中设置 websocket/url=ws://127.0.0.1:9000/
+// 并在实时数据页面连接 WebSocket。
+//
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include "DeviceSimulator.h"
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("greenhouse_sim");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("GreenHouse 多节点设备模拟器（WebSocket）");
+    parser.addHelpOption();
+
+    SimulatorConfig config;
+
+    QCommandLineOption portOpt("port", "监听端口", "port", QString::number(config.port));
+    QCommandLineOption nodesOpt("nodes", "虚拟节点数量", "n", QString::number(config.nodes));
+    QCommandLineOption sensorOpt("sensor-hz", "每节点传感器帧频率", "hz", QString::number(config.sensorHz));
+    QCommandLineOption motorOpt("motor-hz", "每节点电机状态帧频率", "hz", QString::number(config.motorHz));
+    QCommandLineOption heartOpt("heartbeat-hz", "每节点心跳帧频率", "hz", QString::number(config.heartBeatHz));
+    QCommandLineOption weatherOpt("weather-hz", "每节点时间天气帧频率", "hz", QString::number(config.weatherHz));
+    QCommandLineOption crcOpt("crc-error-rate", "CRC 错误注入概率", "p", "0");
+    QCommandLineOption splitOpt("split-rate", "跨消息拆分帧概率", "p", "0");
+    QCommandLineOption truncOpt("truncate-rate", "残缺帧注入概率", "p", "0");
+    QCommandLineOption tickOpt("tick-ms", "调度周期（毫秒）", "ms", QString::number(config.tickMs));
+    QCommandLineOption statsOpt("stats-interval", "统计输出间隔（秒）", "s", QString::number(config.statsIntervalSec));
+    QCommandLineOption seedOpt("seed", "随机种子", "seed", QString::number(config.seed));
+
+    parser.addOptions({portOpt, nodesOpt, sensorOpt, motorOpt, heartOpt, weatherOpt,
+                       crcOpt, splitOpt, truncOpt, tickOpt, statsOpt, seedOpt});
+    parser.process(app);
+
+    config.port = static_cast<quint16>(parser.value(portOpt).toUInt());
+    config.nodes = parser.value(nodesOpt).toInt();
+    config.sensorHz = parser.value(sensorOpt).toDouble();
+    config.motorHz = parser.value(motorOpt).toDouble();
+    config.heartBeatHz = parser.value(heartOpt).toDouble();
+    config.weatherHz = parser.value(weatherOpt).toDouble();
+    config.crcErrorRate = parser.value(crcOpt).toDouble();
+    config.splitRate = parser.value(splitOpt).toDouble();
+    config.truncateRate = parser.value(truncOpt).toDouble();
+    config.tickMs = parser.value(tickOpt).toInt();
+    config.statsIntervalSec = parser.value(statsOpt).toInt();
+    config.seed = parser.value(seedOpt).toUInt();
+
+    DeviceSimulator simulator(config);
+    if (!simulator.start()) {
+        return 1;
+    }
+
+    return app.exec();
+}